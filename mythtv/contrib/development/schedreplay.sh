@@ -0,0 +1,117 @@
+#!/bin/sh
+
+# Records the tables the scheduler reads into a fixture, loads such a
+# fixture into a scratch database, and replays the scheduler against it
+# with "mythbackend --replaysched" at the time the fixture was recorded.
+#
+#   schedreplay.sh dump <database> <fixture.sql>
+#   schedreplay.sh load <fixture.sql> <scratch database>
+#   schedreplay.sh run <fixture.sql> [mythbackend options]
+#
+# "run" uses the database of the config.xml mythbackend finds, point
+# MYTHCONFDIR at a directory whose config.xml names the scratch database.
+# It needs faketime (libfaketime), and the database server should use the
+# same time zone as the system the fixture was recorded on.
+#
+# To catch regressions, keep the schedule of a run and compare later runs
+# against it:
+#
+#   schedreplay.sh run fixture.sql --replayoutput expected.txt
+#   schedreplay.sh run fixture.sql --replayoutput actual.txt --replayruns 10
+#   diff expected.txt actual.txt
+#
+# To check that rescheduling after one rule changes keeps the placement of
+# the other showings and gives the same schedule as a full placement:
+#
+#   schedreplay.sh run fixture.sql --replaychange <recordid>
+#
+# The mysql client options, for user and password, are taken from
+# $MYSQL_OPTS or ~/.my.cnf.
+
+DATA_TABLES="capturecard channel channelgroup channelgroupnames credits
+             inputgroup oldfind oldprogram oldrecorded people powerpriority
+             program programgenres programrating recgroups record recorded
+             recordfilter roles settings storagegroup videosource"
+
+usage()
+{
+  sed -n '3,30p' "$0" | sed -e 's/^# \{0,1\}//'
+  exit 1
+}
+
+fixture_value()
+{
+  sed -n -e "s/^-- $2: //p" "$1" | head -n 1
+}
+
+dump()
+{
+  [ $# -eq 2 ] || usage
+  db=$1
+  fixture=$2
+
+  tz=${TZ:-$(cat /etc/timezone 2>/dev/null)}
+  [ -n "$tz" ] || tz=$(timedatectl show -p Timezone --value 2>/dev/null)
+
+  {
+    echo "-- SchedReplayEpoch: $(date +%s)"
+    echo "-- SchedReplayTZ: ${tz:-UTC}"
+    mysqldump $MYSQL_OPTS --no-data --skip-comments "$db"
+    mysqldump $MYSQL_OPTS --no-create-info --skip-comments \
+              --skip-triggers "$db" $DATA_TABLES
+  } > "$fixture" || exit 1
+
+  echo "Recorded $db into $fixture"
+}
+
+load()
+{
+  [ $# -eq 2 ] || usage
+  fixture=$1
+  db=$2
+
+  if [ "$db" = "mythconverg" ]; then
+    echo "Refusing to replace mythconverg, use a scratch database." >&2
+    exit 1
+  fi
+  [ -n "$(fixture_value "$fixture" SchedReplayEpoch)" ] || {
+    echo "$fixture is not a scheduler fixture." >&2
+    exit 1
+  }
+
+  mysql $MYSQL_OPTS -e "DROP DATABASE IF EXISTS \`$db\`;
+                        CREATE DATABASE \`$db\`;" || exit 1
+  mysql $MYSQL_OPTS "$db" < "$fixture" || exit 1
+
+  echo "Loaded $fixture into $db"
+}
+
+run()
+{
+  [ $# -ge 1 ] || usage
+  fixture=$1
+  shift
+
+  epoch=$(fixture_value "$fixture" SchedReplayEpoch)
+  tz=$(fixture_value "$fixture" SchedReplayTZ)
+  [ -n "$epoch" ] || {
+    echo "$fixture is not a scheduler fixture." >&2
+    exit 1
+  }
+  command -v faketime > /dev/null || {
+    echo "faketime is needed to replay at the recorded time." >&2
+    exit 1
+  }
+
+  start=$(TZ=$tz date -d "@$epoch" '+%Y-%m-%d %H:%M:%S')
+  TZ=$tz exec faketime "@$start" mythbackend --replaysched "$@"
+}
+
+command=$1
+[ $# -gt 0 ] && shift
+case "$command" in
+  dump) dump "$@" ;;
+  load) load "$@" ;;
+  run)  run "$@" ;;
+  *)    usage ;;
+esac
@@ -54,6 +54,7 @@ HEADERS += programinfo.h          programinfoupdater.h
 HEADERS += programtypes.h         recordingtypes.h
 HEADERS += programtypeflags.h
 HEADERS += rssparse.h
+HEADERS += seekindex.h
 HEADERS += guistartup.h
 
 SOURCES += audio/audiooutput.cpp audio/audiooutputbase.cpp
@@ -80,6 +81,7 @@ SOURCES += rawsettingseditor.cpp
 SOURCES += programinfo.cpp        programinfoupdater.cpp
 SOURCES += programtypes.cpp       recordingtypes.cpp
 SOURCES += rssparse.cpp
+SOURCES += seekindex.cpp
 SOURCES += guistartup.cpp
 
 # This stuff is not Qt5 compatible..
@@ -140,6 +142,7 @@ inc.files += mythterminal.h       remoteutil.h
 inc.files += programinfo.h
 inc.files += programtypes.h       recordingtypes.h
 inc.files += programtypeflags.h
+inc.files += seekindex.h
 inc.files += rssparse.h
 inc.files += standardsettings.h
 
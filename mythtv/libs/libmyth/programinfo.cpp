@@ -25,6 +25,7 @@
 #include "programinfo.h"
 #include "remotefile.h"
 #include "remoteutil.h"
+#include "seekindex.h"
 #include "mythdb.h"
 #include "compat.h"
 #include "mythcdrom.h"
@@ -928,6 +929,8 @@ void ProgramInfo::clone(const ProgramInfo &other,
         m_inUseForWhat = other.m_inUseForWhat;
         m_positionMapDBReplacement = other.m_positionMapDBReplacement;
     }
+
+    ForgetSeekIndex();
 }
 
 void ProgramInfo::clear(void)
@@ -1014,6 +1017,7 @@ void ProgramInfo::clear(void)
     // Private
     m_inUseForWhat.clear();
     m_positionMapDBReplacement = nullptr;
+    ForgetSeekIndex();
 }
 
 /*!
@@ -1338,6 +1342,52 @@ void ProgramInfo::ToStringList(QStringList &list) const
 /* do not forget to update the NUMPROGRAMLINES defines! */
 }
 
+static qint64 datetime_to_stream(const QDateTime &dt)
+{
+    return dt.isValid() ? dt.toSecsSinceEpoch() : kInvalidDateTime;
+}
+
+static QDateTime datetime_from_stream(qint64 secs)
+{
+    if (secs == kInvalidDateTime)
+        return {};
+    return MythDate::fromSecsSinceEpoch(secs);
+}
+
+/** \fn ProgramInfo::ToDataStream(QDataStream&) const
+ *  \brief Serializes ProgramInfo in binary form, with the same fields
+ *         as ToStringList() minus the old cardid.
+ *  \sa FromDataStream(QDataStream&), ProgramListPacker
+ */
+void ProgramInfo::ToDataStream(QDataStream &stream) const
+{
+    stream << m_title << m_subtitle << m_description
+           << quint32(m_season) << quint32(m_episode)
+           << quint32(m_totalEpisodes) << m_syndicatedEpisode << m_category
+           << quint32(m_chanId) << m_chanStr << m_chanSign << m_chanName
+           << m_pathname << quint64(m_fileSize)
+           << datetime_to_stream(m_startTs) << datetime_to_stream(m_endTs)
+           << quint32(m_findId) << m_hostname << quint32(m_sourceId)
+           << quint32(m_inputId) << qint32(m_recPriority)
+           << qint8(m_recStatus) << quint32(m_recordId)
+           << quint8(m_recType) << quint8(m_dupIn) << quint8(m_dupMethod)
+           << datetime_to_stream(m_recStartTs)
+           << datetime_to_stream(m_recEndTs)
+           << quint32(m_programFlags)
+           << (!m_recGroup.isEmpty() ? m_recGroup : QString("Default"))
+           << m_chanPlaybackFilters << m_seriesId << m_programId << m_inetRef
+           << datetime_to_stream(m_lastModified) << m_stars
+           << m_originalAirDate
+           << (!m_playGroup.isEmpty() ? m_playGroup : QString("Default"))
+           << qint32(m_recPriority2) << quint32(m_parentId)
+           << (!m_storageGroup.isEmpty() ? m_storageGroup : QString("Default"))
+           << quint32(m_audioProperties) << quint32(m_videoProperties)
+           << quint32(m_subtitleProperties)
+           << quint16(m_year) << quint16(m_partNumber) << quint16(m_partTotal)
+           << quint8(m_catType) << quint32(m_recordedId) << m_inputName
+           << datetime_to_stream(m_bookmarkUpdate);
+}
+
 // QStringList::const_iterator it = list.begin()+offset;
 
 #define NEXT_STR()        do { if (it == listend)                    \
@@ -1461,6 +1511,154 @@ bool ProgramInfo::FromStringList(QStringList::const_iterator &it,
     return true;
 }
 
+/** \fn ProgramInfo::FromDataStream(QDataStream&)
+ *  \brief Initializes this ProgramInfo instance from the binary form
+ *         written by ToDataStream().
+ *  \return true if it succeeds, false if it fails.
+ */
+bool ProgramInfo::FromDataStream(QDataStream &stream)
+{
+    uint      origChanid     = m_chanId;
+    QDateTime origRecstartts = m_recStartTs;
+
+    quint32 season = 0;
+    quint32 episode = 0;
+    quint32 totalEpisodes = 0;
+    quint32 chanId = 0;
+    quint64 fileSize = 0;
+    qint64  startTs = 0;
+    qint64  endTs = 0;
+    quint32 findId = 0;
+    quint32 sourceId = 0;
+    quint32 inputId = 0;
+    qint32  recPriority = 0;
+    qint8   recStatus = 0;
+    quint32 recordId = 0;
+    quint8  recType = 0;
+    quint8  dupIn = 0;
+    quint8  dupMethod = 0;
+    qint64  recStartTs = 0;
+    qint64  recEndTs = 0;
+    quint32 programFlags = 0;
+    qint64  lastModified = 0;
+    qint32  recPriority2 = 0;
+    quint32 parentId = 0;
+    quint32 audioProperties = 0;
+    quint32 videoProperties = 0;
+    quint32 subtitleProperties = 0;
+    quint16 year = 0;
+    quint16 partNumber = 0;
+    quint16 partTotal = 0;
+    quint8  catType = 0;
+    quint32 recordedId = 0;
+    qint64  bookmarkUpdate = 0;
+
+    stream >> m_title >> m_subtitle >> m_description
+           >> season >> episode >> totalEpisodes
+           >> m_syndicatedEpisode >> m_category
+           >> chanId >> m_chanStr >> m_chanSign >> m_chanName
+           >> m_pathname >> fileSize
+           >> startTs >> endTs
+           >> findId >> m_hostname >> sourceId
+           >> inputId >> recPriority
+           >> recStatus >> recordId
+           >> recType >> dupIn >> dupMethod
+           >> recStartTs >> recEndTs
+           >> programFlags
+           >> m_recGroup
+           >> m_chanPlaybackFilters >> m_seriesId >> m_programId >> m_inetRef
+           >> lastModified >> m_stars
+           >> m_originalAirDate
+           >> m_playGroup
+           >> recPriority2 >> parentId
+           >> m_storageGroup
+           >> audioProperties >> videoProperties
+           >> subtitleProperties
+           >> year >> partNumber >> partTotal
+           >> catType >> recordedId >> m_inputName
+           >> bookmarkUpdate;
+
+    if (stream.status() != QDataStream::Ok)
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "FromDataStream, not enough data.");
+        clear();
+        return false;
+    }
+
+    m_season             = season;
+    m_episode            = episode;
+    m_totalEpisodes      = totalEpisodes;
+    m_chanId             = chanId;
+    m_fileSize           = fileSize;
+    m_startTs            = datetime_from_stream(startTs);
+    m_endTs              = datetime_from_stream(endTs);
+    m_findId             = findId;
+    m_sourceId           = sourceId;
+    m_inputId            = inputId;
+    m_recPriority        = recPriority;
+    m_recStatus          = recStatus;
+    m_recordId           = recordId;
+    m_recType            = recType;
+    m_dupIn              = dupIn;
+    m_dupMethod          = dupMethod;
+    m_recStartTs         = datetime_from_stream(recStartTs);
+    m_recEndTs           = datetime_from_stream(recEndTs);
+    m_programFlags       = programFlags;
+    m_lastModified       = datetime_from_stream(lastModified);
+    m_recPriority2       = recPriority2;
+    m_parentId           = parentId;
+    m_audioProperties    = audioProperties;
+    m_videoProperties    = videoProperties;
+    m_subtitleProperties = subtitleProperties;
+    m_year               = year;
+    m_partNumber         = partNumber;
+    m_partTotal          = partTotal;
+    m_catType            = static_cast<CategoryType>(catType);
+    m_recordedId         = recordedId;
+    m_bookmarkUpdate     = datetime_from_stream(bookmarkUpdate);
+
+    if (!origChanid || !origRecstartts.isValid() ||
+        (origChanid != m_chanId) || (origRecstartts != m_recStartTs))
+    {
+        m_availableStatus = asAvailable;
+        m_spread = -1;
+        m_startCol = -1;
+        m_inUseForWhat = QString();
+        m_positionMapDBReplacement = nullptr;
+    }
+
+    ensureSortFields();
+
+    return true;
+}
+
+const QString ProgramListPacker::kTag { "PACKED" };
+
+/// QDataStream format of the packed form, the same on both ends no
+/// matter what Qt they were built with
+static constexpr int kPackedStreamVersion { QDataStream::Qt_5_0 };
+
+ProgramListPacker::ProgramListPacker(void)
+{
+    m_buffer.open(QIODevice::WriteOnly);
+    m_stream.setVersion(kPackedStreamVersion);
+}
+
+ProgramListPacker::ProgramListPacker(QStringList::const_iterator &it,
+                                     const QStringList::const_iterator &end)
+{
+    if (IsPacked(it, end) && ++it != end)
+        m_data = qUncompress(QByteArray::fromBase64((it++)->toLatin1()));
+    m_buffer.open(QIODevice::ReadOnly);
+    m_stream.setVersion(kPackedStreamVersion);
+}
+
+void ProgramListPacker::AppendTo(QStringList &list) const
+{
+    list << kTag
+         << QString::fromLatin1(qCompress(m_data).toBase64());
+}
+
 template <typename T>
 QString propsValueToString (const QString& name, QMap<T,QString> propNames,
                             T props)
@@ -3763,6 +3961,141 @@ void ProgramInfo::SaveMarkupFlag(MarkTypes type) const
     SaveMarkupMap(flagMap, type);
 }
 
+/// Returns where the seek index of a recording is, or would be, kept
+QString ProgramInfo::GetSeekIndexPath(void) const
+{
+    if (!IsRecording() || m_pathname.isEmpty())
+        return QString();
+
+    QString path = m_pathname;
+    if (!path.startsWith('/') && !path.contains("://"))
+    {
+        // Only the basename, as loaded from the database
+        StorageGroup sgroup(m_storageGroup);
+        QString local = sgroup.FindFile(path);
+        if (local.isEmpty())
+        {
+            path = MythCoreContext::GenMythURL(
+                m_hostname, gCoreContext->GetBackendServerPort(m_hostname),
+                path, m_storageGroup);
+        }
+        else
+        {
+            path = local;
+        }
+    }
+
+    return SeekIndex::PathFor(path);
+}
+
+/** \brief Returns the local seek index to save the position map of the
+ *         given type to, or an empty string if it goes to the database.
+ *
+ *  Recordings that have a seek index keep using it.  Others get one
+ *  only when seek indexes are enabled, and as long as that doesn't hide
+ *  any part of the map that is already in the database.
+ */
+QString ProgramInfo::GetSeekIndexToWrite(MarkTypes type, bool replace) const
+{
+    QString path = GetSeekIndexPath();
+    if (!path.startsWith('/'))
+        return QString();
+    if (QFile::exists(path))
+        return path;
+    if (!SeekIndex::IsEnabled())
+        return QString();
+    if (replace)
+        return path;
+
+    MSqlQuery query(MSqlQuery::InitCon());
+    query.prepare("SELECT mark FROM recordedseek"
+                  " WHERE chanid = :CHANID"
+                  " AND starttime = :STARTTIME"
+                  " AND type = :TYPE"
+                  " LIMIT 1 ;");
+    query.bindValue(":CHANID", m_chanId);
+    query.bindValue(":STARTTIME", m_recStartTs);
+    query.bindValue(":TYPE", type);
+    if (!query.exec())
+    {
+        MythDB::DBError("GetSeekIndexToWrite", query);
+        return QString();
+    }
+
+    return query.next() ? QString() : path;
+}
+
+/// How long the seek index of a recording in progress on another host
+/// is used before asking for what was appended to it
+static constexpr std::chrono::seconds kSeekIndexRecheck { 5s };
+
+/** \brief Reads the position map of the given type from the seek index,
+ *         if the recording has one with that map.
+ *
+ *  The index is read once.  While the recording may still add to it,
+ *  only the blocks appended since are read, once a local file has grown
+ *  or every kSeekIndexRecheck for a file on another host.
+ *  \param load If false only answer from an index that was already read
+ */
+bool ProgramInfo::QuerySeekIndex(frm_pos_map_t &posMap, MarkTypes type,
+                                 bool load) const
+{
+    if (!IsRecording())
+        return false;
+
+    QMutexLocker locker(&m_seekIndexLock);
+
+    bool local = m_seekIndexPath.startsWith('/');
+    bool current = m_seekIndexLoaded.isValid() &&
+        (m_seekIndexLoaded > m_recEndTs ||
+         (local ? QFileInfo(m_seekIndexPath).size() == m_seekIndexSize
+                : MythDate::secsInPast(m_seekIndexLoaded) < kSeekIndexRecheck));
+    if (!current)
+    {
+        if (!load)
+            return false;
+
+        m_seekIndexLoaded = MythDate::current();
+        if (m_seekIndexPath.isEmpty())
+            m_seekIndexPath = GetSeekIndexPath();
+        local = m_seekIndexPath.startsWith('/');
+        m_seekIndexSize = local ? QFileInfo(m_seekIndexPath).size() : -1;
+
+        // Read from the start again if the index was replaced by a
+        // shorter one, and look for it again if it is gone
+        if (!m_seekIndexPath.isEmpty() &&
+            !SeekIndex::Load(m_seekIndexPath, m_seekIndexMaps, m_seekIndexRead) &&
+            m_seekIndexRead > 0)
+        {
+            m_seekIndexRead = 0;
+            SeekIndex::Load(m_seekIndexPath, m_seekIndexMaps, m_seekIndexRead);
+        }
+        if (m_seekIndexRead == 0)
+        {
+            m_seekIndexMaps.clear();
+            m_seekIndexPath.clear();
+        }
+    }
+
+    auto it = m_seekIndexMaps.constFind(type);
+    if (it == m_seekIndexMaps.constEnd())
+        return false;
+
+    posMap = *it;
+    return true;
+}
+
+/// Makes the next QuerySeekIndex() read the seek index again
+void ProgramInfo::ForgetSeekIndex(void) const
+{
+    QMutexLocker locker(&m_seekIndexLock);
+    m_seekIndexMaps.clear();
+    m_seekIndexLoaded = QDateTime();
+    m_seekIndexPath.clear();
+    m_seekIndexSize = -1;
+    m_seekIndexRead = 0;
+}
+
 void ProgramInfo::QueryPositionMap(
     frm_pos_map_t &posMap, MarkTypes type) const
 {
@@ -3775,6 +4108,9 @@ void ProgramInfo::QueryPositionMap(
     }
 
     posMap.clear();
+    if (QuerySeekIndex(posMap, type, false))
+        return;
+
     MSqlQuery query(MSqlQuery::InitCon());
 
     if (IsVideo())
@@ -3807,6 +4143,11 @@ void ProgramInfo::QueryPositionMap(
 
     while (query.next())
         posMap[query.value(0).toULongLong()] = query.value(1).toULongLong();
+
+    // A recording with rows in the database has no seek index for them,
+    // see GetSeekIndexToWrite()
+    if (posMap.isEmpty())
+        QuerySeekIndex(posMap, type);
 }
 
 void ProgramInfo::ClearPositionMap(MarkTypes type) const
@@ -3845,6 +4186,14 @@ void ProgramInfo::ClearPositionMap(MarkTypes type) const
 
     if (!query.exec())
         MythDB::DBError("clear position map", query);
+
+    if (IsRecording())
+    {
+        QString path = GetSeekIndexPath();
+        if (path.startsWith('/') && QFile::exists(path))
+            SeekIndex::Clear(path, type);
+        ForgetSeekIndex();
+    }
 }
 
 void ProgramInfo::SavePositionMap(
@@ -3893,6 +4242,50 @@ void ProgramInfo::SavePositionMap(
         return;
     }
 
+    QString seekIndex = IsRecording() ?
+        GetSeekIndexToWrite(type, min_frame < 0 && max_frame < 0) : QString();
+    if (!seekIndex.isEmpty())
+    {
+        SeekIndex::Maps maps;
+        SeekIndex::Load(seekIndex, maps);
+
+        frm_pos_map_t &map = maps[type];
+        for (auto it = map.begin(); it != map.end(); )
+        {
+            if (((min_frame < 0) || (it.key() >= min_frame)) &&
+                ((max_frame < 0) || (it.key() <= max_frame)))
+                it = map.erase(it);
+            else
+                ++it;
+        }
+        for (auto it = posMap.cbegin(); it != posMap.cend(); ++it)
+        {
+            if (((min_frame < 0) || (it.key() >= min_frame)) &&
+                ((max_frame < 0) || (it.key() <= max_frame)))
+                map.insert(it.key(), *it);
+        }
+
+        ForgetSeekIndex();
+        if (!SeekIndex::Write(seekIndex, maps))
+            seekIndex.clear();
+        else if ((min_frame < 0) && (max_frame < 0))
+        {
+            // Rows left in the database are hidden by the seek index
+            MSqlQuery query(MSqlQuery::InitCon());
+            query.prepare("DELETE FROM recordedseek"
+                          " WHERE chanid = :CHANID"
+                          " AND starttime = :STARTTIME"
+                          " AND type = :TYPE ;");
+            query.bindValue(":CHANID", m_chanId);
+            query.bindValue(":STARTTIME", m_recStartTs);
+            query.bindValue(":TYPE", type);
+            if (!query.exec())
+                MythDB::DBError("position map clear", query);
+        }
+        if (!seekIndex.isEmpty())
+            return;
+    }
+
     MSqlQuery query(MSqlQuery::InitCon());
     QString comp;
 
@@ -4007,6 +4400,16 @@ void ProgramInfo::SavePositionMapDelta(
         return;
     }
 
+    if (IsRecording())
+    {
+        QString seekIndex = GetSeekIndexToWrite(type, false);
+        if (!seekIndex.isEmpty() && SeekIndex::Append(seekIndex, type, posMap))
+        {
+            ForgetSeekIndex();
+            return;
+        }
+    }
+
     // Use the multi-value insert syntax to reduce database I/O
     QStringList q("INSERT INTO ");
     QString qfields;
@@ -4111,6 +4514,56 @@ static const char *from_recordedseek_mark_desc =
     " AND `offset` <= :QUERY_ARG"
     " ORDER BY chanid DESC, starttime DESC, type DESC, mark DESC LIMIT 1;";
 
+/** \brief Looks up a keyframe in a position map read from a seek index,
+ *         the way QueryKeyFrameInfo() does in the database.
+ *  \param by_value look up the mark of the entry nearest to arg in value,
+ *                  instead of the value of the entry nearest to arg in mark
+ */
+static bool seek_index_lookup(const frm_pos_map_t &posMap, uint64_t arg,
+                              bool backwards, bool by_value, uint64_t *result)
+{
+    if (posMap.isEmpty())
+        return false;
+
+    auto larg = static_cast<long long>(arg);
+    if (!by_value)
+    {
+        // Nearest in the requested direction, else nearest in the other
+        auto it = posMap.cend();
+        if (backwards)
+        {
+            it = posMap.upperBound(larg);
+            if (it != posMap.cbegin())
+                --it;
+        }
+        else
+        {
+            it = posMap.lowerBound(larg);
+            if (it == posMap.cend())
+                --it;
+        }
+        *result = *it;
+        return true;
+    }
+
+    // The values, offsets or durations, rise with the mark too
+    auto it = posMap.cend();
+    if (backwards)
+    {
+        it = std::upper_bound(posMap.cbegin(), posMap.cend(), larg);
+        if (it != posMap.cbegin())
+            --it;
+    }
+    else
+    {
+        it = std::lower_bound(posMap.cbegin(), posMap.cend(), larg);
+        if (it == posMap.cend())
+            --it;
+    }
+    *result = it.key();
+    return true;
+}
+
 bool ProgramInfo::QueryKeyFrameInfo(uint64_t * result,
                                     uint64_t position_or_keyframe,
                                     bool backwards,
@@ -4193,38 +4646,74 @@ bool ProgramInfo::QueryKeyFrameInfo(uint64_t * result,
 bool ProgramInfo::QueryPositionKeyFrame(uint64_t *keyframe, uint64_t position,
                                         bool backwards) const
 {
-   return QueryKeyFrameInfo(keyframe, position, backwards, MARK_GOP_BYFRAME,
-                            from_filemarkup_mark_asc,
-                            from_filemarkup_mark_desc,
-                            from_recordedseek_mark_asc,
-                            from_recordedseek_mark_desc);
+   frm_pos_map_t posMap;
+   if (QuerySeekIndex(posMap, MARK_GOP_BYFRAME, false))
+       return seek_index_lookup(posMap, position, backwards, true, keyframe);
+
+   if (QueryKeyFrameInfo(keyframe, position, backwards, MARK_GOP_BYFRAME,
+                         from_filemarkup_mark_asc,
+                         from_filemarkup_mark_desc,
+                         from_recordedseek_mark_asc,
+                         from_recordedseek_mark_desc))
+       return true;
+
+   // Only recordings without rows in the database can have a seek index
+   return QuerySeekIndex(posMap, MARK_GOP_BYFRAME) &&
+       seek_index_lookup(posMap, position, backwards, true, keyframe);
 }
 bool ProgramInfo::QueryKeyFramePosition(uint64_t *position, uint64_t keyframe,
                                         bool backwards) const
 {
-   return QueryKeyFrameInfo(position, keyframe, backwards, MARK_GOP_BYFRAME,
-                            from_filemarkup_offset_asc,
-                            from_filemarkup_offset_desc,
-                            from_recordedseek_offset_asc,
-                            from_recordedseek_offset_desc);
+   frm_pos_map_t posMap;
+   if (QuerySeekIndex(posMap, MARK_GOP_BYFRAME, false))
+       return seek_index_lookup(posMap, keyframe, backwards, false, position);
+
+   if (QueryKeyFrameInfo(position, keyframe, backwards, MARK_GOP_BYFRAME,
+                         from_filemarkup_offset_asc,
+                         from_filemarkup_offset_desc,
+                         from_recordedseek_offset_asc,
+                         from_recordedseek_offset_desc))
+       return true;
+
+   // Only recordings without rows in the database can have a seek index
+   return QuerySeekIndex(posMap, MARK_GOP_BYFRAME) &&
+       seek_index_lookup(posMap, keyframe, backwards, false, position);
 }
 bool ProgramInfo::QueryDurationKeyFrame(uint64_t *keyframe, uint64_t duration,
                                         bool backwards) const
 {
-   return QueryKeyFrameInfo(keyframe, duration, backwards, MARK_DURATION_MS,
-                            from_filemarkup_mark_asc,
-                            from_filemarkup_mark_desc,
-                            from_recordedseek_mark_asc,
-                            from_recordedseek_mark_desc);
+   frm_pos_map_t posMap;
+   if (QuerySeekIndex(posMap, MARK_DURATION_MS, false))
+       return seek_index_lookup(posMap, duration, backwards, true, keyframe);
+
+   if (QueryKeyFrameInfo(keyframe, duration, backwards, MARK_DURATION_MS,
+                         from_filemarkup_mark_asc,
+                         from_filemarkup_mark_desc,
+                         from_recordedseek_mark_asc,
+                         from_recordedseek_mark_desc))
+       return true;
+
+   // Only recordings without rows in the database can have a seek index
+   return QuerySeekIndex(posMap, MARK_DURATION_MS) &&
+       seek_index_lookup(posMap, duration, backwards, true, keyframe);
 }
 bool ProgramInfo::QueryKeyFrameDuration(uint64_t *duration, uint64_t keyframe,
                                         bool backwards) const
 {
-   return QueryKeyFrameInfo(duration, keyframe, backwards, MARK_DURATION_MS,
-                            from_filemarkup_offset_asc,
-                            from_filemarkup_offset_desc,
-                            from_recordedseek_offset_asc,
-                            from_recordedseek_offset_desc);
+   frm_pos_map_t posMap;
+   if (QuerySeekIndex(posMap, MARK_DURATION_MS, false))
+       return seek_index_lookup(posMap, keyframe, backwards, false, duration);
+
+   if (QueryKeyFrameInfo(duration, keyframe, backwards, MARK_DURATION_MS,
+                         from_filemarkup_offset_asc,
+                         from_filemarkup_offset_desc,
+                         from_recordedseek_offset_asc,
+                         from_recordedseek_offset_desc))
+       return true;
+
+   // Only recordings without rows in the database can have a seek index
+   return QuerySeekIndex(posMap, MARK_DURATION_MS) &&
+       seek_index_lookup(posMap, keyframe, backwards, false, duration);
 }
 
 /// \brief Store aspect ratio of a frame in the recordedmark table
@@ -5475,6 +5964,27 @@ QMap<QString,uint32_t> ProgramInfo::QueryInUseMap(void)
     return inUseMap;
 }
 
+/** \brief Sets the in-use flags from a QueryInUseMap() result and
+ *         resets a commercial flagging status that no running job in
+ *         a QueryJobsRunning(JOB_COMMFLAG) result backs, the same way
+ *         LoadFromRecorded() does.
+ */
+void ProgramInfo::UpdateInUseAndJobFlags(
+    const QMap<QString,uint32_t> &inUseMap,
+    const QMap<QString,bool> &isJobRunning)
+{
+    QString key = MakeUniqueKey();
+
+    m_programFlags &= ~(FL_INUSEPLAYING | FL_INUSERECORDING | FL_INUSEOTHER);
+    m_programFlags |= inUseMap.value(key, 0);
+
+    if (((m_programFlags & FL_COMMPROCESSING) != 0U) &&
+        !isJobRunning.contains(key))
+    {
+        SaveCommFlagged(COMM_FLAG_NOT_FLAGGED);
+    }
+}
+
 QMap<QString,bool> ProgramInfo::QueryJobsRunning(int type)
 {
     QMap<QString,bool> is_job_running;
@@ -5527,6 +6037,7 @@ QStringList ProgramInfo::LoadFromScheduler(
         (tmptable.isEmpty()) ?
         QString("QUERY_GETALLPENDING") :
         QString("QUERY_GETALLPENDING %1 %2").arg(tmptable).arg(recordid));
+    slist.push_back(ProgramListPacker::kTag);
 
     if (!gCoreContext->SendReceiveStringList(slist) || slist.size() < 2)
     {
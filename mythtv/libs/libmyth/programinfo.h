@@ -10,6 +10,9 @@
 
 #include <QStringList>
 #include <QDateTime>
+#include <QMutex>
+#include <QBuffer>
+#include <QDataStream>
 
 // MythTV headers
 #include "autodeletedeque.h"
@@ -295,6 +298,11 @@ class MPUBLIC ProgramInfo
         if (!FromStringList(it, list.end()))
             ProgramInfo::clear();
     }
+    explicit ProgramInfo(QDataStream &stream)
+    {
+        if (!FromDataStream(stream))
+            ProgramInfo::clear();
+    }
 
     bool operator==(const ProgramInfo& rhs);
     ProgramInfo &operator=(const ProgramInfo &other);
@@ -309,6 +317,7 @@ class MPUBLIC ProgramInfo
 
     // Serializers
     void ToStringList(QStringList &list) const;
+    void ToDataStream(QDataStream &stream) const;
     virtual void ToMap(InfoMap &progMap,
                        bool showrerecord = false,
                        uint star_range = 10,
@@ -730,6 +739,8 @@ class MPUBLIC ProgramInfo
     static uint64_t QueryBookmark(uint chanid, const QDateTime &recstartts);
     static QMap<QString,uint32_t> QueryInUseMap(void);
     static QMap<QString,bool> QueryJobsRunning(int type);
+    void UpdateInUseAndJobFlags(const QMap<QString,uint32_t> &inUseMap,
+                                const QMap<QString,bool> &isJobRunning);
     static QStringList LoadFromScheduler(const QString &tmptable, int recordid);
 
     // Flagging map support methods
@@ -751,6 +762,7 @@ class MPUBLIC ProgramInfo
 
     bool FromStringList(QStringList::const_iterator &it,
                         const QStringList::const_iterator&  end);
+    bool FromDataStream(QDataStream &stream);
 
     static void QueryMarkupMap(
         const QString &video_pathname,
@@ -761,6 +773,12 @@ class MPUBLIC ProgramInfo
 
     static int InitStatics(void);
 
+    QString GetSeekIndexPath(void) const;
+    QString GetSeekIndexToWrite(MarkTypes type, bool replace) const;
+    bool QuerySeekIndex(frm_pos_map_t &posMap, MarkTypes type,
+                        bool load = true) const;
+    void ForgetSeekIndex(void) const;
+
   protected:
     QString         m_title;
     QString         m_sortTitle;
@@ -850,6 +868,14 @@ class MPUBLIC ProgramInfo
     QString            m_inUseForWhat;
     PMapDBReplacement *m_positionMapDBReplacement {nullptr};
 
+    // The seek index as last read by QuerySeekIndex()
+    mutable QMutex                         m_seekIndexLock;
+    mutable QString                        m_seekIndexPath;
+    mutable QMap<MarkTypes, frm_pos_map_t> m_seekIndexMaps;
+    mutable QDateTime                      m_seekIndexLoaded;
+    mutable qint64                         m_seekIndexSize {-1}; // local only
+    mutable qint64                         m_seekIndexRead {0}; // bytes parsed
+
     static QMutex              s_staticDataLock;
     static ProgramInfoUpdater *s_updater;
     static bool s_usingProgIDAuth;
@@ -905,6 +931,47 @@ MPUBLIC bool LoadFromRecorded(
     bool                ignoreLiveTV = false,
     bool                ignoreDeleted = false);
 
+/** \brief Packs the programs of a Myth protocol reply.
+ *
+ *  A client that understands the packed form adds kTag as the last item
+ *  of its QUERY_RECORDINGS or QUERY_GETALLPENDING request.  The backend
+ *  then replies with kTag and a single item holding all of the programs,
+ *  written by ProgramInfo::ToDataStream() and compressed with zlib, in
+ *  place of NUMPROGRAMLINES items for each program.  Older backends
+ *  ignore the extra item and reply with string lists, so clients check
+ *  the reply with IsPacked().
+ */
+class MPUBLIC ProgramListPacker
+{
+  public:
+    static const QString kTag;
+
+    /// Packs programs
+    ProgramListPacker(void);
+    /// Unpacks the programs following kTag at it, and moves it past them
+    ProgramListPacker(QStringList::const_iterator &it,
+                      const QStringList::const_iterator &end);
+
+    static bool IsPacked(const QStringList::const_iterator &it,
+                         const QStringList::const_iterator &end)
+        { return it != end && *it == kTag; }
+
+    void Add(const ProgramInfo &pginfo) { pginfo.ToDataStream(m_stream); }
+    /// Appends kTag and the programs packed so far to list
+    void AppendTo(QStringList &list) const;
+
+    /// True once all programs are read, or the packed data is bad
+    bool AtEnd(void) const
+        { return m_stream.atEnd() || m_stream.status() != QDataStream::Ok; }
+    template<typename TYPE>
+    TYPE *Next(void) { return new TYPE(m_stream); }
+
+  private:
+    QByteArray  m_data;
+    QBuffer     m_buffer {&m_data};
+    QDataStream m_stream {&m_buffer};
+};
+
 template<typename TYPE>
 bool LoadFromScheduler(
     AutoDeleteDeque<TYPE*> &destination,
@@ -921,10 +988,8 @@ bool LoadFromScheduler(
 
     hasConflicts = slist[0].toInt();
 
-    QStringList::const_iterator sit = slist.cbegin()+2;
-    while (sit != slist.cend())
+    auto add = [&destination](TYPE *p)
     {
-        TYPE *p = new TYPE(sit, slist.cend());
         destination.push_back(p);
 
         if (!p->HasPathname() && !p->GetChanID())
@@ -933,6 +998,23 @@ bool LoadFromScheduler(
             destination.clear();
             return false;
         }
+        return true;
+    };
+
+    QStringList::const_iterator sit = slist.cbegin()+2;
+    if (ProgramListPacker::IsPacked(sit, slist.cend()))
+    {
+        ProgramListPacker packed(sit, slist.cend());
+        while (!packed.AtEnd())
+        {
+            if (!add(packed.Next<TYPE>()))
+                return false;
+        }
+    }
+    while (sit != slist.cend())
+    {
+        if (!add(new TYPE(sit, slist.cend())))
+            return false;
     }
 
     if (destination.size() != slist[1].toUInt())
@@ -24,6 +24,7 @@ std::vector<ProgramInfo *> *RemoteGetRecordedList(int sort)
         str += "Unsorted";
 
     QStringList strlist(str);
+    strlist << ProgramListPacker::kTag;
 
     auto *info = new std::vector<ProgramInfo *>;
 
@@ -36,6 +37,73 @@ std::vector<ProgramInfo *> *RemoteGetRecordedList(int sort)
     return info;
 }
 
+/**
+ * \brief Fetches the recordings changed since sequence of the backend's
+ *        change journal generation.
+ *
+ * With generation 0 it only fetches the current generation and sequence.
+ * generation and sequence are updated to those of the reply, changed and
+ * deleted, which must be empty, get the changes.
+ * \return false if the whole recorded list has to be reloaded.
+ */
+bool RemoteGetRecordingChanges(quint64 &generation, quint64 &sequence,
+                               std::vector<ProgramInfo *> &changed,
+                               std::vector<uint> &deleted)
+{
+    QString str = "QUERY_RECORDING_CHANGES";
+    if (generation)
+        str += QString(" %1 %2").arg(generation).arg(sequence);
+    QStringList strlist(str);
+
+    if (!gCoreContext->SendReceiveStringList(strlist) || strlist.size() < 3)
+    {
+        // Older backends don't keep a change journal
+        generation = sequence = 0;
+        return false;
+    }
+
+    generation = strlist[0].toULongLong();
+    sequence   = strlist[1].toULongLong();
+    if (strlist[2] != "OK" || strlist.size() < 4)
+        return false;
+
+    int count = strlist[3].toInt();
+    QStringList::const_iterator it = strlist.cbegin() + 4;
+    for (int i = 0; i < count; i++)
+    {
+        if (it == strlist.cend())
+            break;
+        QString change = *it++;
+        if (change == "DELETE" && it != strlist.cend())
+        {
+            deleted.push_back((it++)->toUInt());
+        }
+        else if (change == "UPDATE" &&
+                 strlist.cend() - it >= NUMPROGRAMLINES)
+        {
+            changed.push_back(new ProgramInfo(it, strlist.cend()));
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    if (changed.size() + deleted.size() != static_cast<size_t>(count))
+    {
+        LOG(VB_GENERAL, LOG_ERR,
+            "RemoteGetRecordingChanges() list appears to be incorrect.");
+        for (auto *pginfo : changed)
+            delete pginfo;
+        changed.clear();
+        deleted.clear();
+        generation = sequence = 0;
+        return false;
+    }
+
+    return true;
+}
+
 bool RemoteGetLoad(system_load_array& load)
 {
     QStringList strlist(QString("QUERY_LOAD"));
@@ -181,6 +249,22 @@ uint RemoteGetRecordingList(
     if (numrecordings <= 0)
         return 0;
 
+    uint reclist_initial_size = (uint) reclist.size();
+    QStringList::const_iterator it = strList.cbegin() + 1;
+    if (ProgramListPacker::IsPacked(it, strList.cend()))
+    {
+        ProgramListPacker packed(it, strList.cend());
+        for (int i = 0; i < numrecordings && !packed.AtEnd(); i++)
+            reclist.push_back(packed.Next<ProgramInfo>());
+        if ((int) reclist.size() - (int) reclist_initial_size != numrecordings)
+        {
+            LOG(VB_GENERAL, LOG_ERR,
+                "RemoteGetRecordingList() packed list appears to be "
+                "incorrect.");
+        }
+        return ((uint) reclist.size()) - reclist_initial_size;
+    }
+
     if (numrecordings * NUMPROGRAMLINES + 1 > strList.size())
     {
         LOG(VB_GENERAL, LOG_ERR,
@@ -188,8 +272,6 @@ uint RemoteGetRecordingList(
         return 0;
     }
 
-    uint reclist_initial_size = (uint) reclist.size();
-    QStringList::const_iterator it = strList.cbegin() + 1;
     for (int i = 0; i < numrecordings; i++)
     {
         auto *pginfo = new ProgramInfo(it, strList.cend());
@@ -530,6 +612,7 @@ std::vector<ProgramInfo *> *RemoteGetCurrentlyRecordingList(void)
     QString str = "QUERY_RECORDINGS ";
     str += "Recording";
     QStringList strlist( str );
+    strlist << ProgramListPacker::kTag;
 
     auto *reclist = new std::vector<ProgramInfo *>;
     auto *info = new std::vector<ProgramInfo *>;
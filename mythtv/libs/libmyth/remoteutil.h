@@ -17,6 +17,9 @@ class MythEvent;
 using system_load_array = std::array<double,3>;
 
 MPUBLIC std::vector<ProgramInfo *> *RemoteGetRecordedList(int sort);
+MPUBLIC bool RemoteGetRecordingChanges(
+    quint64 &generation, quint64 &sequence,
+    std::vector<ProgramInfo *> &changed, std::vector<uint> &deleted);
 MPUBLIC bool RemoteGetLoad(system_load_array &load);
 MPUBLIC bool RemoteGetUptime(std::chrono::seconds &uptime);
 MPUBLIC
@@ -0,0 +1,316 @@
+// C++ headers
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+// Qt headers
+#include <QFile>
+#include <QSaveFile>
+
+// MythTV headers
+#include "mythcorecontext.h"
+#include "mythlogging.h"
+#include "remotefile.h"
+#include "seekindex.h"
+
+#define LOC QString("SeekIndex: ")
+
+static constexpr std::array<char,8> kMagic { 'M','Y','T','H','S','E','E','K' };
+static constexpr char kVersion { 1 };
+static constexpr qint64 kHeaderSize { static_cast<qint64>(kMagic.size()) + 1 };
+
+enum BlockKind : std::uint8_t
+{
+    kEntriesBlock = 1,
+    kClearBlock   = 2,
+};
+
+static void put_varint(QByteArray &out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.append(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.append(static_cast<char>(value));
+}
+
+static void put_svarint(QByteArray &out, int64_t value)
+{
+    put_varint(out, (static_cast<uint64_t>(value) << 1) ^
+                    static_cast<uint64_t>(value >> 63));
+}
+
+static bool get_varint(const uint8_t *&pos, const uint8_t *end,
+                       uint64_t &value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < end; shift += 7)
+    {
+        uint8_t byte = *pos++;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+static bool get_svarint(const uint8_t *&pos, const uint8_t *end,
+                        int64_t &value)
+{
+    uint64_t zigzag = 0;
+    if (!get_varint(pos, end, zigzag))
+        return false;
+    value = static_cast<int64_t>(zigzag >> 1) ^
+            -static_cast<int64_t>(zigzag & 1);
+    return true;
+}
+
+static bool has_header(const char *data, qint64 size)
+{
+    return size >= kHeaderSize &&
+        memcmp(data, kMagic.data(), kMagic.size()) == 0 &&
+        data[kMagic.size()] == kVersion;
+}
+
+bool SeekIndex::IsEnabled(void)
+{
+    return gCoreContext->GetBoolSetting("SeekIndexFiles", false);
+}
+
+bool SeekIndex::Load(const QString &path, Maps &maps)
+{
+    qint64 offset = 0;
+    return Load(path, maps, offset);
+}
+
+/** \brief Reads the index at path from offset on.
+ *
+ *  With offset 0 the maps are replaced by the whole index.  Otherwise
+ *  the blocks appended since an earlier Load() stopped at offset are
+ *  added to the maps it returned, so that the index of a recording in
+ *  progress is not read again from the start.
+ *  \return false if the index is missing, corrupt, or shorter than offset
+ */
+bool SeekIndex::Load(const QString &path, Maps &maps, qint64 &offset)
+{
+    if (offset == 0)
+        maps.clear();
+    qint64 start = offset ? offset : kHeaderSize;
+
+    auto parse = [&maps, &offset](const char *data, qint64 size)
+    {
+        if (offset == 0)
+        {
+            if (!has_header(data, size))
+                return false;
+            data += kHeaderSize;
+            size -= kHeaderSize;
+            offset = kHeaderSize;
+        }
+        offset += ParseBlocks(data, size, maps);
+        return true;
+    };
+
+    if (path.startsWith("myth://"))
+    {
+        if (offset == 0 && !RemoteFile::Exists(path))
+            return false;
+
+        RemoteFile file(path, false, false, 0s);
+        long long size = file.GetRealFileSize();
+        if (!file.isOpen() || size < start)
+            return false;
+        if (offset && file.Seek(offset, SEEK_SET) != offset)
+            return false;
+
+        QByteArray data(static_cast<int>(size - offset), '\0');
+        int read = data.isEmpty() ? 0 : file.Read(data.data(), data.size());
+        return (read >= 0) && parse(data.constData(), read);
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    qint64 size = file.size();
+    if (size < start)
+        return false;
+    if (size == offset)
+        return true;
+
+    uchar *data = file.map(offset, size - offset);
+    if (!data)
+    {
+        file.seek(offset);
+        QByteArray bytes = file.readAll();
+        return parse(bytes.constData(), bytes.size());
+    }
+
+    bool ok = parse(reinterpret_cast<const char *>(data), size - offset);
+    file.unmap(data);
+    return ok;
+}
+
+bool SeekIndex::Parse(const char *data, qint64 size, Maps &maps)
+{
+    maps.clear();
+    if (!has_header(data, size))
+        return false;
+
+    ParseBlocks(data + kHeaderSize, size - kHeaderSize, maps);
+    return true;
+}
+
+/// Adds the blocks in data to maps, returns the size of the whole blocks
+qint64 SeekIndex::ParseBlocks(const char *data, qint64 size, Maps &maps)
+{
+    const auto *begin = reinterpret_cast<const uint8_t *>(data);
+    const auto *pos = begin;
+    const auto *end = begin + size;
+    while (end - pos > 2)
+    {
+        auto kind = static_cast<BlockKind>(pos[0]);
+        auto type = static_cast<MarkTypes>(pos[1]);
+        const uint8_t *block = pos + 2;
+        uint64_t length = 0;
+        if (!get_varint(block, end, length) ||
+            length > static_cast<uint64_t>(end - block))
+        {
+            break;
+        }
+        const uint8_t *blockEnd = block + length;
+        pos = blockEnd;
+
+        if (kind == kClearBlock)
+        {
+            maps.remove(type);
+            continue;
+        }
+        if (kind != kEntriesBlock)
+            continue;
+
+        uint64_t count = 0;
+        if (!get_varint(block, blockEnd, count))
+            break;
+
+        frm_pos_map_t &map = maps[type];
+        int64_t frame = 0;
+        int64_t offset = 0;
+        for (uint64_t i = 0; i < count; i++)
+        {
+            int64_t frameDelta = 0;
+            int64_t offsetDelta = 0;
+            if (!get_svarint(block, blockEnd, frameDelta) ||
+                !get_svarint(block, blockEnd, offsetDelta))
+            {
+                LOG(VB_GENERAL, LOG_WARNING, LOC + "Corrupt entries block");
+                return pos - begin;
+            }
+            frame += frameDelta;
+            offset += offsetDelta;
+            map.insert(frame, offset);
+        }
+    }
+
+    return pos - begin;
+}
+
+QByteArray SeekIndex::Header(void)
+{
+    QByteArray header(kMagic.data(), kMagic.size());
+    header.append(kVersion);
+    return header;
+}
+
+/// Encodes the entries of map, or a clear block without it
+QByteArray SeekIndex::Block(MarkTypes type, const frm_pos_map_t *map)
+{
+    QByteArray payload;
+    if (map)
+    {
+        put_varint(payload, map->size());
+        long long frame = 0;
+        long long offset = 0;
+        for (auto it = map->cbegin(); it != map->cend(); ++it)
+        {
+            put_svarint(payload, it.key() - frame);
+            put_svarint(payload, *it - offset);
+            frame = it.key();
+            offset = *it;
+        }
+    }
+
+    QByteArray block;
+    block.append(static_cast<char>(map ? kEntriesBlock : kClearBlock));
+    block.append(static_cast<char>(type));
+    put_varint(block, payload.size());
+    block.append(payload);
+    return block;
+}
+
+bool SeekIndex::Append(const QString &path, MarkTypes type,
+                       const frm_pos_map_t &map)
+{
+    if (map.isEmpty())
+        return true;
+    return AppendBlock(path, type, &map);
+}
+
+bool SeekIndex::Clear(const QString &path, MarkTypes type)
+{
+    return AppendBlock(path, type, nullptr);
+}
+
+bool SeekIndex::AppendBlock(const QString &path, MarkTypes type,
+                            const frm_pos_map_t *map)
+{
+    if (type < 0 || type > 127)
+        return false;
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append |
+                   QIODevice::Unbuffered))
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + QString("Unable to open '%1': %2")
+            .arg(path, file.errorString()));
+        return false;
+    }
+
+    // Write the block at once, so readers never see half an entry
+    QByteArray data = (file.size() == 0) ? Header() : QByteArray();
+    data.append(Block(type, map));
+    if (file.write(data) != data.size())
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + QString("Unable to write '%1': %2")
+            .arg(path, file.errorString()));
+        return false;
+    }
+    return true;
+}
+
+bool SeekIndex::Write(const QString &path, const Maps &maps)
+{
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + QString("Unable to create '%1': %2")
+            .arg(path, file.errorString()));
+        return false;
+    }
+
+    QByteArray data = Header();
+    for (auto it = maps.cbegin(); it != maps.cend(); ++it)
+    {
+        if (it.key() >= 0 && it.key() <= 127 && !it->isEmpty())
+            data.append(Block(it.key(), &(*it)));
+    }
+
+    if (file.write(data) != data.size() || !file.commit())
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + QString("Unable to write '%1': %2")
+            .arg(path, file.errorString()));
+        return false;
+    }
+    return true;
+}
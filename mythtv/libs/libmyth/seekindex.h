@@ -0,0 +1,63 @@
+#ifndef SEEK_INDEX_H
+#define SEEK_INDEX_H
+
+// Qt headers
+#include <QByteArray>
+#include <QMap>
+#include <QString>
+
+// MythTV headers
+#include "mythexp.h"
+#include "programtypes.h"
+
+/** \brief The position maps of a recording, kept in a file next to it.
+ *
+ *  A recording gets one recordedseek row per keyframe, and another per
+ *  keyframe for its durations, which makes recordedseek the largest
+ *  table and playback start wait for all those rows.  When enabled with
+ *  the SeekIndexFiles setting, new recordings write their position maps
+ *  to "<recording>.seek" instead, see ProgramInfo::QueryPositionMap().
+ *
+ *  The file starts with kMagic and a version byte, followed by blocks.
+ *  Each block is its kind, the mark type and the size of the rest of
+ *  the block as a varint.  An entries block holds the number of entries
+ *  and for each the difference to the previous entry's frame and to its
+ *  offset, as zigzag encoded varints.  A clear block drops the entries
+ *  of its mark type read so far.  Blocks are only ever appended while
+ *  recording, and a block cut short, by a crash or by a write still in
+ *  progress, ends the index.
+ */
+class MPUBLIC SeekIndex
+{
+  public:
+    using Maps = QMap<MarkTypes, frm_pos_map_t>;
+
+    /// True if recordings without a seek index should get one
+    static bool IsEnabled(void);
+    static QString PathFor(const QString &recording)
+        { return recording + ".seek"; }
+
+    /// Reads the index at path, a local file or a myth:// URL
+    static bool Load(const QString &path, Maps &maps);
+    /// Adds the blocks appended to the index at path after offset,
+    /// which is moved to the end of the last whole block
+    static bool Load(const QString &path, Maps &maps, qint64 &offset);
+    static bool Parse(const char *data, qint64 size, Maps &maps);
+
+    /// Adds the entries of map to the local index at path, creating it
+    static bool Append(const QString &path, MarkTypes type,
+                       const frm_pos_map_t &map);
+    /// Drops the entries of the given type from the local index at path
+    static bool Clear(const QString &path, MarkTypes type);
+    /// Replaces the local index at path with one holding maps
+    static bool Write(const QString &path, const Maps &maps);
+
+  private:
+    static qint64 ParseBlocks(const char *data, qint64 size, Maps &maps);
+    static QByteArray Header(void);
+    static QByteArray Block(MarkTypes type, const frm_pos_map_t *map);
+    static bool AppendBlock(const QString &path, MarkTypes type,
+                            const frm_pos_map_t *map);
+};
+
+#endif // SEEK_INDEX_H
@@ -20,6 +20,7 @@
 
 #include <array>
 #include <iostream>
+#include <memory>
 #include <QtTest/QtTest>
 
 #include "mythcorecontext.h"
@@ -474,6 +475,152 @@ class TestProgramInfo : public QObject
         QVERIFY(m_supergirl23 == lrigrepus23c);
     }
 
+    void programListPacker_test(void)
+    {
+        ProgramListPacker packer;
+        packer.Add(m_dracula);
+        packer.Add(m_flash34);
+        packer.Add(m_supergirl23);
+
+        QStringList reply("3");
+        packer.AppendTo(reply);
+        QCOMPARE(reply.size(), 3);
+
+        QStringList::const_iterator it = reply.cbegin() + 1;
+        QVERIFY(ProgramListPacker::IsPacked(it, reply.cend()));
+        ProgramListPacker unpacker(it, reply.cend());
+        QVERIFY(it == reply.cend());
+
+        std::vector<ProgramInfo *> programs;
+        while (!unpacker.AtEnd())
+            programs.push_back(unpacker.Next<ProgramInfo>());
+        QCOMPARE(programs.size(), size_t(3));
+        QVERIFY(m_dracula == *programs[0]);
+        QVERIFY(m_flash34 == *programs[1]);
+        QVERIFY(m_supergirl23 == *programs[2]);
+
+        // The packed form carries the same fields as the string form
+        QStringList expected;
+        QStringList actual;
+        m_flash34.ToStringList(expected);
+        programs[1]->ToStringList(actual);
+        QCOMPARE(actual, expected);
+
+        for (auto *p : programs)
+            delete p;
+
+        // A string list reply is not mistaken for a packed one
+        QStringList strings("1");
+        m_flash34.ToStringList(strings);
+        it = strings.cbegin() + 1;
+        QVERIFY(!ProgramListPacker::IsPacked(it, strings.cend()));
+
+        // Neither is truncated data mistaken for a program
+        reply[2].truncate(reply[2].size() / 2);
+        it = reply.cbegin() + 1;
+        ProgramListPacker truncated(it, reply.cend());
+        QVERIFY(truncated.AtEnd());
+    }
+
+    /**
+     * compare the string and packed forms of a list of recordings,
+     * about the size of a large recorded list
+     */
+    void programListPacker_benchmark_data(void)
+    {
+        QTest::addColumn<bool>("packed");
+        QTest::newRow("strings") << false;
+        QTest::newRow("packed")  << true;
+    }
+
+    void programListPacker_benchmark(void)
+    {
+        QFETCH(bool, packed);
+        static constexpr int kPrograms = 1000;
+
+        // 50 series of 20 episodes, on 40 channels, half an hour apart
+        std::vector<ProgramInfo> programs;
+        programs.reserve(kPrograms);
+        for (int i = 0; i < kPrograms; i++)
+        {
+            ProgramInfo program((i % 2) ? m_flash34 : m_supergirl23);
+            QDateTime start = program.GetScheduledStartTime().addSecs(i * 1800LL);
+            uint chanid = 1001 + (i % 40);
+            program.SetTitle(QString("Series %1").arg(i % 50));
+            program.SetSubtitle(QString("Episode %1").arg(i / 50));
+            program.SetChanID(chanid);
+            program.SetScheduledStartTime(start);
+            program.SetScheduledEndTime(start.addSecs(1800));
+            program.SetRecordingStartTime(start.addSecs(-120));
+            program.SetRecordingEndTime(start.addSecs(1920));
+            program.SetPathname(QString("/recordings/%1_%2.ts")
+                                .arg(chanid)
+                                .arg(start.toString("yyyyMMddhhmmss")));
+            programs.push_back(program);
+        }
+
+        QStringList reply;
+        QBENCHMARK
+        {
+            reply = QStringList(QString::number(kPrograms));
+            ProgramListPacker packer;
+            for (const auto &program : programs)
+            {
+                if (packed)
+                    packer.Add(program);
+                else
+                    program.ToStringList(reply);
+            }
+            if (packed)
+                packer.AppendTo(reply);
+
+            QStringList::const_iterator it = reply.cbegin() + 1;
+            int count = 0;
+            if (ProgramListPacker::IsPacked(it, reply.cend()))
+            {
+                ProgramListPacker unpacker(it, reply.cend());
+                for (; !unpacker.AtEnd(); count++)
+                    delete unpacker.Next<ProgramInfo>();
+            }
+            else
+            {
+                for (; it != reply.cend(); count++)
+                    ProgramInfo program(it, reply.cend());
+            }
+            QCOMPARE(count, kPrograms);
+        }
+
+        // The last pass still decodes to the same programs
+        QStringList::const_iterator it = reply.cbegin() + 1;
+        QCOMPARE(ProgramListPacker::IsPacked(it, reply.cend()), packed);
+        std::unique_ptr<ProgramListPacker> unpacker;
+        if (packed)
+            unpacker = std::make_unique<ProgramListPacker>(it, reply.cend());
+        for (auto &program : programs)
+        {
+            std::unique_ptr<ProgramInfo> decoded(packed ?
+                unpacker->Next<ProgramInfo>() : new ProgramInfo(it, reply.cend()));
+            QVERIFY(decoded != nullptr);
+            QVERIFY(program == *decoded);
+        }
+
+        // The packed form is smaller than the string form of the same list
+        if (packed)
+        {
+            QStringList strings(QString::number(kPrograms));
+            for (const auto &program : programs)
+                program.ToStringList(strings);
+            auto characters = [](const QStringList &list)
+            {
+                int count = 0;
+                for (const auto &item : list)
+                    count += item.size();
+                return count;
+            };
+            QVERIFY(characters(reply) < characters(strings));
+        }
+    }
+
     void printList (const QStringList& list)
     {
         Q_UNUSED(list);
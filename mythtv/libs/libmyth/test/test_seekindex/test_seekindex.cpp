@@ -0,0 +1,194 @@
+/*
+ *  Class TestSeekIndex
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include "test_seekindex.h"
+
+#include "seekindex.h"
+
+static frm_pos_map_t make_map(long long first, int count)
+{
+    frm_pos_map_t map;
+    for (int i = 0; i < count; i++)
+        map.insert(first + (i * 12LL), (first + i) * 188 * 1000);
+    return map;
+}
+
+void TestSeekIndex::append_test(void)
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString path = SeekIndex::PathFor(dir.filePath("1000_20240101000000.ts"));
+
+    frm_pos_map_t gops1 = make_map(0, 100);
+    frm_pos_map_t gops2 = make_map(1200, 50);
+    frm_pos_map_t durations = make_map(0, 150);
+    QVERIFY(SeekIndex::Append(path, MARK_GOP_BYFRAME, gops1));
+    QVERIFY(SeekIndex::Append(path, MARK_DURATION_MS, durations));
+    QVERIFY(SeekIndex::Append(path, MARK_GOP_BYFRAME, gops2));
+    QVERIFY(SeekIndex::Append(path, MARK_GOP_BYFRAME, frm_pos_map_t()));
+
+    // Far smaller than a row per keyframe
+    QVERIFY(QFileInfo(path).size() < 300 * 8);
+
+    SeekIndex::Maps maps;
+    QVERIFY(SeekIndex::Load(path, maps));
+    QCOMPARE(maps.size(), 2);
+    frm_pos_map_t gops = gops1;
+    gops.insert(gops2);
+    QCOMPARE(maps.value(MARK_GOP_BYFRAME), gops);
+    QCOMPARE(maps.value(MARK_DURATION_MS), durations);
+
+    // Entries going backwards still round trip
+    frm_pos_map_t odd { {5, 1000}, {6, 10}, {1LL << 40, 0} };
+    QVERIFY(SeekIndex::Append(path, MARK_KEYFRAME, odd));
+    QVERIFY(SeekIndex::Load(path, maps));
+    QCOMPARE(maps.value(MARK_KEYFRAME), odd);
+}
+
+void TestSeekIndex::clear_test(void)
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString path = dir.filePath("test.seek");
+
+    QVERIFY(SeekIndex::Append(path, MARK_GOP_BYFRAME, make_map(0, 10)));
+    QVERIFY(SeekIndex::Append(path, MARK_DURATION_MS, make_map(0, 10)));
+    QVERIFY(SeekIndex::Clear(path, MARK_GOP_BYFRAME));
+    QVERIFY(SeekIndex::Append(path, MARK_GOP_BYFRAME, make_map(500, 3)));
+
+    SeekIndex::Maps maps;
+    QVERIFY(SeekIndex::Load(path, maps));
+    QCOMPARE(maps.value(MARK_GOP_BYFRAME), make_map(500, 3));
+    QCOMPARE(maps.value(MARK_DURATION_MS), make_map(0, 10));
+
+    QVERIFY(SeekIndex::Clear(path, MARK_DURATION_MS));
+    QVERIFY(SeekIndex::Load(path, maps));
+    QVERIFY(!maps.contains(MARK_DURATION_MS));
+}
+
+void TestSeekIndex::truncated_test(void)
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString path = dir.filePath("test.seek");
+
+    QVERIFY(SeekIndex::Append(path, MARK_GOP_BYFRAME, make_map(0, 10)));
+    qint64 size = QFileInfo(path).size();
+    QVERIFY(SeekIndex::Append(path, MARK_GOP_BYFRAME, make_map(120, 10)));
+
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QByteArray data = file.readAll();
+
+    SeekIndex::Maps maps;
+    for (qint64 cut = size; cut < data.size(); cut++)
+    {
+        QVERIFY(SeekIndex::Parse(data.constData(), cut, maps));
+        QCOMPARE(maps.value(MARK_GOP_BYFRAME), make_map(0, 10));
+    }
+    QVERIFY(SeekIndex::Parse(data.constData(), data.size(), maps));
+    QCOMPARE(maps.value(MARK_GOP_BYFRAME).size(), 20);
+}
+
+void TestSeekIndex::tail_test(void)
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString path = dir.filePath("test.seek");
+
+    QVERIFY(SeekIndex::Append(path, MARK_GOP_BYFRAME, make_map(0, 10)));
+    QVERIFY(SeekIndex::Append(path, MARK_DURATION_MS, make_map(0, 10)));
+    SeekIndex::Maps maps;
+    qint64 offset = 0;
+    QVERIFY(SeekIndex::Load(path, maps, offset));
+    QCOMPARE(offset, QFileInfo(path).size());
+
+    // Nothing new
+    QVERIFY(SeekIndex::Load(path, maps, offset));
+    QCOMPARE(maps.value(MARK_GOP_BYFRAME), make_map(0, 10));
+
+    QVERIFY(SeekIndex::Append(path, MARK_GOP_BYFRAME, make_map(120, 10)));
+    QVERIFY(SeekIndex::Clear(path, MARK_DURATION_MS));
+    qint64 whole = QFileInfo(path).size();
+    QVERIFY(SeekIndex::Append(path, MARK_GOP_BYFRAME, make_map(240, 10)));
+
+    // Cut the last block short, as if it was still being written
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QByteArray last = file.readAll().mid(static_cast<int>(whole));
+    QVERIFY(file.resize(whole + (last.size() / 2)));
+
+    QVERIFY(SeekIndex::Load(path, maps, offset));
+    QCOMPARE(offset, whole);
+    QCOMPARE(maps.value(MARK_GOP_BYFRAME).size(), 20);
+    QVERIFY(!maps.contains(MARK_DURATION_MS));
+
+    QVERIFY(file.seek(whole));
+    QCOMPARE(file.write(last), qint64(last.size()));
+    file.close();
+
+    QVERIFY(SeekIndex::Load(path, maps, offset));
+    QCOMPARE(offset, QFileInfo(path).size());
+    SeekIndex::Maps all;
+    QVERIFY(SeekIndex::Load(path, all));
+    QCOMPARE(maps, all);
+
+    // An index shorter than what was read has been replaced
+    QVERIFY(SeekIndex::Write(path, all));
+    offset = QFileInfo(path).size() + 1;
+    QVERIFY(!SeekIndex::Load(path, maps, offset));
+}
+
+void TestSeekIndex::write_test(void)
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString path = dir.filePath("test.seek");
+
+    QVERIFY(SeekIndex::Append(path, MARK_GOP_BYFRAME, make_map(0, 10)));
+    QVERIFY(SeekIndex::Append(path, MARK_DURATION_MS, make_map(0, 10)));
+
+    SeekIndex::Maps maps;
+    maps[MARK_GOP_BYFRAME] = make_map(1000, 5);
+    QVERIFY(SeekIndex::Write(path, maps));
+
+    SeekIndex::Maps loaded;
+    QVERIFY(SeekIndex::Load(path, loaded));
+    QCOMPARE(loaded, maps);
+
+    // Appending to a written index still works
+    QVERIFY(SeekIndex::Append(path, MARK_DURATION_MS, make_map(0, 2)));
+    QVERIFY(SeekIndex::Load(path, loaded));
+    QCOMPARE(loaded.value(MARK_DURATION_MS), make_map(0, 2));
+}
+
+void TestSeekIndex::badMagic_test(void)
+{
+    SeekIndex::Maps maps;
+    QByteArray data("MYTHSEEX\x01");
+    QVERIFY(!SeekIndex::Parse(data.constData(), data.size(), maps));
+    data = QByteArray("MYTHSEEK\x02");
+    QVERIFY(!SeekIndex::Parse(data.constData(), data.size(), maps));
+    data = QByteArray("MYTH");
+    QVERIFY(!SeekIndex::Parse(data.constData(), data.size(), maps));
+
+    QVERIFY(!SeekIndex::Load("/nonexistent/test.seek", maps));
+    QVERIFY(maps.isEmpty());
+}
+
+QTEST_APPLESS_MAIN(TestSeekIndex)
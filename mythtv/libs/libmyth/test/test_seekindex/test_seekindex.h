@@ -0,0 +1,39 @@
+/*
+ *  Class TestSeekIndex
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <QtTest/QtTest>
+
+class TestSeekIndex : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    /** appended maps read back the same, merged per mark type */
+    static void append_test(void);
+    /** a clear block drops the entries of its type written before it */
+    static void clear_test(void);
+    /** a block cut short ends the index without losing earlier ones */
+    static void truncated_test(void);
+    /** reading only what was appended gives the same maps as reading
+     *  the whole index, also when the last block is still being written */
+    static void tail_test(void);
+    /** writing replaces the whole index */
+    static void write_test(void);
+    /** files that aren't seek indexes are rejected */
+    static void badMagic_test(void);
+};
@@ -32,6 +32,7 @@
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <thread>
 #include <utility>
 #if HAVE_GETTIMEOFDAY
 #include <sys/time.h>
@@ -169,35 +170,43 @@ int64_t LoggingItem::getThreadTid(void)
     return m_tid;
 }
 
-/// \brief Set the thread ID of the thread that produced the LoggingItem.  This
-///        code is actually run in the thread in question as part of the call
-///        to LOG()
-/// \note  In different platforms, the actual value returned here will vary.
-///        The intention is to get a thread ID that will map well to what is
-///        shown in gdb.
-void LoggingItem::setThreadTid(void)
+/// \brief Get the thread ID of the calling thread, remembering it for
+///        getThreadTid()
+static int64_t thread_tid(uint64_t threadId)
 {
     QMutexLocker locker(&logThreadTidMutex);
 
-    m_tid = logThreadTidHash.value(m_threadId, -1);
-    if (m_tid == -1)
+    int64_t tid = logThreadTidHash.value(threadId, -1);
+    if (tid == -1)
     {
-        m_tid = 0;
+        tid = 0;
 
 #if defined(Q_OS_ANDROID)
-        m_tid = (int64_t)gettid();
+        tid = (int64_t)gettid();
 #elif defined(__linux__)
-        m_tid = syscall(SYS_gettid);
+        tid = syscall(SYS_gettid);
 #elif defined(__FreeBSD__)
         long lwpid;
         int dummy = thr_self( &lwpid );
         (void)dummy;
-        m_tid = (int64_t)lwpid;
+        tid = (int64_t)lwpid;
 #elif defined(Q_OS_DARWIN)
-        m_tid = (int64_t)mach_thread_self();
+        tid = (int64_t)mach_thread_self();
 #endif
-        logThreadTidHash[m_threadId] = m_tid;
+        logThreadTidHash[threadId] = tid;
     }
+    return tid;
+}
+
+/// \brief Set the thread ID of the thread that produced the LoggingItem.  This
+///        code is actually run in the thread in question as part of the call
+///        to LOG()
+/// \note  In different platforms, the actual value returned here will vary.
+///        The intention is to get a thread ID that will map well to what is
+///        shown in gdb.
+void LoggingItem::setThreadTid(void)
+{
+    m_tid = thread_tid(m_threadId);
 }
 
 /// \brief Convert numerical timestamp to a readable date and time.
@@ -225,6 +234,113 @@ char LoggingItem::getLevelChar (void)
     return '-';
 }
 
+LogRing::LogRing(void) :
+    m_records(kSize)
+{
+    for (size_t i = 0; i < kSize; i++)
+        m_records[i].m_sequence.store(i, std::memory_order_relaxed);
+}
+
+/// \brief  Copy a message into the next free record.  Called from any
+///         thread, it neither locks nor allocates.
+/// \return false if the message is too long or the ring is full
+bool LogRing::Push(const char *file, const char *function, int line,
+                   LogLevel_t level, int type, const QString &message)
+{
+    if (static_cast<size_t>(message.size()) > kMaxMessage)
+        return false;
+
+    // Claim a record, see Vyukov's bounded MPMC queue
+    size_t pos = m_head.load(std::memory_order_relaxed);
+    Record *record = nullptr;
+    while (true)
+    {
+        record = &m_records[pos & (kSize - 1)];
+        size_t seq = record->m_sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<ptrdiff_t>(seq - pos);
+        if (diff == 0)
+        {
+            // Sequentially consistent, as is LoggerThread::m_sleeping, so
+            // that either the logging thread sees this or Push() sees it
+            // is going to sleep
+            if (m_head.compare_exchange_weak(pos, pos + 1))
+                break;
+        }
+        else if (diff < 0)
+        {
+            return false; // full
+        }
+        else
+        {
+            pos = m_head.load(std::memory_order_relaxed);
+        }
+    }
+
+    // The thread ID only needs looking up once per thread
+    static thread_local uint64_t t_threadId = UINT64_MAX;
+    static thread_local int64_t  t_tid = -1;
+    auto threadId = (uint64_t)(QThread::currentThreadId());
+    if (threadId != t_threadId)
+    {
+        t_threadId = threadId;
+        t_tid = thread_tid(threadId);
+    }
+
+    record->m_epoch    = nowAsDuration<std::chrono::microseconds>();
+    record->m_threadId = threadId;
+    record->m_tid      = t_tid;
+    record->m_file     = file;
+    record->m_function = function;
+    record->m_line     = line;
+    record->m_type     = type;
+    record->m_level    = level;
+    record->m_length   = message.size();
+    std::copy_n(message.utf16(), message.size(), record->m_message.begin());
+
+    record->m_sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+/// \brief  Take the oldest message as a LoggingItem, if its record is
+///         before position \p before.  Only called from the logging thread.
+///
+/// A record that was claimed but is still being copied in is waited for,
+/// so that every message claimed before Head() returned \p before is
+/// taken.
+/// \return nullptr if there is no such message
+LoggingItem *LogRing::Pop(size_t before)
+{
+    size_t pos = m_tail.load(std::memory_order_relaxed);
+    if (pos == m_head.load() || pos >= before)
+        return nullptr;
+
+    Record &record = m_records[pos & (kSize - 1)];
+    while (record.m_sequence.load(std::memory_order_acquire) != pos + 1)
+        std::this_thread::yield();
+
+    auto *item = new LoggingItem;
+    item->m_epoch    = record.m_epoch;
+    item->m_threadId = record.m_threadId;
+    item->m_tid      = record.m_tid;
+    item->m_file     = record.m_file;
+    item->m_function = record.m_function;
+    item->m_line     = record.m_line;
+    item->m_type     = static_cast<LoggingType>(record.m_type);
+    item->m_level    = record.m_level;
+    item->m_message  = QString(reinterpret_cast<const QChar *>(
+                                   record.m_message.data()), record.m_length);
+
+    record.m_sequence.store(pos + kSize, std::memory_order_release);
+    m_tail.store(pos + 1, std::memory_order_relaxed);
+    return item;
+}
+
+/// \brief  True if no message is queued or being copied in
+bool LogRing::IsEmpty(void) const
+{
+    return m_head.load() == m_tail.load();
+}
+
 /// \brief LoggerThread constructor.  Enables debugging of thread registration
 ///        and deregistration if the VERBOSE_THREADS environment variable is
 ///        set.
@@ -278,29 +394,45 @@ void LoggerThread::run(void)
 
     QMutexLocker qLock(&logQueueMutex);
 
-    while (!m_aborted || !logQueue.isEmpty())
+    while (!m_aborted || !logQueue.isEmpty() || !m_ring.IsEmpty())
     {
+        // Messages in the ring claimed before the next queued item come
+        // first.  With nothing queued, the ones claimed before now, any
+        // item queued later notes a later head.
+        LoggingItem *item = nullptr;
+        size_t before = 0;
+        if (logQueue.isEmpty())
+        {
+            before = m_ring.Head();
+        }
+        else
+        {
+            item = logQueue.dequeue();
+            before = item->m_ringHead;
+        }
         qLock.unlock();
+
         qApp->processEvents(QEventLoop::AllEvents, 10);
         qApp->sendPostedEvents(nullptr, QEvent::DeferredDelete);
+        handleRing(before);
 
-        qLock.relock();
-        if (logQueue.isEmpty())
+        if (item)
         {
-            m_waitEmpty->wakeAll();
-            m_waitNotEmpty->wait(qLock.mutex(), 100);
-            continue;
+            fillItem(item);
+            handleItem(item);
+            logConsole(item);
+            item->DecrRef();
         }
 
-        LoggingItem *item = logQueue.dequeue();
-        qLock.unlock();
-
-        fillItem(item);
-        handleItem(item);
-        logConsole(item);
-        item->DecrRef();
-
         qLock.relock();
+        if (item || !logQueue.isEmpty() || !m_ring.IsEmpty())
+            continue;
+
+        m_waitEmpty->wakeAll();
+        m_sleeping = true;
+        if (m_ring.IsEmpty())
+            m_waitNotEmpty->wait(qLock.mutex(), 100);
+        m_sleeping = false;
     }
 
     qLock.unlock();
@@ -317,6 +449,26 @@ void LoggerThread::run(void)
     }
 }
 
+/// \brief  Handles the messages in m_ring before position \p before.
+void LoggerThread::handleRing(size_t before)
+{
+    while (LoggingItem *item = m_ring.Pop(before))
+    {
+        fillItem(item);
+        handleItem(item);
+        logConsole(item);
+        item->DecrRef();
+    }
+}
+
+/// \brief  Queue an item for the logging thread, after the messages
+///         already in the ring.  logQueueMutex must be held.
+void LoggerThread::enqueue(LoggingItem *item)
+{
+    item->m_ringHead = logThread ? logThread->m_ring.Head() : 0;
+    logQueue.enqueue(item);
+}
+
 /// \brief  Handles each LoggingItem.  There is a special case for
 ///         thread registration and deregistration which are also included in
 ///         the logging queue to keep the thread names in sync with the log
@@ -500,14 +652,15 @@ bool LoggerThread::flush(int timeoutMS)
 {
     QElapsedTimer t;
     t.start();
-    while (!m_aborted && !logQueue.isEmpty() && !t.hasExpired(timeoutMS))
+    while (!m_aborted && (!logQueue.isEmpty() || !m_ring.IsEmpty()) &&
+           !t.hasExpired(timeoutMS))
     {
         m_waitNotEmpty->wakeAll();
         int left = timeoutMS - t.elapsed();
         if (left > 0)
             m_waitEmpty->wait(&logQueueMutex, left);
     }
-    return logQueue.isEmpty();
+    return logQueue.isEmpty() && m_ring.IsEmpty();
 }
 
 void LoggerThread::fillItem(LoggingItem *item)
@@ -567,6 +720,24 @@ void LogPrintLine( uint64_t mask, LogLevel_t level, const char *file, int line,
     int type = kMessage;
     type |= (mask & VB_FLUSH) ? kFlush : 0;
     type |= (mask & VB_STDIO) ? kStandardIO : 0;
+
+#if defined( _MSC_VER ) && defined( _DEBUG )
+        OutputDebugStringA( qPrintable(message) );
+        OutputDebugStringA( "\n" );
+#endif
+
+    // Without locking or allocating when the logging thread keeps up
+    if (logThread && !logThreadFinished && !(type & kFlush) &&
+        logThread->m_ring.Push(file, function, line, level, type, message))
+    {
+        if (logThread->m_sleeping)
+        {
+            QMutexLocker qLock(&logQueueMutex);
+            logThread->m_waitNotEmpty->wakeAll();
+        }
+        return;
+    }
+
     LoggingItem *item = LoggingItem::create(file, function, line, level,
                                             (LoggingType)type);
     if (!item)
@@ -576,12 +747,7 @@ void LogPrintLine( uint64_t mask, LogLevel_t level, const char *file, int line,
 
     QMutexLocker qLock(&logQueueMutex);
 
-#if defined( _MSC_VER ) && defined( _DEBUG )
-        OutputDebugStringA( qPrintable(item->m_message) );
-        OutputDebugStringA( "\n" );
-#endif
-
-    logQueue.enqueue(item);
+    LoggerThread::enqueue(item);
 
     if (logThread && logThreadFinished && !logThread->isRunning())
     {
@@ -589,11 +755,14 @@ void LogPrintLine( uint64_t mask, LogLevel_t level, const char *file, int line,
         {
             item = logQueue.dequeue();
             qLock.unlock();
+            logThread->handleRing(item->m_ringHead);
             logThread->handleItem(item);
             logThread->logConsole(item);
             item->DecrRef();
             qLock.relock();
         }
+        qLock.unlock();
+        logThread->handleRing();
     }
     else if (logThread && !logThreadFinished && (type & kFlush))
     {
@@ -740,7 +909,7 @@ void loggingRegisterThread(const QString &name)
     if (item)
     {
         item->setThreadName((char *)name.toLocal8Bit().constData());
-        logQueue.enqueue(item);
+        LoggerThread::enqueue(item);
     }
 }
 
@@ -757,7 +926,7 @@ void loggingDeregisterThread(void)
                                             LOG_DEBUG,
                                             kDeregistering);
     if (item)
-        logQueue.enqueue(item);
+        LoggerThread::enqueue(item);
 }
 
 
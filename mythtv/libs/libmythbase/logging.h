@@ -7,8 +7,11 @@
 #include <QPointer>
 #include <QCoreApplication>
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <cstdlib>
+#include <vector>
 
 #include "mythconfig.h"
 #include "mythbaseexp.h"  //  MBASE_PUBLIC , etc.
@@ -73,6 +76,7 @@ class LoggingItem: public QObject, public ReferenceCounter
     Q_PROPERTY(QString message READ message WRITE setMessage)
 
     friend class LoggerThread;
+    friend class LogRing;
     friend MBASE_PUBLIC void LogPrintLine(uint64_t mask, LogLevel_t level, const char *file, int line,
                              const char *function, QString message);
 
@@ -131,6 +135,7 @@ class LoggingItem: public QObject, public ReferenceCounter
     LogLevel_t          m_level      {LOG_INFO};
     int                 m_facility   {0};
     std::chrono::microseconds m_epoch {0us};
+    size_t              m_ringHead   {0}; ///< LogRing::Head() when queued
     QString             m_file       {};
     QString             m_function   {};
     QString             m_threadName {};
@@ -147,6 +152,55 @@ class LoggingItem: public QObject, public ReferenceCounter
     Q_DISABLE_COPY(LoggingItem);
 };
 
+/// \brief Bounded queue of LOG() messages, for many threads to add to and
+///        the logging thread to take from without locking
+///
+/// The messages are copied into records allocated with the queue, so
+/// that adding a message allocates nothing.  Messages that don't fit in a
+/// record, or don't fit in the queue because it is full, are left to the
+/// caller to queue as a LoggingItem.
+///
+/// A queued LoggingItem notes Head() when it is queued.  The logging
+/// thread takes the records before that position first, so that it handles
+/// messages in the order they were logged.
+class MBASE_PUBLIC LogRing
+{
+  public:
+    static constexpr size_t kSize       { 256 };  ///< Records, a power of 2
+    static constexpr size_t kMaxMessage { LOGLINE_MAX / 2 }; ///< UTF-16 units
+
+    LogRing(void);
+
+    bool Push(const char *file, const char *function, int line,
+              LogLevel_t level, int type, const QString &message);
+    LoggingItem *Pop(size_t before = SIZE_MAX);
+    bool IsEmpty(void) const;
+    /// Position of the next record to be claimed
+    size_t Head(void) const { return m_head.load(); }
+
+  private:
+    Q_DISABLE_COPY(LogRing);
+
+    struct Record
+    {
+        std::atomic<size_t>       m_sequence {0};
+        std::chrono::microseconds m_epoch    {0us};
+        uint64_t                  m_threadId {0};
+        int64_t                   m_tid      {0};
+        const char               *m_file     {nullptr};
+        const char               *m_function {nullptr};
+        int                       m_line     {0};
+        int                       m_type     {kMessage};
+        LogLevel_t                m_level    {LOG_INFO};
+        int                       m_length   {0};
+        std::array<char16_t,kMaxMessage> m_message {};
+    };
+
+    std::vector<Record>  m_records;
+    alignas(64) std::atomic<size_t> m_head {0}; ///< Next record to fill
+    alignas(64) std::atomic<size_t> m_tail {0}; ///< Next record to take
+};
+
 /// \brief The logging thread that consumes the logging queue and dispatches
 ///        each LoggingItem
 class LoggerThread : public QObject, public MThread
@@ -163,9 +217,15 @@ class LoggerThread : public QObject, public MThread
     void stop(void);
     bool flush(int timeoutMS = 200000);
     static void handleItem(LoggingItem *item);
+    static void enqueue(LoggingItem *item);
     void fillItem(LoggingItem *item);
   private:
     Q_DISABLE_COPY(LoggerThread);
+    void handleRing(size_t before = SIZE_MAX);
+    LogRing m_ring;                 ///< Messages queued without locking
+    std::atomic<bool> m_sleeping {false};
+                                    ///< Set while waiting on m_waitNotEmpty,
+                                    ///  to wake it after adding to m_ring
     QWaitCondition *m_waitNotEmpty {nullptr};
                                     ///< Condition variable for waiting
                                     ///  for the queue to not be empty
@@ -3,6 +3,9 @@
 // ANSI C
 #include <cstdlib>
 
+// C++
+#include <algorithm>
+
 // Qt
 #include <QCoreApplication>
 #include <QElapsedTimer>
@@ -102,7 +105,7 @@ MSqlDatabase::~MSqlDatabase()
 {
     if (m_db.isOpen())
     {
-        m_db.close();
+        Close();
         m_db = QSqlDatabase();  // forces a destroy and must be done before
                                 // removeDatabase() so that connections
                                 // and queries are cleaned up correctly
@@ -246,14 +249,17 @@ bool MSqlDatabase::KickDatabase(void)
     m_lastDBKick = MythDate::current().addSecs(-60);
 
     if (!m_db.isOpen())
+    {
+        m_statements.clear();
         m_db.open();
+    }
 
     return m_db.isOpen();
 }
 
 bool MSqlDatabase::Reconnect()
 {
-    m_db.close();
+    Close();
     m_db.open();
 
     bool open = m_db.isOpen();
@@ -266,6 +272,34 @@ bool MSqlDatabase::Reconnect()
     return open;
 }
 
+void MSqlDatabase::Close(void)
+{
+    // The statements belong to the connection, let them go first
+    m_statements.clear();
+    m_db.close();
+}
+
+/// Hands out the prepared statement for query, if this connection kept one
+bool MSqlDatabase::TakeStatement(const QString &query, QSqlQuery &statement)
+{
+    auto it = m_statements.find(query);
+    if (it == m_statements.end())
+        return false;
+
+    statement = *it;
+    m_statements.erase(it);
+    return true;
+}
+
+/// Keeps the prepared statement for the next query with the same SQL
+void MSqlDatabase::CacheStatement(const QString &query,
+                                  const QSqlQuery &statement)
+{
+    if (m_statements.size() >= kMaxStatements && !m_statements.contains(query))
+        m_statements.erase(m_statements.begin());
+    m_statements.insert(query, statement);
+}
+
 void MSqlDatabase::InitSessionVars()
 {
     // Make sure NOW() returns time in UTC...
@@ -480,7 +514,7 @@ void MDBManager::CloseDatabases()
     {
         LOG(VB_DATABASE, LOG_INFO,
             "Closing DB connection named '" + conn->m_name + "'");
-        conn->m_db.close();
+        conn->Close();
         delete conn;
         m_connCount--;
     }
@@ -492,7 +526,7 @@ void MDBManager::CloseDatabases()
         MSqlDatabase *db = slist.takeFirst();
         LOG(VB_DATABASE, LOG_INFO,
             "Closing DB connection named '" + db->m_name + "'");
-        db->m_db.close();
+        db->Close();
         delete db;
 
         if (db == m_schedCon)
@@ -504,6 +538,81 @@ void MDBManager::CloseDatabases()
 }
 
 
+// -----------------------------------------------------------------------
+
+std::atomic<bool> MSqlProfiler::s_enabled
+    { qEnvironmentVariableIsSet("MYTHTV_SQL_PROFILE") };
+
+/// Statements seen after this many are counted together, so that a
+/// caller building its SQL in unexpected ways can't grow the stats forever
+static constexpr int kMaxProfiledStatements { 1000 };
+
+static QMutex s_profileLock;
+static QHash<QString, MSqlProfiler::Stats> s_profile; // protected by s_profileLock
+
+void MSqlProfiler::SetEnabled(bool enable)
+{
+    s_enabled = enable;
+    LOG(VB_GENERAL, LOG_INFO, QString("SQL profiling %1")
+        .arg(enable ? "enabled" : "disabled"));
+}
+
+void MSqlProfiler::Reset(void)
+{
+    QMutexLocker locker(&s_profileLock);
+    s_profile.clear();
+}
+
+void MSqlProfiler::Record(const QString &statement,
+                          std::chrono::microseconds elapsed)
+{
+    QString normalized = Normalize(statement);
+
+    QMutexLocker locker(&s_profileLock);
+    if (s_profile.size() >= kMaxProfiledStatements &&
+        !s_profile.contains(normalized))
+    {
+        normalized = "<other statements>";
+    }
+
+    Stats &stats = s_profile[normalized];
+    if (stats.m_count++ == 0)
+        stats.m_statement = normalized;
+    stats.m_total += elapsed;
+    stats.m_max = std::max(stats.m_max, elapsed);
+}
+
+std::vector<MSqlProfiler::Stats> MSqlProfiler::GetStats(void)
+{
+    std::vector<Stats> stats;
+    {
+        QMutexLocker locker(&s_profileLock);
+        stats.reserve(s_profile.size());
+        for (const auto &entry : qAsConst(s_profile))
+            stats.push_back(entry);
+    }
+
+    std::sort(stats.begin(), stats.end(),
+              [](const Stats &a, const Stats &b)
+              { return a.m_total > b.m_total; });
+    return stats;
+}
+
+/// Replaces the literal values in statement by '?'
+QString MSqlProfiler::Normalize(const QString &statement)
+{
+    static const QRegularExpression kStrings
+        { R"('(?:[^'\\]|\\.|'')*'|"(?:[^"\\]|\\.|"")*")" };
+    static const QRegularExpression kNumbers { R"(\b\d+(?:\.\d+)?\b)" };
+    static const QRegularExpression kLists { R"(\?(?:\s*,\s*\?)+)" };
+
+    QString normalized = statement;
+    normalized.replace(kStrings, "?");
+    normalized.replace(kNumbers, "?");
+    normalized.replace(kLists, "?,...");
+    return normalized.simplified();
+}
+
 // -----------------------------------------------------------------------
 
 static void InitMSqlQueryInfo(MSqlQueryInfo &qi)
@@ -525,6 +634,8 @@ MSqlQuery::MSqlQuery(const MSqlQueryInfo &qi)
 
 MSqlQuery::~MSqlQuery()
 {
+    releaseStatement();
+
     if (m_returnConnection)
     {
         MDBManager *dbmanager = GetMythDB()->GetDBManager();
@@ -624,7 +735,7 @@ bool MSqlQuery::exec()
     {
         LOG(VB_GENERAL, LOG_INFO,
             "MSqlQuery disconnecting DB to test reconnection logic");
-        m_db->m_db.close();
+        m_db->Close();
     }
 #endif
 
@@ -645,6 +756,12 @@ bool MSqlQuery::exec()
     if (!result && lostConnectionCheck())
         result = QSqlQuery::exec();
 
+    if (MSqlProfiler::IsEnabled())
+    {
+        MSqlProfiler::Record(m_lastPreparedQuery,
+            std::chrono::microseconds(timer.nsecsElapsed() / 1000));
+    }
+
     if (!result)
     {
         QString err = MythDB::GetError("MSqlQuery", *this);
@@ -753,11 +870,23 @@ bool MSqlQuery::exec(const QString &query)
         return false;
     }
 
+    // Running another query throws away the prepared statement
+    m_cacheable = false;
+
+    QElapsedTimer timer;
+    timer.start();
+
     bool result = QSqlQuery::exec(query);
 
     if (!result && lostConnectionCheck())
         result = QSqlQuery::exec(query);
 
+    if (MSqlProfiler::IsEnabled())
+    {
+        MSqlProfiler::Record(query,
+            std::chrono::microseconds(timer.nsecsElapsed() / 1000));
+    }
+
     LOG(VB_DATABASE, LOG_INFO,
             QString("MSqlQuery::exec(%1) %2%3")
                     .arg(m_db->MSqlDatabase::GetConnectionName(), query,
@@ -836,6 +965,7 @@ bool MSqlQuery::prepare(const QString& query)
         return false;
     }
 
+    releaseStatement();
     m_lastPreparedQuery = query;
 
     if (!m_db->isOpen() && !Reconnect())
@@ -844,6 +974,17 @@ bool MSqlQuery::prepare(const QString& query)
         return false;
     }
 
+    // Reuse the statement if this connection has prepared it before
+    if (m_db->TakeStatement(query, *this))
+    {
+        // Values bound for the last query mustn't leak into this one
+        int count = static_cast<int>(QSqlQuery::boundValues().size());
+        for (int i = 0; i < count; i++)
+            QSqlQuery::bindValue(i, QVariant());
+        m_cacheable = true;
+        return true;
+    }
+
     // QT docs indicate that there are significant speed ups and a reduction
     // in memory usage by enabling forward-only cursors
     //
@@ -852,6 +993,7 @@ bool MSqlQuery::prepare(const QString& query)
     setForwardOnly(true);
 
     bool ok = QSqlQuery::prepare(query);
+    m_cacheable = ok;
 
     if (!ok && lostConnectionCheck())
         ok = true;
@@ -867,6 +1009,21 @@ bool MSqlQuery::prepare(const QString& query)
     return ok;
 }
 
+/// Hands the prepared statement back to the connection for reuse
+void MSqlQuery::releaseStatement(void)
+{
+    if (!m_cacheable)
+        return;
+    m_cacheable = false;
+
+    if (!m_db || !m_db->isOpen())
+        return;
+
+    // Let go of any rows not read, the statement itself stays prepared
+    finish();
+    m_db->CacheStatement(m_lastPreparedQuery, *this);
+}
+
 bool MSqlQuery::testDBConnection()
 {
     MSqlDatabase *db = GetMythDB()->GetDBManager()->popConnection(true);
@@ -915,6 +1072,7 @@ QVariant MSqlQuery::lastInsertId()
 
 bool MSqlQuery::Reconnect(void)
 {
+    m_cacheable = false;
     if (!m_db->Reconnect())
         return false;
     if (!m_lastPreparedQuery.isEmpty())
@@ -931,6 +1089,7 @@ bool MSqlQuery::Reconnect(void)
 	for (int i = 0; i < static_cast<int>(tmp.size()); i++)
 	    QSqlQuery::bindValue(i, tmp.at(i));
 #endif
+        m_cacheable = true;
     }
     return true;
 }
@@ -1,6 +1,10 @@
 #ifndef MYTHDBCON_H_
 #define MYTHDBCON_H_
 
+#include <atomic>
+#include <vector>
+
+#include <QHash>
 #include <QSqlDatabase>
 #include <QSqlRecord>
 #include <QSqlError>
@@ -11,6 +15,7 @@
 #include <QList>
 
 #include "mythbaseexp.h"
+#include "mythchrono.h"
 #include "mythdbparams.h"
 
 #define REUSE_CONNECTION 1
@@ -40,13 +45,24 @@ class MSqlDatabase
     QSqlDatabase db(void) const { return m_db; }
     bool Reconnect(void);
     void InitSessionVars(void);
+    void Close(void);
+
+    bool TakeStatement(const QString &query, QSqlQuery &statement);
+    void CacheStatement(const QString &query, const QSqlQuery &statement);
 
   private:
+    /// Prepared statements kept per connection, they are server side
+    /// resources and MySQL limits how many there are in total.
+    static constexpr int kMaxStatements { 32 };
+
     QString m_name;
     QString m_driver;
     QSqlDatabase m_db;
     QDateTime m_lastDBKick;
     DatabaseParams m_dbparms;
+    /// Prepared statements that are not in use, keyed by their SQL.
+    /// Only the thread using the connection touches them.
+    QHash<QString, QSqlQuery> m_statements;
 };
 
 /// \brief DB connection pool, used by MSqlQuery. Do not use directly.
@@ -94,6 +110,39 @@ struct MSqlQueryInfo
     bool returnConnection {false};
 };
 
+/** \brief Aggregates the time spent running each SQL statement.
+ *
+ *  Statements are grouped once their literal values have been replaced
+ *  by '?', so that queries built with different values count as one.
+ *  Profiling is off unless enabled with SetEnabled() or by setting
+ *  MYTHTV_SQL_PROFILE in the environment.
+ */
+class MBASE_PUBLIC MSqlProfiler
+{
+  public:
+    struct Stats
+    {
+        QString                   m_statement;
+        quint64                   m_count { 0 };
+        std::chrono::microseconds m_total { 0us };
+        std::chrono::microseconds m_max   { 0us };
+    };
+
+    static void SetEnabled(bool enable);
+    static bool IsEnabled(void) { return s_enabled; }
+    static void Reset(void);
+
+    static void Record(const QString &statement,
+                       std::chrono::microseconds elapsed);
+    /// Returns the statements seen, the longest total time first
+    static std::vector<Stats> GetStats(void);
+
+    static QString Normalize(const QString &statement);
+
+  private:
+    static std::atomic<bool> s_enabled;
+};
+
 /// \brief typedef for a map of string -> string bindings for generic queries.
 using MSqlBindings = QMap<QString, QVariant>;
 
@@ -243,11 +292,13 @@ class MBASE_PUBLIC MSqlQuery : private QSqlQuery
 
     bool seekDebug(const char *type, bool result,
                    int where, bool relative) const;
+    void releaseStatement(void);
 
     MSqlDatabase *m_db               {nullptr};
     bool          m_isConnected      {false};
     bool          m_returnConnection {false};
     QString       m_lastPreparedQuery; // holds a copy of the last prepared query
+    bool          m_cacheable        {false}; // m_lastPreparedQuery is prepared
 };
 
 #endif
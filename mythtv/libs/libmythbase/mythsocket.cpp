@@ -16,7 +16,12 @@
 #include <cstdio>
 #else
 #include <sys/socket.h>
+#include <poll.h>
 #endif
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
+#include <cerrno>
 #include <unistd.h> // for usleep (and socket code on Q_OS_WIN)
 #include <algorithm> // for max
 #include <vector> // for vector
@@ -557,6 +562,72 @@ void MythSocket::Reset(void)
         Qt::BlockingQueuedConnection : Qt::DirectConnection);
 }
 
+int MythSocket::SendFile(int fd, long long *offset, int size)
+{
+#ifdef __linux__
+    // Data handed to Qt earlier must go out first
+    if (m_writePending.loadAcquire())
+    {
+        bool flushed = false;
+        QMetaObject::invokeMethod(
+            this, "FlushReal",
+            (QThread::currentThread() != m_thread->qthread()) ?
+            Qt::BlockingQueuedConnection : Qt::DirectConnection,
+            Q_ARG(bool*, &flushed));
+        if (!flushed)
+        {
+            errno = EIO;
+            return -1;
+        }
+    }
+
+    int sock = GetSocketDescriptor();
+    off_t pos = *offset;
+    int sent = 0;
+    while (sent < size)
+    {
+        ssize_t ret = sendfile(sock, fd, &pos, size - sent);
+        if (ret > 0)
+        {
+            sent += static_cast<int>(ret);
+            continue;
+        }
+        if (ret == 0)
+            break; // end of file
+
+        if (errno == EINTR)
+            continue;
+        if (errno == EAGAIN)
+        {
+            // The socket is non-blocking, wait for the peer to catch up
+            pollfd pfd { sock, POLLOUT, 0 };
+            int ready = poll(&pfd, 1, static_cast<int>(kLongTimeout.count()));
+            if (ready > 0)
+                continue;
+            if (ready == 0)
+                errno = ETIMEDOUT;
+        }
+
+        int err = errno;
+        if (err != EINVAL && err != ENOSYS)
+            LOG(VB_NETWORK, LOG_ERR, LOC + "SendFile(): Error" + ENO);
+        errno = err;
+        if (sent == 0)
+            return -1;
+        break;
+    }
+
+    *offset = pos;
+    return sent;
+#else
+    Q_UNUSED(fd);
+    Q_UNUSED(offset);
+    Q_UNUSED(size);
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 bool MythSocket::IsConnected(void) const
@@ -794,6 +865,8 @@ void MythSocket::WriteStringListReal(const QStringList *list, bool *ret)
     }
 
     m_tcpSocket->flush();
+    if (m_tcpSocket->bytesToWrite() > 0)
+        m_writePending.storeRelease(1);
 
     *ret = true;
 }
@@ -962,6 +1035,8 @@ void MythSocket::ReadStringListReal(
 void MythSocket::WriteReal(const char *data, int size, int *ret)
 {
     *ret = m_tcpSocket->write(data, size);
+    if (m_tcpSocket->bytesToWrite() > 0)
+        m_writePending.storeRelease(1);
 }
 
 void MythSocket::ReadReal(char *data, int size, std::chrono::milliseconds max_wait_ms, int *ret)
@@ -987,6 +1062,23 @@ void MythSocket::ReadReal(char *data, int size, std::chrono::milliseconds max_wa
         (m_tcpSocket->bytesAvailable() > 0) ? 1 : 0);
 }
 
+void MythSocket::FlushReal(bool *ret)
+{
+    MythTimer timer;
+    timer.start();
+    while ((m_tcpSocket->bytesToWrite() > 0) &&
+           (m_tcpSocket->state() == QAbstractSocket::ConnectedState) &&
+           (timer.elapsed() < kLongTimeout))
+    {
+        m_tcpSocket->waitForBytesWritten(
+            (kLongTimeout - timer.elapsed()).count());
+    }
+
+    *ret = (m_tcpSocket->bytesToWrite() == 0);
+    if (*ret)
+        m_writePending.storeRelease(0);
+}
+
 void MythSocket::ResetReal(void)
 {
     std::vector<char> trash;
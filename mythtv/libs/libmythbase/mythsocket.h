@@ -67,6 +67,16 @@ class MBASE_PUBLIC MythSocket : public QObject, public ReferenceCounter
     int Read(char *data, int size,  std::chrono::milliseconds max_wait);
     void Reset(void);
 
+    /** \brief Sends size bytes of the file fd, starting at *offset,
+     *         without copying them through the socket's buffers.
+     *
+     *  Blocks until the data is sent, or the peer stops taking it.
+     *  \return bytes sent, fewer than size at the end of the file, or -1
+     *          with errno set.  ENOSYS or EINVAL mean fd can't be sent
+     *          this way and the data must be Write()n instead.
+     */
+    int SendFile(int fd, long long *offset, int size);
+
     static constexpr std::chrono::milliseconds kShortTimeout { kMythSocketShortTimeout };
     static constexpr std::chrono::milliseconds kLongTimeout  { kMythSocketLongTimeout };
 
@@ -89,6 +99,7 @@ class MBASE_PUBLIC MythSocket : public QObject, public ReferenceCounter
     void WriteReal(const char *data, int size, int *ret);
     void ReadReal(char *data, int size, std::chrono::milliseconds max_wait_ms, int *ret);
     void ResetReal(void);
+    void FlushReal(bool *ret);
 
     void IsDataAvailableReal(bool *ret) const;
 
@@ -108,6 +119,9 @@ class MBASE_PUBLIC MythSocket : public QObject, public ReferenceCounter
     /// This is used internally as a hint that there might be
     /// data available for reading.
     mutable QAtomicInt m_dataAvailable {0};
+    /// Set while Qt may still hold written data that it hasn't sent,
+    /// which SendFile() must not overtake.
+    QAtomicInt      m_writePending     {0};
     bool            m_isValidated      {false}; // only set in thread using MythSocket
     bool            m_isAnnounced      {false}; // only set in thread using MythSocket
     QStringList     m_announce; // only set in thread using MythSocket
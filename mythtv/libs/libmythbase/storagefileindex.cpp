@@ -0,0 +1,189 @@
+#include <QDirIterator>
+#include <QFileInfo>
+
+#include "filesysteminfo.h"
+#include "mythdate.h"
+#include "mythlogging.h"
+#include "storagefileindex.h"
+
+#define LOC QString("SFIndex: ")
+
+StorageFileIndex *StorageFileIndex::s_instance = nullptr;
+
+void StorageFileIndex::Enable(void)
+{
+    if (!s_instance)
+        s_instance = new StorageFileIndex();
+}
+
+void StorageFileIndex::Disable(void)
+{
+    delete s_instance;
+    s_instance = nullptr;
+}
+
+StorageFileIndex::StorageFileIndex(void)
+{
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged,
+            this, [this](const QString &dir)
+    {
+        bool watched = m_watcher.directories().contains(dir);
+        QMutexLocker locker(&m_lock);
+        auto it = m_dirs.find(dir);
+        if (it != m_dirs.end())
+        {
+            it->m_stale = true;
+            it->m_watched = watched;
+        }
+    });
+}
+
+StorageFileIndex::Result StorageFileIndex::Lookup(
+    const QString &dir, const QString &filename,
+    qint64 *size, QDateTime *listed)
+{
+    // Only the files directly in storage directories are indexed
+    if (dir.isEmpty() || filename.isEmpty() || filename.contains('/'))
+        return kUnknown;
+
+    QString path = dir.endsWith('/') ? dir.left(dir.size() - 1) : dir;
+    Update(path);
+
+    QMutexLocker locker(&m_lock);
+    const Directory &directory = m_dirs[path];
+
+    auto it = directory.m_files.constFind(filename);
+    if (it == directory.m_files.constEnd())
+        return directory.m_watched ? kMissing : kUnknown;
+
+    if (size)
+        *size = *it;
+    if (listed)
+        *listed = directory.m_listed;
+    return kFound;
+}
+
+StorageFileIndex::Result StorageFileIndex::Lookup(
+    const QString &path, qint64 *size, QDateTime *listed)
+{
+    int slash = path.lastIndexOf('/');
+    if (slash <= 0)
+        return kUnknown;
+    return Lookup(path.left(slash), path.mid(slash + 1), size, listed);
+}
+
+bool StorageFileIndex::Exists(const QString &path)
+{
+    if (s_instance && s_instance->Lookup(path) == kFound)
+        return true;
+    return QFile::exists(path);
+}
+
+qint64 StorageFileIndex::Size(const QString &path,
+                              const QDateTime &lastModified)
+{
+    if (s_instance)
+    {
+        qint64 size = 0;
+        QDateTime listed;
+        Result result = s_instance->Lookup(path, &size, &listed);
+        if (result == kFound && lastModified.isValid() &&
+            listed > lastModified)
+        {
+            return size;
+        }
+    }
+
+    QFileInfo info(path);
+    return info.exists() ? info.size() : -1;
+}
+
+/// Lists dir again if need be, m_lock must not be held
+void StorageFileIndex::Update(const QString &dir)
+{
+    QMutexLocker locker(&m_lock);
+    auto it = m_dirs.find(dir);
+    if (it == m_dirs.end())
+    {
+        locker.unlock();
+        FileSystemInfo fsInfo(QString(), dir, true, -1, -1, 0, 0, 0);
+        fsInfo.PopulateFSProp();
+        locker.relock();
+
+        it = m_dirs.find(dir);
+        if (it == m_dirs.end())
+        {
+            it = m_dirs.insert(dir, Directory());
+            it->m_local = fsInfo.isLocal();
+            if (it->m_local)
+                Watch(dir);
+        }
+    }
+
+    // Another thread may be listing it already, until then its old
+    // listing is used
+    if (it->m_listing || !(it->m_stale || (!it->m_watched &&
+        it->m_listed.secsTo(MythDate::current()) >= kRescanInterval.count())))
+    {
+        return;
+    }
+
+    // Anything that changes while listing is newer than the listing
+    QDateTime listed = MythDate::current();
+    it->m_stale = false;
+    it->m_listing = true;
+    locker.unlock();
+
+    QHash<QString, qint64> files = List(dir);
+
+    locker.relock();
+    it = m_dirs.find(dir);
+    if (it != m_dirs.end())
+    {
+        it->m_files = files;
+        it->m_listed = listed;
+        it->m_listing = false;
+    }
+}
+
+QHash<QString, qint64> StorageFileIndex::List(const QString &dir)
+{
+    QHash<QString, qint64> files;
+    QDirIterator it(dir, QDir::Files | QDir::System | QDir::Hidden |
+                    QDir::NoDotAndDotDot);
+    while (it.hasNext())
+    {
+        it.next();
+        files.insert(it.fileName(), it.fileInfo().size());
+    }
+
+    LOG(VB_FILE, LOG_DEBUG, LOC + QString("Listed %1 files in '%2'")
+        .arg(files.size()).arg(dir));
+    return files;
+}
+
+/// Starts watching dir from the thread of the watcher
+void StorageFileIndex::Watch(const QString &dir)
+{
+    QMetaObject::invokeMethod(this, [this, dir]()
+    {
+        bool watched = m_watcher.addPath(dir);
+        if (!watched)
+        {
+            LOG(VB_FILE, LOG_WARNING, LOC +
+                QString("Unable to watch '%1', listing it every %2 seconds")
+                .arg(dir).arg(kRescanInterval.count()));
+        }
+
+        QMutexLocker locker(&m_lock);
+        auto it = m_dirs.find(dir);
+        if (it != m_dirs.end())
+        {
+            it->m_watched = watched;
+            // Files may have come and gone since it was listed
+            it->m_stale = true;
+        }
+    }, Qt::QueuedConnection);
+}
+
+/* vim: set expandtab tabstop=4 shiftwidth=4: */
@@ -0,0 +1,102 @@
+#ifndef STORAGEFILEINDEX_H
+#define STORAGEFILEINDEX_H
+
+#include <cstdint>
+
+#include <QDateTime>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+
+#include "mythbaseexp.h"
+#include "mythchrono.h"
+
+/** \brief Index of the files in storage group directories.
+ *
+ *  The backend looks up every recording it lists in every directory of
+ *  its storage group, and on network file systems each of those stat()
+ *  calls is a round trip.  The index lists a directory once and answers
+ *  from the listing until the directory changes.
+ *
+ *  Local directories are watched, and listed again after files are
+ *  added, removed or renamed in them.  Directories on network file
+ *  systems, where changes made by other hosts aren't seen, are listed
+ *  again once their listing is kRescanInterval old.  Directories are
+ *  listed without holding the lock, so a slow listing only delays the
+ *  lookups that wait for it.
+ *
+ *  Files found are trusted.  Files missing from a listing may have been
+ *  created since, the change notification is queued, so the caller has
+ *  to check for itself: kMissing only means the listing was current,
+ *  kUnknown that it may not be.
+ *
+ *  Only the backend enables the index, everywhere else Instance()
+ *  returns nullptr.
+ */
+class MBASE_PUBLIC StorageFileIndex : public QObject
+{
+    Q_OBJECT
+
+  public:
+    enum Result : std::uint8_t
+    {
+        kUnknown,  ///< Not indexed, check the file system
+        kMissing,
+        kFound,
+    };
+
+    static constexpr std::chrono::seconds kRescanInterval { 60s };
+
+    /// Starts indexing, must be called from a thread with an event loop
+    static void Enable(void);
+    static void Disable(void);
+    static StorageFileIndex *Instance(void) { return s_instance; }
+
+    /** \brief Looks up filename in the storage directory dir.
+     *  \param size     set to the size of the file, when found
+     *  \param listed   set to when the file was seen with that size
+     */
+    Result Lookup(const QString &dir, const QString &filename,
+                  qint64 *size = nullptr, QDateTime *listed = nullptr);
+    Result Lookup(const QString &path, qint64 *size = nullptr,
+                  QDateTime *listed = nullptr);
+
+    /// True if the file at path exists, asks the index if enabled
+    static bool Exists(const QString &path);
+    /** \brief Returns the size of the file at path, or -1 if it is
+     *         missing.
+     *
+     *  The indexed size is used if the file was listed after
+     *  lastModified, when it couldn't change anymore.
+     */
+    static qint64 Size(const QString &path, const QDateTime &lastModified);
+
+  private:
+    StorageFileIndex(void);
+
+    struct Directory
+    {
+        QHash<QString, qint64> m_files;
+        QDateTime              m_listed;
+        bool                   m_local   {false};
+        bool                   m_watched {false};
+        bool                   m_stale   {true};
+        bool                   m_listing {false};
+    };
+
+    void Update(const QString &dir);
+    static QHash<QString, qint64> List(const QString &dir);
+    void Watch(const QString &dir);
+
+    QMutex                     m_lock;
+    QHash<QString, Directory>  m_dirs;
+    QFileSystemWatcher         m_watcher;
+
+    static StorageFileIndex   *s_instance;
+};
+
+#endif // STORAGEFILEINDEX_H
+
+/* vim: set expandtab tabstop=4 shiftwidth=4: */
@@ -8,6 +8,7 @@
 #include "mythlogging.h"
 #include "mythcoreutil.h"
 #include "mythdirs.h"
+#include "storagefileindex.h"
 
 #define LOC QString("SG(%1): ").arg(m_groupname)
 
@@ -627,6 +628,18 @@ QString StorageGroup::FindFileDir(const QString &filename)
     QString result = "";
     QFileInfo checkFile("");
 
+    // Ask the index first, a file it hasn't seen may be new so stat()
+    // the directories before giving up
+    StorageFileIndex *index = StorageFileIndex::Instance();
+    if (index)
+    {
+        for (const auto & dir : qAsConst(m_dirlist))
+        {
+            if (index->Lookup(dir, filename) == StorageFileIndex::kFound)
+                return dir;
+        }
+    }
+
     int curDir = 0;
     while (curDir < m_dirlist.size())
     {
@@ -345,4 +345,255 @@ void TestLogging::test_logPropagateCalc (void)
 
 // logPropagateCalc
 
+void TestLogging::test_logRing (void)
+{
+    LogRing ring;
+    QVERIFY(ring.IsEmpty());
+    QVERIFY(ring.Pop() == nullptr);
+
+    for (size_t i = 0; i < LogRing::kSize; i++)
+    {
+        QVERIFY(ring.Push(__FILE__, __FUNCTION__, static_cast<int>(i),
+                          LOG_INFO, kMessage, QString("Message %1").arg(i)));
+    }
+    QVERIFY(!ring.IsEmpty());
+
+    // Full, and too long, messages are left to the caller
+    QVERIFY(!ring.Push(__FILE__, __FUNCTION__, __LINE__, LOG_INFO, kMessage,
+                       "One too many"));
+    LoggingItem *item = ring.Pop();
+    QVERIFY(item != nullptr);
+    QCOMPARE(item->message(), QString("Message 0"));
+    QCOMPARE(item->line(), 0);
+    QCOMPARE(item->level(), static_cast<int>(LOG_INFO));
+    QCOMPARE(item->function(), QString(__FUNCTION__));
+    LoggingItem *next = ring.Pop();
+    QVERIFY(next != nullptr);
+    QCOMPARE(next->message(), QString("Message 1"));
+    QCOMPARE(next->tid(), item->tid());
+    next->DecrRef();
+    item->DecrRef();
+    QVERIFY(!ring.Push(__FILE__, __FUNCTION__, __LINE__, LOG_INFO, kMessage,
+                       QString(static_cast<int>(LogRing::kMaxMessage) + 1, 'x')));
+    QVERIFY(ring.Push(__FILE__, __FUNCTION__, __LINE__, LOG_ERR, kStandardIO,
+                      QString("\u00e9t\u00e9 \U0001F4FA")));
+
+    for (size_t i = 2; i < LogRing::kSize; i++)
+    {
+        item = ring.Pop();
+        QVERIFY(item != nullptr);
+        QCOMPARE(item->message(), QString("Message %1").arg(i));
+        item->DecrRef();
+    }
+    item = ring.Pop();
+    QVERIFY(item != nullptr);
+    QCOMPARE(item->message(), QString("\u00e9t\u00e9 \U0001F4FA"));
+    QCOMPARE(item->type(), static_cast<int>(kStandardIO));
+    item->DecrRef();
+    QVERIFY(ring.IsEmpty());
+    QVERIFY(ring.Pop() == nullptr);
+
+    // Messages claimed after an item was queued wait until it is handled
+    QVERIFY(ring.Push(__FILE__, __FUNCTION__, __LINE__, LOG_INFO, kMessage,
+                      "Before"));
+    size_t queued = ring.Head();
+    QVERIFY(ring.Push(__FILE__, __FUNCTION__, __LINE__, LOG_INFO, kMessage,
+                      "After"));
+    item = ring.Pop(queued);
+    QVERIFY(item != nullptr);
+    QCOMPARE(item->message(), QString("Before"));
+    item->DecrRef();
+    QVERIFY(ring.Pop(queued) == nullptr);
+    item = ring.Pop();
+    QVERIFY(item != nullptr);
+    QCOMPARE(item->message(), QString("After"));
+    item->DecrRef();
+    QVERIFY(ring.IsEmpty());
+}
+
+/// Threads log numbered messages, every seventh one and any the ring has
+/// no room for queued as a LoggingItem.  This thread takes them the way
+/// LoggerThread::run() does, and each thread's messages must come out in
+/// the order it logged them.
+void TestLogging::test_logOrder (void)
+{
+    static constexpr int kThreads  { 4 };
+    static constexpr int kMessages { 20000 };
+
+    LogRing ring;
+    QMutex queueMutex;
+    QQueue<std::pair<size_t,LoggingItem *>> queue;
+    std::atomic<int> running { kThreads };
+
+    auto produce = [&](int thread)
+    {
+        for (int i = 0; i < kMessages; i++)
+        {
+            QString message = QString::number(i);
+            if ((i % 7) != 0 &&
+                ring.Push(__FILE__, __FUNCTION__, thread, LOG_INFO, kMessage,
+                          message))
+            {
+                continue;
+            }
+            LoggingItem *item = LoggingItem::create(__FILE__, __FUNCTION__,
+                                                    thread, LOG_INFO,
+                                                    kMessage);
+            item->setMessage(message);
+            QMutexLocker locker(&queueMutex);
+            queue.enqueue({ring.Head(), item});
+        }
+        running--;
+    };
+
+    std::array<int,kThreads> next {};
+    int disordered = 0;
+    auto handle = [&](LoggingItem *item)
+    {
+        int thread = item->line();
+        int number = item->message().toInt();
+        if (number != next[thread])
+            disordered++;
+        next[thread] = number + 1;
+        item->DecrRef();
+    };
+
+    std::vector<std::thread> producers;
+    producers.reserve(kThreads);
+    for (int i = 0; i < kThreads; i++)
+        producers.emplace_back(produce, i);
+
+    QMutexLocker locker(&queueMutex);
+    while (running > 0 || !queue.isEmpty() || !ring.IsEmpty())
+    {
+        LoggingItem *item = nullptr;
+        size_t before = ring.Head();
+        if (!queue.isEmpty())
+            std::tie(before, item) = queue.dequeue();
+        locker.unlock();
+
+        while (LoggingItem *popped = ring.Pop(before))
+            handle(popped);
+        if (item)
+            handle(item);
+        else
+            std::this_thread::yield();
+
+        locker.relock();
+    }
+    locker.unlock();
+
+    for (auto & producer : producers)
+        producer.join();
+
+    QCOMPARE(disordered, 0);
+    for (int count : next)
+        QCOMPARE(count, kMessages);
+}
+
+void TestLogging::bench_logQueue_data (void)
+{
+    QTest::addColumn<bool>("ring");
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("queue 1 thread")  << false << 1;
+    QTest::newRow("queue 4 threads") << false << 4;
+    QTest::newRow("ring 1 thread")   << true  << 1;
+    QTest::newRow("ring 4 threads")  << true  << 4;
+}
+
+/// Compares the LOG() fast path, LogRing, with queueing a LoggingItem on a
+/// mutex protected queue, with threads logging as fast as they can and
+/// this thread taking messages like the logging thread.
+/// \return the mean time from logging a message to taking it, in ns
+static double run_logQueue(bool ring, int threads)
+{
+    static constexpr int kMessages { 50000 };
+    const QString message("Recorder 1: Changing from None to WatchingLiveTV");
+
+    LogRing logRing;
+    QMutex queueMutex;
+    QQueue<LoggingItem *> queue;
+
+    auto produce = [&]()
+    {
+        for (int i = 0; i < kMessages; i++)
+        {
+            if (ring)
+            {
+                while (!logRing.Push(__FILE__, __FUNCTION__, __LINE__,
+                                     LOG_INFO, kMessage, message))
+                    std::this_thread::yield();
+                continue;
+            }
+            LoggingItem *item = LoggingItem::create(__FILE__, __FUNCTION__,
+                                                    __LINE__, LOG_INFO,
+                                                    kMessage);
+            item->setMessage(message);
+            QMutexLocker locker(&queueMutex);
+            queue.enqueue(item);
+        }
+    };
+
+    auto take = [&]() -> LoggingItem *
+    {
+        if (ring)
+            return logRing.Pop();
+        QMutexLocker locker(&queueMutex);
+        return queue.isEmpty() ? nullptr : queue.dequeue();
+    };
+
+    std::vector<std::thread> producers;
+    producers.reserve(threads);
+    for (int i = 0; i < threads; i++)
+        producers.emplace_back(produce);
+
+    int total = 0;
+    std::chrono::microseconds latency { 0us };
+    while (total < kMessages * threads)
+    {
+        LoggingItem *item = take();
+        if (!item)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        latency += nowAsDuration<std::chrono::microseconds>() - item->epoch();
+        item->DecrRef();
+        total++;
+    }
+
+    for (auto & producer : producers)
+        producer.join();
+
+    return static_cast<double>(latency.count()) * 1000 / total;
+}
+
+void TestLogging::bench_logQueue (void)
+{
+    QFETCH(bool, ring);
+    QFETCH(int, threads);
+
+    QBENCHMARK_ONCE
+    {
+        run_logQueue(ring, threads);
+    }
+}
+
+void TestLogging::bench_logLatency_data (void)
+{
+    bench_logQueue_data();
+}
+
+/// Reports the mean time from logging a message to the logging thread
+/// taking it, see bench_logQueue()
+void TestLogging::bench_logLatency (void)
+{
+    QFETCH(bool, ring);
+    QFETCH(int, threads);
+
+    QTest::setBenchmarkResult(run_logQueue(ring, threads),
+                              QTest::WalltimeNanoseconds);
+}
+
 QTEST_APPLESS_MAIN(TestLogging)
@@ -19,8 +19,12 @@
  */
 
 #include <QtTest/QtTest>
+#include <array>
+#include <atomic>
 #include <iostream>
 #include <sstream>
+#include <thread>
+#include <tuple>
 
 #include "mythsyslog.h"
 #include "exitcodes.h"
@@ -48,4 +52,10 @@ private slots:
     static void test_verboseArgParse_level(void);
     static void test_logPropagateCalc_data(void);
     static void test_logPropagateCalc(void);
+    static void test_logRing(void);
+    static void test_logOrder(void);
+    static void bench_logQueue_data(void);
+    static void bench_logQueue(void);
+    static void bench_logLatency_data(void);
+    static void bench_logLatency(void);
 };
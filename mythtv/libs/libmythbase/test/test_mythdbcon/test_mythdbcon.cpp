@@ -75,6 +75,55 @@ void TestDbCon::test_escapeAsQuery(void)
     QCOMPARE(query, e_result);
 }
 
+void TestDbCon::test_profilerNormalize_data(void)
+{
+    QTest::addColumn<QString>("query");
+    QTest::addColumn<QString>("e_result");
+
+    QTest::newRow("bound")    << "SELECT title FROM recorded WHERE chanid = :CHANID"
+                              << "SELECT title FROM recorded WHERE chanid = :CHANID";
+    QTest::newRow("numbers")  << "SELECT title FROM recorded WHERE chanid = 1051 LIMIT 10"
+                              << "SELECT title FROM recorded WHERE chanid = ? LIMIT ?";
+    QTest::newRow("names")    << "SELECT t1.name_2 FROM t1 WHERE x = :Name_1"
+                              << "SELECT t1.name_2 FROM t1 WHERE x = :Name_1";
+    QTest::newRow("strings")  << "UPDATE settings SET data = 'it''s 1' WHERE value = \"Theme\""
+                              << "UPDATE settings SET data = ? WHERE value = ?";
+    QTest::newRow("escapes")  << "SELECT 1 FROM t WHERE a = 'x\\'y' AND b = 2.5"
+                              << "SELECT ? FROM t WHERE a = ? AND b = ?";
+    QTest::newRow("lists")    << "DELETE FROM t WHERE id IN (1, 2,3 ,4)"
+                              << "DELETE FROM t WHERE id IN (?,...)";
+    QTest::newRow("spaces")   << "SELECT a\n       FROM   t\n WHERE b = 'c'"
+                              << "SELECT a FROM t WHERE b = ?";
+}
+
+void TestDbCon::test_profilerNormalize(void)
+{
+    QFETCH(QString, query);
+    QFETCH(QString, e_result);
+
+    QCOMPARE(MSqlProfiler::Normalize(query), e_result);
+}
+
+void TestDbCon::test_profilerStats(void)
+{
+    MSqlProfiler::Reset();
+    MSqlProfiler::Record("SELECT a FROM t WHERE b = 1", 10us);
+    MSqlProfiler::Record("SELECT a FROM t WHERE b = 2", 30us);
+    MSqlProfiler::Record("SELECT c FROM t", 100us);
+
+    std::vector<MSqlProfiler::Stats> stats = MSqlProfiler::GetStats();
+    QCOMPARE(stats.size(), static_cast<size_t>(2));
+    QCOMPARE(stats[0].m_statement, QString("SELECT c FROM t"));
+    QCOMPARE(stats[0].m_count, 1ULL);
+    QCOMPARE(stats[1].m_statement, QString("SELECT a FROM t WHERE b = ?"));
+    QCOMPARE(stats[1].m_count, 2ULL);
+    QVERIFY(stats[1].m_total == 40us);
+    QVERIFY(stats[1].m_max == 30us);
+
+    MSqlProfiler::Reset();
+    QVERIFY(MSqlProfiler::GetStats().empty());
+}
+
 void TestDbCon::cleanupTestCase()
 {
 }
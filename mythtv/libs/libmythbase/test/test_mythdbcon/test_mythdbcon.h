@@ -30,5 +30,8 @@ private slots:
     static void initTestCase();
     static void test_escapeAsQuery_data(void);
     static void test_escapeAsQuery(void);
+    static void test_profilerNormalize_data(void);
+    static void test_profilerNormalize(void);
+    static void test_profilerStats(void);
     static void cleanupTestCase();
 };
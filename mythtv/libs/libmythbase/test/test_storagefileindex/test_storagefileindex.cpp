@@ -0,0 +1,128 @@
+/*
+ *  Class TestStorageFileIndex
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include "test_storagefileindex.h"
+
+#include <QTemporaryDir>
+
+#include "storagefileindex.h"
+
+static QTemporaryDir *s_dir = nullptr;
+
+static void write_file(const QString &name, int size)
+{
+    QFile file(s_dir->filePath(name));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QCOMPARE(file.write(QByteArray(size, 'x')), qint64(size));
+}
+
+void TestStorageFileIndex::initTestCase(void)
+{
+    s_dir = new QTemporaryDir();
+    QVERIFY(s_dir->isValid());
+    StorageFileIndex::Enable();
+    QVERIFY(StorageFileIndex::Instance());
+}
+
+void TestStorageFileIndex::cleanupTestCase(void)
+{
+    StorageFileIndex::Disable();
+    QVERIFY(!StorageFileIndex::Instance());
+    delete s_dir;
+    s_dir = nullptr;
+}
+
+void TestStorageFileIndex::found_test(void)
+{
+    StorageFileIndex *index = StorageFileIndex::Instance();
+    write_file("1001_20220101000000.ts", 1234);
+    QVERIFY(QDir(s_dir->path()).mkdir("sub"));
+
+    qint64 size = 0;
+    QDateTime listed;
+    QCOMPARE(index->Lookup(s_dir->path(), "1001_20220101000000.ts",
+                           &size, &listed),
+             StorageFileIndex::kFound);
+    QCOMPARE(size, 1234LL);
+    QVERIFY(listed.isValid());
+
+    // Same directory, spelled differently
+    QCOMPARE(index->Lookup(s_dir->path() + "/", "1001_20220101000000.ts"),
+             StorageFileIndex::kFound);
+    QCOMPARE(index->Lookup(s_dir->filePath("1001_20220101000000.ts")),
+             StorageFileIndex::kFound);
+
+    // Directories and files below them aren't indexed
+    QVERIFY(index->Lookup(s_dir->path(), "sub") !=
+            StorageFileIndex::kFound);
+    QCOMPARE(index->Lookup(s_dir->path(), "sub/file.ts"),
+             StorageFileIndex::kUnknown);
+    QCOMPARE(index->Lookup("relative.ts"), StorageFileIndex::kUnknown);
+}
+
+void TestStorageFileIndex::changed_test(void)
+{
+    StorageFileIndex *index = StorageFileIndex::Instance();
+    const QString name = "1002_20220101000000.ts";
+
+    // Misses are only trusted once the directory is watched
+    QTRY_COMPARE(index->Lookup(s_dir->path(), name),
+                 StorageFileIndex::kMissing);
+
+    write_file(name, 10);
+    QTRY_COMPARE(index->Lookup(s_dir->path(), name),
+                 StorageFileIndex::kFound);
+
+    QVERIFY(QFile::remove(s_dir->filePath(name)));
+    QTRY_COMPARE(index->Lookup(s_dir->path(), name),
+                 StorageFileIndex::kMissing);
+}
+
+void TestStorageFileIndex::helpers_test(void)
+{
+    const QString path = s_dir->filePath("1003_20220101000000.ts");
+    write_file("1003_20220101000000.ts", 100);
+    QTRY_VERIFY(StorageFileIndex::Exists(path));
+    QVERIFY(!StorageFileIndex::Exists(s_dir->filePath("none.ts")));
+
+    QDateTime past = QDateTime::currentDateTimeUtc().addSecs(-3600);
+    QCOMPARE(StorageFileIndex::Size(path, past), 100LL);
+    QCOMPARE(StorageFileIndex::Size(s_dir->filePath("none.ts"), past), -1LL);
+
+    // Still being written, so the size comes from the file itself
+    write_file("1003_20220101000000.ts", 200);
+    QDateTime future = QDateTime::currentDateTimeUtc().addSecs(3600);
+    QCOMPARE(StorageFileIndex::Size(path, future), 200LL);
+}
+
+void TestStorageFileIndex::new_file_test(void)
+{
+    StorageFileIndex *index = StorageFileIndex::Instance();
+    const QString name = "1004_20220101000000.ts";
+    const QString path = s_dir->filePath(name);
+    QTRY_COMPARE(index->Lookup(s_dir->path(), name),
+                 StorageFileIndex::kMissing);
+
+    // No events are processed, so the listing hasn't caught up yet
+    write_file(name, 300);
+    QVERIFY(StorageFileIndex::Exists(path));
+    QDateTime past = QDateTime::currentDateTimeUtc().addSecs(-3600);
+    QCOMPARE(StorageFileIndex::Size(path, past), 300LL);
+}
+
+QTEST_GUILESS_MAIN(TestStorageFileIndex)
@@ -0,0 +1,37 @@
+/*
+ *  Class TestStorageFileIndex
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <QtTest/QtTest>
+
+class TestStorageFileIndex : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    static void initTestCase(void);
+    static void cleanupTestCase(void);
+
+    /** files in a directory are found with their size */
+    static void found_test(void);
+    /** files added and removed after the listing are noticed */
+    static void changed_test(void);
+    /** Exists() and Size() answer from the index */
+    static void helpers_test(void);
+    /** files created before the change notification are still found */
+    static void new_file_test(void);
+};
@@ -0,0 +1,225 @@
+/*
+ *  Class TestThreadedFileWriter
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include "test_threadedfilewriter.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <vector>
+
+#include <fcntl.h>
+
+#include <QTemporaryDir>
+
+#include "mythcorecontext.h"
+#include "threadedfilewriter.h"
+
+static QTemporaryDir *s_dir = nullptr;
+
+// Data that differs at every offset, so misplaced blocks are noticed
+static QByteArray make_data(int size, int seed)
+{
+    QByteArray data(size, '\0');
+    for (int i = 0; i < size; i++)
+        data[i] = static_cast<char>((i * 7) + (i >> 12) + seed);
+    return data;
+}
+
+static QByteArray read_file(const QString &name)
+{
+    QFile file(name);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+    return file.readAll();
+}
+
+// Writes data in blocks of the given sizes, cycling through them
+static void write_blocks(ThreadedFileWriter &tfw, const QByteArray &data,
+                         const std::vector<int> &sizes)
+{
+    int pos = 0;
+    for (size_t i = 0; pos < data.size(); i++)
+    {
+        int len = std::min(sizes[i % sizes.size()], int(data.size()) - pos);
+        QCOMPARE(tfw.Write(data.constData() + pos, len), len);
+        pos += len;
+    }
+}
+
+static constexpr int kFlags { O_WRONLY | O_TRUNC | O_CREAT };
+static constexpr mode_t kMode { 0644 };
+
+class FailingWriter : public ThreadedFileWriter
+{
+  public:
+    FailingWriter(const QString &fname, int flags, mode_t mode)
+        : ThreadedFileWriter(fname, flags, mode)
+    {
+        s_failed = 0;
+        SetDirectWriteFunc(Fail);
+    }
+    // Fail like a file system that accepts O_DIRECT opens but not writes
+    static bool Fail(int /*fd*/, const char * /*data*/, uint /*count*/,
+                     off_t /*offset*/)
+    {
+        s_failed++;
+        errno = EINVAL;
+        return false;
+    }
+    static int s_failed;
+};
+int FailingWriter::s_failed {0};
+
+void TestThreadedFileWriter::initTestCase(void)
+{
+    gCoreContext = new MythCoreContext("test_threadedfilewriter_1.0", nullptr);
+
+    // Not in /tmp, which is often a tmpfs without O_DIRECT
+    s_dir = new QTemporaryDir(QDir::currentPath() + "/tfw-XXXXXX");
+    QVERIFY(s_dir->isValid());
+}
+
+void TestThreadedFileWriter::cleanupTestCase(void)
+{
+    delete s_dir;
+    s_dir = nullptr;
+    delete gCoreContext;
+    gCoreContext = nullptr;
+}
+
+void TestThreadedFileWriter::buffered_test(void)
+{
+    QString name = s_dir->filePath("buffered.ts");
+    QByteArray data = make_data((1024 * 1024) + 333, 1);
+    {
+        ThreadedFileWriter tfw(name, kFlags, kMode);
+        QVERIFY(tfw.Open());
+        write_blocks(tfw, data, {188, 7 * 188, 65536, 1});
+        tfw.Flush();
+        QCOMPARE(tfw.GetStats().m_directBytes, uint64_t(0));
+    }
+    QCOMPARE(read_file(name), data);
+}
+
+void TestThreadedFileWriter::direct_aligned_test(void)
+{
+    QString name = s_dir->filePath("aligned.ts");
+    QByteArray data = make_data(64 * 4096, 2);
+    uint64_t direct = 0;
+    {
+        ThreadedFileWriter tfw(name, kFlags, kMode);
+        tfw.SetDirectIO(true);
+        QVERIFY(tfw.Open());
+        write_blocks(tfw, data, {4096, 8 * 4096});
+        tfw.Flush();
+        direct = tfw.GetStats().m_directBytes;
+    }
+    QCOMPARE(read_file(name), data);
+    if (direct == 0)
+        QSKIP("O_DIRECT is not supported here");
+    QCOMPARE(direct, uint64_t(data.size()));
+}
+
+void TestThreadedFileWriter::direct_unaligned_test(void)
+{
+    QString name = s_dir->filePath("unaligned.ts");
+    QByteArray data = make_data((3 * 1024 * 1024) + 4095, 3);
+    uint64_t direct = 0;
+    {
+        ThreadedFileWriter tfw(name, kFlags, kMode);
+        tfw.SetDirectIO(true);
+        QVERIFY(tfw.Open());
+        write_blocks(tfw, data, {188, 1316, 4097, 65535, 3});
+        tfw.Flush();
+        direct = tfw.GetStats().m_directBytes;
+    }
+    QCOMPARE(read_file(name), data);
+    if (direct == 0)
+        QSKIP("O_DIRECT is not supported here");
+}
+
+void TestThreadedFileWriter::direct_tail_test(void)
+{
+    QString name = s_dir->filePath("tail.ts");
+    QByteArray data = make_data(10000, 4);
+    QByteArray more = make_data(5000, 5);
+
+    ThreadedFileWriter tfw(name, kFlags, kMode);
+    tfw.SetDirectIO(true);
+    QVERIFY(tfw.Open());
+
+    // The unaligned end is readable after each flush, and rewritten
+    // with O_DIRECT once the block it is in is complete.
+    QCOMPARE(tfw.Write(data.constData(), data.size()), int(data.size()));
+    tfw.Flush();
+    QCOMPARE(read_file(name), data);
+
+    QCOMPARE(tfw.Write(more.constData(), more.size()), int(more.size()));
+    tfw.Flush();
+    QCOMPARE(read_file(name), data + more);
+}
+
+void TestThreadedFileWriter::direct_seek_test(void)
+{
+    QString name = s_dir->filePath("seek.ts");
+    QByteArray data = make_data(10000, 6);
+    QByteArray patch("PATCH");
+    QByteArray more = make_data(20000, 7);
+    uint64_t direct = 0;
+    {
+        ThreadedFileWriter tfw(name, kFlags, kMode);
+        tfw.SetDirectIO(true);
+        QVERIFY(tfw.Open());
+        QCOMPARE(tfw.Write(data.constData(), data.size()), int(data.size()));
+
+        QCOMPARE(tfw.Seek(100, SEEK_SET), 100LL);
+        QCOMPARE(tfw.Write(patch.constData(), patch.size()), int(patch.size()));
+        QCOMPARE(tfw.Seek(0, SEEK_END), (long long)data.size());
+        direct = tfw.GetStats().m_directBytes;
+
+        // Everything after the seek goes through the page cache
+        QCOMPARE(tfw.Write(more.constData(), more.size()), int(more.size()));
+        tfw.Flush();
+        QCOMPARE(tfw.GetStats().m_directBytes, direct);
+    }
+
+    QByteArray expected = data + more;
+    expected.replace(100, patch.size(), patch);
+    QCOMPARE(read_file(name), expected);
+}
+
+void TestThreadedFileWriter::direct_einval_test(void)
+{
+    QString name = s_dir->filePath("einval.ts");
+    QByteArray data = make_data((2 * 1024 * 1024) + 1234, 8);
+    {
+        FailingWriter tfw(name, kFlags, kMode);
+        tfw.SetDirectIO(true);
+        QVERIFY(tfw.Open());
+        write_blocks(tfw, data, {1316, 5000, 65536});
+        tfw.Flush();
+    }
+    int failed = FailingWriter::s_failed;
+    QCOMPARE(read_file(name), data);
+    if (failed == 0)
+        QSKIP("O_DIRECT is not supported here");
+    // Only the first O_DIRECT write is tried
+    QCOMPARE(failed, 1);
+}
+
+QTEST_APPLESS_MAIN(TestThreadedFileWriter)
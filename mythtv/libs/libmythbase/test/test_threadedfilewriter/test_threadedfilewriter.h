@@ -0,0 +1,42 @@
+/*
+ *  Class TestThreadedFileWriter
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <QtTest/QtTest>
+
+class TestThreadedFileWriter : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    static void initTestCase(void);
+    static void cleanupTestCase(void);
+
+    /** buffered writes of blocks of any size */
+    static void buffered_test(void);
+    /** O_DIRECT writes of whole blocks */
+    static void direct_aligned_test(void);
+    /** O_DIRECT writes of odd sizes, the tail is written at the end */
+    static void direct_unaligned_test(void);
+    /** Flush() makes the unaligned tail visible to readers */
+    static void direct_tail_test(void);
+    /** Seek() switches back to buffered writes */
+    static void direct_seek_test(void);
+    /** an O_DIRECT write failing with EINVAL falls back to buffered
+     *  writes without losing data */
+    static void direct_einval_test(void);
+};
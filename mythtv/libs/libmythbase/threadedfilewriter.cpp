@@ -1,4 +1,5 @@
 // C++ headers
+#include <algorithm>
 #include <cerrno>
 #include <csignal>
 #include <cstdio>
@@ -42,6 +43,7 @@ void TFWSyncThread::run(void)
 const uint ThreadedFileWriter::kMaxBufferSize   = 8 * 1024 * 1024;
 const uint ThreadedFileWriter::kMinWriteSize    = 64 * 1024;
 const uint ThreadedFileWriter::kMaxBlockSize    = 1 * 1024 * 1024;
+const uint ThreadedFileWriter::kDirectAlign     = 4096;
 
 /** \class ThreadedFileWriter
  *  \brief This class supports the writing of recordings to disk.
@@ -66,6 +68,8 @@ bool ThreadedFileWriter::ReOpen(const QString& newFilename)
 
     m_bufLock.lock();
 
+    CloseDirect();
+
     if (m_fd >= 0)
     {
         close(m_fd);
@@ -111,6 +115,9 @@ bool ThreadedFileWriter::Open(void)
     gCoreContext->RegisterFileForWrite(m_filename);
     m_registered = true;
 
+    if (m_directIO)
+        OpenDirect();
+
     LOG(VB_FILE, LOG_INFO, LOC + "Open() successful");
 
 #ifdef _WIN32
@@ -171,6 +178,10 @@ ThreadedFileWriter::~ThreadedFileWriter()
         m_syncThread = nullptr;
     }
 
+    CloseDirect();
+    free(m_directBuf);
+    m_directBuf = nullptr;
+
     if (m_fd >= 0)
     {
         close(m_fd);
@@ -179,6 +190,17 @@ ThreadedFileWriter::~ThreadedFileWriter()
 
     gCoreContext->UnregisterFileForWrite(m_filename);
     m_registered = false;
+
+    TFWStats stats = GetStats();
+    if (stats.m_writes)
+    {
+        LOG(VB_FILE, LOG_INFO, LOC +
+            QString("Wrote %1 bytes (%2 direct) in %3 writes, "
+                    "avg %4 us, max %5 us per write")
+            .arg(stats.m_bytes).arg(stats.m_directBytes).arg(stats.m_writes)
+            .arg(stats.m_writeTime.count() / stats.m_writes)
+            .arg(stats.m_maxWrite.count()));
+    }
 }
 
 /** \fn ThreadedFileWriter::Write(const void*, uint)
@@ -298,7 +320,7 @@ long long ThreadedFileWriter::Seek(long long pos, int whence)
 {
     QMutexLocker locker(&m_bufLock);
     m_flush = true;
-    while (!m_writeBuffers.empty())
+    while (!m_writeBuffers.empty() || m_directTailDirty)
     {
         m_bufferHasData.wakeAll();
         if (!m_bufferEmpty.wait(locker.mutex(), 2000))
@@ -309,6 +331,15 @@ long long ThreadedFileWriter::Seek(long long pos, int whence)
         }
     }
     m_flush = false;
+
+    // Positioned writes are not aligned, so stop using O_DIRECT and
+    // continue through the page cache from where the data ends.
+    if (m_directFd >= 0)
+    {
+        lseek(m_fd, m_directOffset + m_directUsed, SEEK_SET);
+        CloseDirect();
+    }
+
     return lseek(m_fd, pos, whence);
 }
 
@@ -319,7 +350,7 @@ void ThreadedFileWriter::Flush(void)
 {
     QMutexLocker locker(&m_bufLock);
     m_flush = true;
-    while (!m_writeBuffers.empty())
+    while (!m_writeBuffers.empty() || m_directTailDirty)
     {
         m_bufferHasData.wakeAll();
         if (!m_bufferEmpty.wait(locker.mutex(), 2000))
@@ -446,6 +477,8 @@ void ThreadedFileWriter::DiskLoop(void)
 
         if (m_writeBuffers.empty())
         {
+            if (m_flush && m_directTailDirty)
+                WriteDirectTail();
             m_bufferEmpty.wakeAll();
             m_bufferHasData.wait(locker.mutex(), 1000);
             TrimEmptyBuffers();
@@ -472,6 +505,8 @@ void ThreadedFileWriter::DiskLoop(void)
         m_totalBufferUse -= buf->data.size();
         m_bufferWasFreed.wakeAll();
         minWriteTimer.start();
+        if (m_directFd >= 0)
+            m_directTailDirty = true;
 
         //////////////////////////////////////////
 
@@ -489,7 +524,21 @@ void ThreadedFileWriter::DiskLoop(void)
         MythTimer writeTimer;
         writeTimer.start();
 
-        while ((tot < sz) && !m_inDtor)
+        if (m_directFd >= 0)
+        {
+            locker.unlock();
+            write_ok = WriteDirect((const char *)data, sz);
+            locker.relock();
+            m_directTailDirty = (m_directUsed > 0);
+            if (write_ok)
+            {
+                tot = sz;
+                total_written += sz;
+                m_stats.m_directBytes += sz;
+            }
+        }
+
+        while (write_ok && (tot < sz) && !m_inDtor)
         {
             locker.unlock();
 
@@ -532,6 +581,13 @@ void ThreadedFileWriter::DiskLoop(void)
 
         //////////////////////////////////////////
 
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>
+            (writeTimer.nsecsElapsed());
+        m_stats.m_bytes += tot;
+        m_stats.m_writes++;
+        m_stats.m_writeTime += elapsed;
+        m_stats.m_maxWrite = std::max(m_stats.m_maxWrite, elapsed);
+
         if (lastRegisterTimer.elapsed() >= 10s)
         {
             gCoreContext->RegisterFileForWrite(m_filename, total_written);
@@ -616,3 +672,160 @@ bool ThreadedFileWriter::SetBlocking(bool block)
     m_blocking = block;
     return old;
 }
+
+/**
+ *  \brief Write the file with O_DIRECT, bypassing the page cache.
+ *
+ *  This must be called before Open(). Data is gathered in an aligned
+ *  buffer and written in multiples of kDirectAlign, so many concurrent
+ *  recordings do not fill the page cache with data nobody will read
+ *  back soon. The unaligned tail is written through the page cache
+ *  when the file is flushed. If the file system does not support
+ *  O_DIRECT, normal writes are used.
+ */
+void ThreadedFileWriter::SetDirectIO(bool direct)
+{
+    m_directIO = direct;
+}
+
+ThreadedFileWriter::TFWStats ThreadedFileWriter::GetStats(void) const
+{
+    QMutexLocker locker(&m_bufLock);
+    return m_stats;
+}
+
+bool ThreadedFileWriter::OpenDirect(void)
+{
+#ifdef O_DIRECT
+    if (m_filename == "-" || (m_flags & O_APPEND))
+        return false;
+
+    if (!m_directBuf)
+    {
+        void *buf = nullptr;
+        if (posix_memalign(&buf, kDirectAlign, kMaxBlockSize + kDirectAlign) != 0)
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC + "Failed to allocate O_DIRECT buffer");
+            return false;
+        }
+        m_directBuf = static_cast<char*>(buf);
+    }
+
+    QByteArray fname = m_filename.toLocal8Bit();
+    int flags = (m_flags & ~(O_CREAT | O_TRUNC)) | O_DIRECT;
+    m_directFd = open(fname.constData(), flags);
+    if (m_directFd < 0)
+    {
+        LOG(VB_FILE, LOG_INFO, LOC +
+            "O_DIRECT not available, using buffered writes" + ENO);
+        return false;
+    }
+
+    m_directOffset = lseek(m_fd, 0, SEEK_CUR);
+    m_directUsed = 0;
+    if (m_directOffset < 0 || (m_directOffset % kDirectAlign) != 0)
+    {
+        CloseDirect();
+        return false;
+    }
+
+    LOG(VB_FILE, LOG_INFO, LOC + "Using O_DIRECT writes");
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ThreadedFileWriter::CloseDirect(void)
+{
+    if (m_directFd >= 0)
+    {
+        close(m_directFd);
+        m_directFd = -1;
+    }
+    m_directUsed = 0;
+    m_directTailDirty = false;
+}
+
+static bool pwrite_all(int fd, const char *data, uint count, off_t offset)
+{
+    while (count > 0)
+    {
+        ssize_t ret = pwrite(fd, data, count, offset);
+        if (ret < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        data   += ret;
+        count  -= ret;
+        offset += ret;
+    }
+    return true;
+}
+
+/** \fn ThreadedFileWriter::WriteDirect(const char*,uint)
+ *  \brief Appends data to the aligned buffer and writes out all
+ *         complete kDirectAlign blocks with O_DIRECT.
+ *
+ *  Only called from DiskLoop() without the buffer lock held.
+ */
+bool ThreadedFileWriter::WriteDirect(const char *data, uint count)
+{
+    const uint capacity = kMaxBlockSize + kDirectAlign;
+    while (count > 0)
+    {
+        uint chunk = std::min(count, capacity - m_directUsed);
+        memcpy(m_directBuf + m_directUsed, data, chunk);
+        m_directUsed += chunk;
+        data  += chunk;
+        count -= chunk;
+
+        uint aligned = m_directUsed - (m_directUsed % kDirectAlign);
+        if (!aligned)
+            continue;
+
+        bool written = m_directWrite
+            ? m_directWrite(m_directFd, m_directBuf, aligned, m_directOffset)
+            : pwrite_all(m_directFd, m_directBuf, aligned, m_directOffset);
+        if (!written)
+        {
+            if (errno != EINVAL)
+                return false;
+
+            // The file system accepted the open but not the write,
+            // fall back to normal writes for the rest of the file.
+            LOG(VB_GENERAL, LOG_WARNING, LOC +
+                "O_DIRECT write failed, using buffered writes" + ENO);
+            off_t end = m_directOffset + m_directUsed;
+            bool ok = pwrite_all(m_fd, m_directBuf, m_directUsed, m_directOffset) &&
+                      pwrite_all(m_fd, data, count, end);
+            lseek(m_fd, end + count, SEEK_SET);
+            close(m_directFd);
+            m_directFd = -1;
+            m_directUsed = 0;
+            return ok;
+        }
+
+        m_directOffset += aligned;
+        m_directUsed   -= aligned;
+        memmove(m_directBuf, m_directBuf + aligned, m_directUsed);
+    }
+    return true;
+}
+
+/** \fn ThreadedFileWriter::WriteDirectTail(void)
+ *  \brief Writes the unaligned end of the file through the page cache
+ *         so that it is visible to readers. It is written again with
+ *         O_DIRECT once the block it is in is complete.
+ */
+void ThreadedFileWriter::WriteDirectTail(void)
+{
+    if (m_directFd >= 0 && m_directUsed > 0 &&
+        !pwrite_all(m_fd, m_directBuf, m_directUsed, m_directOffset))
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "Failed to write end of file" + ENO);
+    }
+    m_directTailDirty = false;
+}
@@ -2,6 +2,7 @@
 #ifndef TFW_H_
 #define TFW_H_
 
+#include <chrono>
 #include <cstdint>
 #include <fcntl.h>
 #include <utility>
@@ -63,11 +64,33 @@ class MBASE_PUBLIC ThreadedFileWriter
     void Flush(void);
     bool SetBlocking(bool block = true);
     bool WritesFailing(void) const { return m_ignoreWrites; }
+    void SetDirectIO(bool direct);
+
+    /// Throughput and latency of the writes to disk
+    class TFWStats
+    {
+      public:
+        uint64_t                  m_bytes       {0};
+        uint64_t                  m_writes      {0};
+        uint64_t                  m_directBytes {0};
+        std::chrono::microseconds m_writeTime   {0};
+        std::chrono::microseconds m_maxWrite    {0};
+    };
+    TFWStats GetStats(void) const;
 
   protected:
     void DiskLoop(void);
     void SyncLoop(void);
     void TrimEmptyBuffers(void);
+    bool OpenDirect(void);
+    void CloseDirect(void);
+    bool WriteDirect(const char *data, uint count);
+    void WriteDirectTail(void);
+
+    /// Writes all of count bytes at offset to fd
+    using WriteFunc = bool (*)(int fd, const char *data, uint count, off_t offset);
+    /// Replaces the O_DIRECT writes of whole blocks, for testing
+    void SetDirectWriteFunc(WriteFunc func) { m_directWrite = func; }
 
   private:
     // file info
@@ -76,12 +99,22 @@ class MBASE_PUBLIC ThreadedFileWriter
     mode_t          m_mode;
     int             m_fd                 {-1};
 
+    // O_DIRECT writes, see SetDirectIO()
+    bool            m_directIO           {false};
+    int             m_directFd           {-1};
+    char           *m_directBuf          {nullptr}; // aligned staging buffer
+    uint            m_directUsed         {0};    // bytes in m_directBuf
+    bool            m_directTailDirty    {false}; // protected by buflock
+    off_t           m_directOffset       {0};    // file offset of m_directBuf
+    WriteFunc       m_directWrite        {nullptr}; // pwrite_all() when null
+
     // state
     bool            m_flush              {false};         // protected by buflock
     bool            m_inDtor             {false};         // protected by buflock
     bool            m_ignoreWrites       {false};         // protected by buflock
     uint            m_tfwMinWriteSize    {kMinWriteSize}; // protected by buflock
     uint            m_totalBufferUse     {0};             // protected by buflock
+    TFWStats        m_stats;                              // protected by buflock
 
     // buffers
     class TFWBuffer
@@ -110,6 +143,8 @@ class MBASE_PUBLIC ThreadedFileWriter
     static const uint kMinWriteSize;
     /// Maximum block size to write at a time
     static const uint kMaxBlockSize;
+    /// File offset and length alignment needed by O_DIRECT writes
+    static const uint kDirectAlign;
 
     bool m_warned                        {false};
     bool m_blocking                      {false};
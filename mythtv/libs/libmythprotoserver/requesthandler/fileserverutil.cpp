@@ -15,6 +15,7 @@
 
 #include "requesthandler/fileserverutil.h"
 #include "programinfo.h"
+#include "storagefileindex.h"
 
 DeleteHandler::DeleteHandler(void) :
     ReferenceCounter("DeleteHandler")
@@ -49,7 +50,7 @@ QString GetPlaybackURL(ProgramInfo *pginfo, bool storePath)
     QString cacheKey = QString("%1:%2").arg(pginfo->GetChanID())
         .arg(pginfo->GetRecordingStartTime(MythDate::ISODate));
     if ((recordingPathCache.contains(cacheKey)) &&
-        (QFile::exists(recordingPathCache[cacheKey])))
+        (StorageFileIndex::Exists(recordingPathCache[cacheKey])))
     {
         result = recordingPathCache[cacheKey];
         if (!storePath)
@@ -370,11 +370,7 @@ AvFormatDecoder::AvFormatDecoder(MythPlayer *parent,
 AvFormatDecoder::~AvFormatDecoder()
 {
     while (!m_storedPackets.isEmpty())
-    {
-        AVPacket *pkt = m_storedPackets.takeFirst();
-        av_packet_unref(pkt);
-        delete pkt;
-    }
+        m_packetPool.Put(m_storedPackets.takeFirst());
 
     CloseContext();
     delete m_ccd608;
@@ -756,11 +752,7 @@ void AvFormatDecoder::SeekReset(long long newKey, uint skipFrames,
 
         // Free up the stored up packets
         while (!m_storedPackets.isEmpty())
-        {
-            AVPacket *pkt = m_storedPackets.takeFirst();
-            av_packet_unref(pkt);
-            delete pkt;
-        }
+            m_packetPool.Put(m_storedPackets.takeFirst());
 
         m_prevGopPos = 0;
         m_gopSet = false;
@@ -3571,9 +3563,11 @@ bool AvFormatDecoder::ProcessVideoPacket(AVStream *curstream, AVPacket *pkt, boo
     {
         // MythTV logic expects that only one frame is processed
         // Save the packet for later and return.
-        auto *newPkt = av_packet_clone(pkt);
-        if (newPkt)
+        AVPacket *newPkt = m_packetPool.Get();
+        if (newPkt && av_packet_ref(newPkt, pkt) == 0)
             m_storedPackets.prepend(newPkt);
+        else
+            m_packetPool.Put(newPkt);
     }
     return true;
 }
@@ -4634,7 +4628,7 @@ bool AvFormatDecoder::ProcessAudioPacket(AVStream *curstream, AVPacket *pkt,
     int audSubIdx = m_selectedTrack[kTrackTypeAudio].m_av_substream_index;
     m_trackLock.unlock();
 
-    AVPacket *tmp_pkt = av_packet_alloc();
+    AVPacket *tmp_pkt = m_packetPool.Get();
     tmp_pkt->data = pkt->data;
     tmp_pkt->size = pkt->size;
     while (tmp_pkt->size > 0)
@@ -4790,7 +4784,7 @@ bool AvFormatDecoder::ProcessAudioPacket(AVStream *curstream, AVPacket *pkt,
         if (ret < 0)
         {
             LOG(VB_GENERAL, LOG_ERR, LOC + "Unknown audio decoding error");
-            av_packet_free(&tmp_pkt);
+            m_packetPool.Put(tmp_pkt);
             return false;
         }
 
@@ -4832,7 +4826,7 @@ bool AvFormatDecoder::ProcessAudioPacket(AVStream *curstream, AVPacket *pkt,
         firstloop = false;
     }
 
-    av_packet_free(&tmp_pkt);
+    m_packetPool.Put(tmp_pkt);
     return true;
 }
 
@@ -4937,14 +4931,13 @@ bool AvFormatDecoder::GetFrame(DecodeType decodetype, bool &Retry)
 
         if (!storevideoframes && m_storedPackets.count() > 0)
         {
-            if (pkt)
-                av_packet_free(&pkt);
+            m_packetPool.Put(pkt);
             pkt = m_storedPackets.takeFirst();
         }
         else
         {
             if (!pkt)
-                pkt = av_packet_alloc();
+                pkt = m_packetPool.Get();
 
             int retval = 0;
             if (!m_ic || ((retval = ReadPacket(m_ic, pkt, storevideoframes)) < 0))
@@ -4953,7 +4946,7 @@ bool AvFormatDecoder::GetFrame(DecodeType decodetype, bool &Retry)
                     continue;
 
                 SetEof(true);
-                av_packet_free(&pkt);
+                m_packetPool.Put(pkt);
                 std::string errbuf(256,'\0');
                 QString errmsg;
                 if (av_strerror_stdstring(retval, errbuf) == 0)
@@ -5016,7 +5009,7 @@ bool AvFormatDecoder::GetFrame(DecodeType decodetype, bool &Retry)
             // have a fatal error, so check for this before continuing.
             if (m_parent->IsErrored())
             {
-                av_packet_free(&pkt);
+                m_packetPool.Put(pkt);
                 return false;
             }
         }
@@ -5126,7 +5119,7 @@ bool AvFormatDecoder::GetFrame(DecodeType decodetype, bool &Retry)
             break;
     }
 
-    av_packet_free(&pkt);
+    m_packetPool.Put(pkt);
     return true;
 }
 
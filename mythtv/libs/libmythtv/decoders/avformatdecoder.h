@@ -135,6 +135,8 @@ class AvFormatDecoder : public DecoderBase
 
     QString      GetCodecDecoderName(void) const override; // DecoderBase
     QString      GetRawEncodingType(void) override; // DecoderBase
+    int          GetPacketAllocationRate(void) const override // DecoderBase
+        { return m_packetPool.GetAllocationRate(); }
     MythCodecID  GetVideoCodecID(void) const override { return m_videoCodecId; } // DecoderBase
 
     void SetDisablePassThrough(bool disable) override; // DecoderBase
@@ -281,6 +283,7 @@ class AvFormatDecoder : public DecoderBase
     /// A counter used to determine if we need to force a call to HandleGopStart
     int                m_seqCount                     {0};
 
+    MythAVPacketPool   m_packetPool;
     QList<AVPacket*>   m_storedPackets;
 
     int                m_prevGopPos                   {0};
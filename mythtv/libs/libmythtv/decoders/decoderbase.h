@@ -206,6 +206,8 @@ class DecoderBase
 
     virtual QString GetCodecDecoderName(void) const = 0;
     virtual QString GetRawEncodingType(void) { return QString(); }
+    /// Returns how many packets the decoder allocated in the last second
+    virtual int GetPacketAllocationRate(void) const { return 0; }
     virtual MythCodecID GetVideoCodecID(void) const = 0;
 
     virtual void ResetPosMap(void);
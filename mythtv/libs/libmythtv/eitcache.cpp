@@ -5,6 +5,8 @@
  * License: GPL v2
  */
 
+#include <algorithm>
+
 #include <QDateTime>
 
 #include "eitcache.h"
@@ -57,7 +59,10 @@ QString EITCache::GetStatistics(void) const
         QString("Pruned:%1 ").arg(m_pruneCnt) +
         QString("PrunedHits:%1 ").arg(m_prunedHitCnt) +
         QString("Future:%1 ").arg(m_futureHitCnt) +
-        QString("WrongChannel:%1").arg(m_wrongChannelHitCnt);
+        QString("WrongChannel:%1 ").arg(m_wrongChannelHitCnt) +
+        QString("Entries:%1 ").arg(m_events.size()) +
+        QString("Bytes/Entry:%1")
+            .arg(m_events.MemoryUsage() / std::max<double>(m_events.size(), 1), 0, 'f', 1);
 }
 
 /*
@@ -205,10 +210,10 @@ static void unlock_channel(uint chanid, uint updated)
 }
 
 
-event_map_t * EITCache::LoadChannel(uint chanid)
+bool EITCache::LoadChannel(uint chanid)
 {
     if (!lock_channel(chanid, m_lastPruneTime))
-        return nullptr;
+        return false;
 
     MSqlQuery query(MSqlQuery::InitCon());
 
@@ -227,11 +232,14 @@ event_map_t * EITCache::LoadChannel(uint chanid)
     if (!query.exec() || !query.isActive())
     {
         MythDB::DBError("Error loading eitcache", query);
-        return nullptr;
+        return false;
     }
+    m_lockedChannels.push_back(chanid);
 
-    auto *eventMap = new event_map_t();
+    if (query.size() > 0)
+        m_events.Reserve(m_events.size() + query.size());
 
+    uint loaded = 0;
     while (query.next())
     {
         uint eventid = query.value(0).toUInt();
@@ -239,80 +247,80 @@ event_map_t * EITCache::LoadChannel(uint chanid)
         uint version = query.value(2).toUInt();
         uint endtime = query.value(3).toUInt();
 
-        (*eventMap)[eventid] = construct_sig(tableid, version, endtime, false);
+        m_events.Insert(chanid, eventid,
+                        construct_sig(tableid, version, endtime, false));
+        loaded++;
     }
 
-    if (!eventMap->empty())
+    if (loaded)
         LOG(VB_EIT, LOG_INFO, LOC + QString("Loaded %1 entries for channel %2")
-                .arg(eventMap->size()).arg(chanid));
+                .arg(loaded).arg(chanid));
 
-    m_entryCnt += eventMap->size();
-    return eventMap;
+    m_entryCnt += loaded;
+    return true;
 }
 
-bool EITCache::WriteChannelToDB(QStringList &value_clauses, uint chanid)
+/** \fn EITCache::WriteToDB(void)
+ *  \brief Writes the events modified since the last call to the database.
+ *
+ *  Only the channels with modified events, or loaded since the last
+ *  call, are touched.
+ */
+void EITCache::WriteToDB(void)
 {
-    event_map_t * eventMap = m_channelMap[chanid];
-
-    if (!eventMap)
-        return false;
-
-    uint size    = eventMap->size();
-    uint updated = 0;
-    uint removed = 0;
+    QMutexLocker locker(&m_eventMapLock);
 
-    event_map_t::iterator it = eventMap->begin();
-    while (it != eventMap->end())
+    // Forget the channels which were locked, they are tried again later
+    for (auto it = m_channels.begin(); it != m_channels.end(); )
     {
-        if (extract_endtime(*it) > m_lastPruneTime)
-        {
-            if (modified(*it))
-            {
-                replace_in_db(value_clauses, chanid, it.key(), *it);
-                updated++;
-                *it &= ~(uint64_t)0 >> 1; // mark as synced
-            }
-            ++it;
-        }
+        if (!*it)
+            it = m_channels.erase(it);
         else
-        {
-            // Event is too old; remove from eit cache in memory
-            it = eventMap->erase(it);
-            removed++;
-        }
-    }
-    unlock_channel(chanid, updated);
-
-    if (updated)
-    {
-        LOG(VB_EIT, LOG_INFO, LOC + QString("Writing %1 modified entries of %2 "
-                                      "for channel %3 to database.")
-                .arg(updated).arg(size).arg(chanid));
-    }
-    if (removed)
-    {
-        LOG(VB_EIT, LOG_INFO, LOC + QString("Removed %1 old entries of %2 "
-                                      "for channel %3 from cache.")
-                .arg(removed).arg(size).arg(chanid));
+            ++it;
     }
-    m_pruneCnt += removed;
 
-    return true;
-}
+    if (m_dirty.empty() && m_lockedChannels.empty())
+        return;
 
-void EITCache::WriteToDB(void)
-{
-    QMutexLocker locker(&m_eventMapLock);
+    // Group the modified events by channel
+    std::sort(m_dirty.begin(), m_dirty.end());
 
     QStringList value_clauses;
-    key_map_t::iterator it = m_channelMap.begin();
-    while (it != m_channelMap.end())
+    auto next = m_dirty.cbegin();
+    while (next != m_dirty.cend())
     {
-        if (!WriteChannelToDB(value_clauses, it.key()))
-            it = m_channelMap.erase(it);
-        else
-            ++it;
+        uint chanid  = *next >> 32;
+        uint updated = 0;
+        for (; next != m_dirty.cend() && (*next >> 32) == chanid; ++next)
+        {
+            uint eventid = *next & 0xffffffff;
+            uint64_t *sig = m_events.Find(chanid, eventid);
+            if (!sig || !modified(*sig) ||
+                extract_endtime(*sig) <= m_lastPruneTime)
+                continue;
+            replace_in_db(value_clauses, chanid, eventid, *sig);
+            updated++;
+            *sig &= ~(uint64_t)0 >> 1; // mark as synced
+        }
+
+        unlock_channel(chanid, updated);
+        m_lockedChannels.erase(
+            std::remove(m_lockedChannels.begin(), m_lockedChannels.end(), chanid),
+            m_lockedChannels.end());
+
+        if (updated)
+        {
+            LOG(VB_EIT, LOG_INFO, LOC + QString("Writing %1 modified entries "
+                                          "for channel %2 to database.")
+                    .arg(updated).arg(chanid));
+        }
     }
+    m_dirty.clear();
+
+    // Channels loaded since the last write without any changes
+    for (uint chanid : m_lockedChannels)
+        unlock_channel(chanid, 0);
+    m_lockedChannels.clear();
 
     if(value_clauses.isEmpty())
     {
@@ -357,33 +365,31 @@ bool EITCache::IsNewEIT(uint chanid,  uint tableid,   uint version,
     }
 
     QMutexLocker locker(&m_eventMapLock);
-    if (!m_channelMap.contains(chanid))
-    {
-        m_channelMap[chanid] = LoadChannel(chanid);
-    }
+    auto chan = m_channels.constFind(chanid);
+    if (chan == m_channels.constEnd())
+        chan = m_channels.insert(chanid, LoadChannel(chanid));
 
-    if (!m_channelMap[chanid])
+    if (!*chan)
     {
         m_wrongChannelHitCnt++;
         return false;
     }
 
-    event_map_t * eventMap = m_channelMap[chanid];
-    event_map_t::iterator it = eventMap->find(eventid);
-    if (it != eventMap->end())
+    uint64_t *sig = m_events.Find(chanid, eventid);
+    if (sig)
     {
-        if (extract_table_id(*it) > tableid)
+        if (extract_table_id(*sig) > tableid)
         {
             // EIT from lower (ie. better) table number
             m_tblChgCnt++;
         }
-        else if ((extract_table_id(*it) == tableid) &&
-                 (extract_version(*it) != version))
+        else if ((extract_table_id(*sig) == tableid) &&
+                 (extract_version(*sig) != version))
         {
             // EIT updated version on current table
             m_verChgCnt++;
         }
-        else if (extract_endtime(*it) != endtime)
+        else if (extract_endtime(*sig) != endtime)
         {
             // Endtime (starttime + duration) changed
             m_endChgCnt++;
@@ -394,9 +400,17 @@ bool EITCache::IsNewEIT(uint chanid,  uint tableid,   uint version,
             m_hitCnt++;
             return false;
         }
-    }
 
-    eventMap->insert(eventid, construct_sig(tableid, version, endtime, true));
+        if (!modified(*sig))
+            m_dirty.push_back((static_cast<uint64_t>(chanid) << 32) | eventid);
+        *sig = construct_sig(tableid, version, endtime, true);
+    }
+    else
+    {
+        m_dirty.push_back((static_cast<uint64_t>(chanid) << 32) | eventid);
+        m_events.Insert(chanid, eventid,
+                        construct_sig(tableid, version, endtime, true));
+    }
     m_entryCnt++;
 
     return true;
@@ -418,13 +432,30 @@ uint EITCache::PruneOldEntries(uint timestamp)
 
     m_lastPruneTime  = timestamp;
 
-    // Write all modified entries to DB and start with a clean cache
+    // Write all modified entries to DB before they are dropped
     WriteToDB();
 
+    // Drop the events that are too old from the cache in memory,
+    // in one pass over the table
+    m_eventMapLock.lock();
+    size_t before = m_events.size();
+    size_t removed = m_events.RemoveIf(
+        [timestamp](uint /*chanid*/, uint64_t sig)
+        { return extract_endtime(sig) <= timestamp; });
+    m_pruneCnt += removed;
+    m_eventMapLock.unlock();
+
+    if (removed)
+    {
+        LOG(VB_EIT, LOG_INFO, LOC + QString("Removed %1 old entries of %2 "
+                                      "from cache.")
+                .arg(removed).arg(before));
+    }
+
     // Prune old entries in the DB
     delete_in_db(timestamp);
 
-    return 0;
+    return removed;
 }
 
 
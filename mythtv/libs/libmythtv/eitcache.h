@@ -7,20 +7,158 @@
 #define EIT_CACHE_H
 
 #include <cstdint>
+#include <vector>
 
 // Qt headers
 #include <QString>
 #include <QMutex>
-#include <QMap>
+#include <QHash>
 
 // MythTV headers
 #include "mythtvexp.h"
 
-using event_map_t = QMap<uint, uint64_t>;
-using key_map_t = QMap<uint, event_map_t*>;
+/** \brief Hash table of EIT event signatures keyed by channel and event id.
+ *
+ *  The entries live in one flat array and collisions are resolved by
+ *  linear probing, so a lookup usually touches a single cache line and
+ *  an entry costs 16 bytes plus the free slots.
+ */
+class MTV_PUBLIC EITCacheTable
+{
+  public:
+    explicit EITCacheTable(size_t capacity = kMinCapacity)
+    {
+        Allocate(capacity);
+    }
+
+    /// Returns the signature of the event, or nullptr if it is not cached.
+    uint64_t *Find(uint chanid, uint eventid)
+    {
+        uint64_t key = MakeKey(chanid, eventid);
+        for (size_t i = Slot(key); ; i = (i + 1) & m_mask)
+        {
+            if (m_entries[i].m_key == key)
+                return &m_entries[i].m_sig;
+            if (m_entries[i].m_key == kEmpty)
+                return nullptr;
+        }
+    }
+
+    /// Adds the event, or replaces its signature.
+    void Insert(uint chanid, uint eventid, uint64_t sig)
+    {
+        if ((m_size + 1) * 10 > m_entries.size() * 7)
+            Allocate(m_entries.size() * 2);
+
+        uint64_t key = MakeKey(chanid, eventid);
+        size_t i = Slot(key);
+        while (m_entries[i].m_key != kEmpty && m_entries[i].m_key != key)
+            i = (i + 1) & m_mask;
+        if (m_entries[i].m_key == kEmpty)
+            m_size++;
+        m_entries[i] = { key, sig };
+    }
+
+    /// Makes room for this many events without growing again.
+    void Reserve(size_t entries)
+    {
+        size_t needed = (entries * 10 / 7) + 1;
+        if (needed > m_entries.size())
+            Allocate(needed);
+    }
+
+    /// Removes the events for which remove(chanid, sig) is true.
+    /// \return Number of events removed
+    template <typename Pred>
+    size_t RemoveIf(Pred remove)
+    {
+        std::vector<Entry> old;
+        old.swap(m_entries);
+        size_t before = m_size;
+        m_size = 0;
+        m_entries.resize(old.size(), Entry());
+        for (const auto & entry : old)
+        {
+            if (entry.m_key != kEmpty &&
+                !remove(static_cast<uint>(entry.m_key >> 32), entry.m_sig))
+            {
+                Place(entry);
+            }
+        }
+        return before - m_size;
+    }
+
+    void clear(void)
+    {
+        m_entries.assign(kMinCapacity, Entry());
+        m_mask = kMinCapacity - 1;
+        m_size = 0;
+    }
+
+    size_t size(void) const     { return m_size; }
+    size_t capacity(void) const { return m_entries.size(); }
+    /// Bytes used by the table, including the free slots.
+    size_t MemoryUsage(void) const { return m_entries.size() * sizeof(Entry); }
+
+    static constexpr size_t kMinCapacity { 1 << 16 };
+
+  private:
+    struct Entry
+    {
+        uint64_t m_key { kEmpty };
+        uint64_t m_sig { 0 };
+    };
+
+    static constexpr uint64_t kEmpty { UINT64_MAX };
+
+    static uint64_t MakeKey(uint chanid, uint eventid)
+    {
+        return (static_cast<uint64_t>(chanid) << 32) | eventid;
+    }
+
+    size_t Slot(uint64_t key) const
+    {
+        // Fibonacci hashing, consecutive event ids spread over the table
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32) & m_mask;
+    }
+
+    void Place(const Entry &entry)
+    {
+        size_t i = Slot(entry.m_key);
+        while (m_entries[i].m_key != kEmpty)
+            i = (i + 1) & m_mask;
+        m_entries[i] = entry;
+        m_size++;
+    }
+
+    /// Resizes to the power of two at or above capacity and rehashes.
+    void Allocate(size_t capacity)
+    {
+        size_t size = kMinCapacity;
+        while (size < capacity)
+            size <<= 1;
+
+        std::vector<Entry> old;
+        old.swap(m_entries);
+        m_entries.resize(size, Entry());
+        m_mask = size - 1;
+        m_size = 0;
+        for (const auto & entry : old)
+        {
+            if (entry.m_key != kEmpty)
+                Place(entry);
+        }
+    }
+
+    std::vector<Entry> m_entries;
+    size_t             m_mask { 0 };
+    size_t             m_size { 0 };
+};
 
-class EITCache
+class MTV_PUBLIC EITCache
 {
+    friend class TestEITCache;
+
   public:
     EITCache();
    ~EITCache();
@@ -35,11 +173,18 @@ class EITCache
     QString GetStatistics(void) const;
 
   private:
-    event_map_t * LoadChannel(uint chanid);
-    bool WriteChannelToDB(QStringList &value_clauses, uint chanid);
+    bool LoadChannel(uint chanid);
 
     // event key cache
-    key_map_t      m_channelMap;
+    EITCacheTable  m_events;
+
+    /// Channels looked up so far, false if the channel is locked by
+    /// another backend
+    QHash<uint, bool>     m_channels;
+    /// Channels loaded and locked since the last write
+    std::vector<uint>     m_lockedChannels;
+    /// Events modified since the last write, as chanid << 32 | eventid
+    std::vector<uint64_t> m_dirty;
 
     mutable QMutex m_eventMapLock;
     uint           m_lastPruneTime;
@@ -59,7 +204,7 @@ class EITCache
     static const uint kVersionMax;
 
   public:
-    static MTV_PUBLIC void ClearChannelLocks(void);
+    static void ClearChannelLocks(void);
 };
 
 #endif // EIT_CACHE_H
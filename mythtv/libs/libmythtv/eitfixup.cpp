@@ -22,6 +22,59 @@ static const QRegularExpression kUKSpaceColonStart { R"(^[ |:]*)" };
 #define capturedView capturedRef
 #endif
 
+namespace {
+
+/** \brief A fixup regular expression with a literal prefilter.
+ *
+ *  Most fixups only apply to a few events.  Looking for a literal that
+ *  every match has to contain is much cheaper than running the regular
+ *  expression, so it is only run when the text contains one of the
+ *  literals.  A rule without literals is always run.
+ */
+class FixupRule
+{
+  public:
+    FixupRule(const QString &pattern, QStringList literals,
+              QRegularExpression::PatternOptions options =
+              QRegularExpression::NoPatternOption) :
+        m_pattern(pattern, options),
+        m_literals(std::move(literals)),
+        m_cs((options & QRegularExpression::CaseInsensitiveOption) ?
+             Qt::CaseInsensitive : Qt::CaseSensitive)
+    {
+        // Compile, and JIT compile, once instead of on first use
+        m_pattern.optimize();
+    }
+
+    bool MayMatch(const QString &text) const
+    {
+        return m_literals.isEmpty() ||
+            std::any_of(m_literals.cbegin(), m_literals.cend(),
+                        [&text, this](const QString &literal)
+                        { return text.contains(literal, m_cs); });
+    }
+
+    QRegularExpressionMatch Match(const QString &text, int offset = 0) const
+    {
+        if (!MayMatch(text))
+            return {};
+        return m_pattern.match(text, offset);
+    }
+
+    void Remove(QString &text) const
+    {
+        if (MayMatch(text))
+            text.remove(m_pattern);
+    }
+
+  private:
+    QRegularExpression  m_pattern;
+    QStringList         m_literals;
+    Qt::CaseSensitivity m_cs;
+};
+
+} // namespace
+
 static const QMap<QChar,quint16> r2v = {
     {'I' ,   1}, {'V' ,   5}, {'X' ,   10}, {'L' , 50},
     {'C' , 100}, {'D' , 500}, {'M' , 1000},
@@ -665,44 +718,41 @@ void EITFixUp::FixUK(DBEventEIT &event)
 
     bool isMovie = event.m_category.startsWith("Movie",Qt::CaseInsensitive) ||
                    event.m_category.startsWith("Film",Qt::CaseInsensitive);
-    // BBC three case (could add another record here ?)
-    static const QRegularExpression ukThen { R"(\s*?(Then|Followed by) 60 Seconds\.)",
-        QRegularExpression::CaseInsensitiveOption };
-    static const QRegularExpression ukNew { R"((New\.|\s*?(Brand New|New)\s*?(Series|Episode)\s*?[:\.\-]))",
-        QRegularExpression::CaseInsensitiveOption };
-    static const QRegularExpression ukNewTitle { R"(^(Brand New|New:)\s*)",
-        QRegularExpression::CaseInsensitiveOption };
-    event.m_description = event.m_description.remove(ukThen);
-    event.m_description = event.m_description.remove(ukNew);
-    event.m_title = event.m_title.remove(ukNewTitle);
-
-    // Removal of Class TV, CBBC and CBeebies etc..
-    static const QRegularExpression ukTitleRemove { "^(?:[tT]4:|Schools\\s*?:)" };
-    static const QRegularExpression ukDescriptionRemove { R"(^(?:CBBC\s*?\.|CBeebies\s*?\.|Class TV\s*?:|BBC Switch\.))" };
-    event.m_title = event.m_title.remove(ukTitleRemove);
-    event.m_description = event.m_description.remove(ukDescriptionRemove);
-
-    // Removal of BBC FOUR and BBC THREE
-    static const QRegularExpression ukBBC34 { R"(BBC (?:THREE|FOUR) on BBC (?:ONE|TWO)\.)",
-        QRegularExpression::CaseInsensitiveOption };
-    event.m_description = event.m_description.remove(ukBBC34);
-
-    // BBC 7 [Rpt of ...] case.
-    static const QRegularExpression ukBBC7rpt { R"(\[Rptd?[^]]+?\d{1,2}\.\d{1,2}[ap]m\]\.)" };
-    event.m_description = event.m_description.remove(ukBBC7rpt);
-
-    // "All New To 4Music!
-    static const QRegularExpression ukAllNew { R"(All New To 4Music!\s?)" };
-    event.m_description = event.m_description.remove(ukAllNew);
-
-    // Removal of 'Also in HD' text
-    static const QRegularExpression ukAlsoInHD { R"(\s*Also in HD\.)",
-        QRegularExpression::CaseInsensitiveOption };
-    event.m_description = event.m_description.remove(ukAlsoInHD);
+    // Text that is removed wherever it is found, in this order
+    static const std::array<const FixupRule,2> ukTitleRemovals {{
+        // "New" markers
+        { R"(^(Brand New|New:)\s*)", {},
+          QRegularExpression::CaseInsensitiveOption },
+        // Class TV, CBBC and CBeebies etc..
+        { "^(?:[tT]4:|Schools\\s*?:)", {} },
+    }};
+    static const std::array<const FixupRule,7> ukDescriptionRemovals {{
+        // BBC three case (could add another record here ?)
+        { R"(\s*?(Then|Followed by) 60 Seconds\.)", { "60 Seconds." },
+          QRegularExpression::CaseInsensitiveOption },
+        { R"((New\.|\s*?(Brand New|New)\s*?(Series|Episode)\s*?[:\.\-]))",
+          { "New" }, QRegularExpression::CaseInsensitiveOption },
+        // Class TV, CBBC and CBeebies etc..
+        { R"(^(?:CBBC\s*?\.|CBeebies\s*?\.|Class TV\s*?:|BBC Switch\.))", {} },
+        // BBC FOUR and BBC THREE
+        { R"(BBC (?:THREE|FOUR) on BBC (?:ONE|TWO)\.)", { " on BBC " },
+          QRegularExpression::CaseInsensitiveOption },
+        // BBC 7 [Rpt of ...] case.
+        { R"(\[Rptd?[^]]+?\d{1,2}\.\d{1,2}[ap]m\]\.)", { "[Rpt" } },
+        // "All New To 4Music!
+        { R"(All New To 4Music!\s?)", { "All New To 4Music!" } },
+        // 'Also in HD' text
+        { R"(\s*Also in HD\.)", { "Also in HD." },
+          QRegularExpression::CaseInsensitiveOption },
+    }};
+    for (const auto & rule : ukTitleRemovals)
+        rule.Remove(event.m_title);
+    for (const auto & rule : ukDescriptionRemovals)
+        rule.Remove(event.m_description);
 
     // Remove [AD,S] etc.
-    static const QRegularExpression ukCC { R"(\[(?:(AD|SL|S|W|HD),?)+\])" };
-    auto match = ukCC.match(event.m_description);
+    static const FixupRule ukCC { R"(\[(?:(AD|SL|S|W|HD),?)+\])", { "[" } };
+    auto match = ukCC.Match(event.m_description);
     while (match.hasMatch())
     {
         QStringList tmpCCitems = match.captured(0).remove("[").remove("]").split(",");
@@ -718,7 +768,7 @@ void EITFixUp::FixUK(DBEventEIT &event)
             event.m_videoProps |= VID_WIDESCREEN;
         event.m_description.remove(match.capturedStart(0),
                                    match.capturedLength(0));
-        match = ukCC.match(event.m_description, match.capturedStart(0));
+        match = ukCC.Match(event.m_description, match.capturedStart(0));
     }
 
     event.m_title       = event.m_title.trimmed();
@@ -760,16 +810,17 @@ void EITFixUp::FixUK(DBEventEIT &event)
     // Prefer long format resorting to short format
     // cap0 = long match to remove, cap1 = long season, cap2 = long ep, cap3 = long total,
     // cap4 = short match to remove, cap5 = short ep, cap6 = short total
-    static const QRegularExpression ukSeries { "(?:" + longContext + "|" + shortContext + ")",
-        QRegularExpression::CaseInsensitiveOption };
+    // Every long form has "Ep", every short form "/" or "of"
+    static const FixupRule ukSeries { "(?:" + longContext + "|" + shortContext + ")",
+        { "Ep", "/", "of" }, QRegularExpression::CaseInsensitiveOption };
 
     bool series  = false;
     bool fromTitle = true;
-    match = ukSeries.match(event.m_title);
+    match = ukSeries.Match(event.m_title);
     if (!match.hasMatch())
     {
         fromTitle = false;
-        match = ukSeries.match(event.m_description);
+        match = ukSeries.Match(event.m_description);
     }
     if (match.hasMatch())
     {
@@ -836,10 +887,10 @@ void EITFixUp::FixUK(DBEventEIT &event)
 
     // Multi-part episodes, or films (e.g. ITV film split by news)
     // Matches Part 1, Pt 1/2, Part 1 of 2 etc.
-    static const QRegularExpression ukPart { R"([-(\:,.]\s*(?:Part|Pt)\s*(\d+)\s*(?:(?:of|/)\s*(\d+))?\s*[-):,.])",
-        QRegularExpression::CaseInsensitiveOption };
-    match = ukPart.match(event.m_title);
-    auto match2 = ukPart.match(event.m_description);
+    static const FixupRule ukPart { R"([-(\:,.]\s*(?:Part|Pt)\s*(\d+)\s*(?:(?:of|/)\s*(\d+))?\s*[-):,.])",
+        { "Part", "Pt" }, QRegularExpression::CaseInsensitiveOption };
+    match = ukPart.Match(event.m_title);
+    auto match2 = ukPart.Match(event.m_description);
     if (match.hasMatch())
     {
         event.m_partnumber = match.captured(1).toUInt();
@@ -871,8 +922,9 @@ void EITFixUp::FixUK(DBEventEIT &event)
         }
     }
 
-    static const QRegularExpression ukStarring { R"((?:Western\s)?[Ss]tarring ([\w\s\-']+?)[Aa]nd\s([\w\s\-']+?)[\.|,]\s*(\d{4})?(?:\.\s)?)" };
-    match = ukStarring.match(event.m_description);
+    static const FixupRule ukStarring { R"((?:Western\s)?[Ss]tarring ([\w\s\-']+?)[Aa]nd\s([\w\s\-']+?)[\.|,]\s*(\d{4})?(?:\.\s)?)",
+        { "tarring " } };
+    match = ukStarring.Match(event.m_description);
     if (match.hasMatch())
     {
         // if we match this we've captured 2 actors and an (optional) airdate
@@ -2032,32 +2084,27 @@ void EITFixUp::FixNL(DBEventEIT &event)
     }
 
     //Get widescreen info
-    static const QRegularExpression nlWide { "breedbeeld" };
-    match = nlWide.match(fullinfo);
-    if (match.hasMatch())
+    if (fullinfo.contains("breedbeeld"))
     {
         event.m_videoProps |= VID_WIDESCREEN;
         fullinfo = fullinfo.replace("breedbeeld", ".");
     }
 
     // Get repeat info
-    static const QRegularExpression nlRepeat { "herh." };
-    match = nlRepeat.match(fullinfo);
-    if (match.hasMatch())
+    static const FixupRule nlRepeat { "herh.", { "herh" } };
+    if (nlRepeat.Match(fullinfo).hasMatch())
         fullinfo = fullinfo.replace("herh.", ".");
 
     // Get teletext subtitle info
-    static const QRegularExpression nlTxt { "txt" };
-    match = nlTxt.match(fullinfo);
-    if (match.hasMatch())
+    if (fullinfo.contains("txt"))
     {
         event.m_subtitleType |= SUB_NORMAL;
         fullinfo = fullinfo.replace("txt", ".");
     }
 
     // Get HDTV information
-    static const QRegularExpression nlHD { R"(\sHD$)" };
-    match = nlHD.match(event.m_title);
+    static const FixupRule nlHD { R"(\sHD$)", { "HD" } };
+    match = nlHD.Match(event.m_title);
     if (match.hasMatch())
     {
         event.m_videoProps |= VID_HDTV;
@@ -2065,8 +2112,8 @@ void EITFixUp::FixNL(DBEventEIT &event)
     }
 
     // Try to make subtitle from Afl.:
-    static const QRegularExpression nlSub { R"(\sAfl\.:\s([^\.]+)\.)" };
-    match = nlSub.match(fullinfo);
+    static const FixupRule nlSub { R"(\sAfl\.:\s([^\.]+)\.)", { "Afl.:" } };
+    match = nlSub.Match(fullinfo);
     if (match.hasMatch())
     {
         QString tmpSubString = match.captured(0);
@@ -2076,8 +2123,8 @@ void EITFixUp::FixNL(DBEventEIT &event)
     }
 
     // Try to make subtitle from " "
-    static const QRegularExpression nlSub2 { R"(\s\"([^\"]+)\")" };
-    match = nlSub2.match(fullinfo);
+    static const FixupRule nlSub2 { R"(\s\"([^\"]+)\")", { "\"" } };
+    match = nlSub2.Match(fullinfo);
     if (match.hasMatch())
     {
         QString tmpSubString = match.captured(0);
@@ -2100,9 +2147,9 @@ void EITFixUp::FixNL(DBEventEIT &event)
 
 
     // Get the actors
-    static const QRegularExpression nlActors { R"(\sMet:\s.+e\.a\.)" };
+    static const FixupRule nlActors { R"(\sMet:\s.+e\.a\.)", { "Met:" } };
     static const QRegularExpression nlPersSeparator { R"((, |\sen\s))" };
-    match = nlActors.match(fullinfo);
+    match = nlActors.Match(fullinfo);
     if (match.hasMatch())
     {
         QString tmpActorsString = match.captured(0);
@@ -2123,8 +2170,9 @@ void EITFixUp::FixNL(DBEventEIT &event)
     }
 
     // Try to find presenter
-    static const QRegularExpression nlPres { R"(\sPresentatie:\s([^\.]+)\.)" };
-    match = nlPres.match(fullinfo);
+    static const FixupRule nlPres { R"(\sPresentatie:\s([^\.]+)\.)",
+        { "Presentatie:" } };
+    match = nlPres.Match(fullinfo);
     if (match.hasMatch())
     {
         QString tmpPresString = match.captured(0);
@@ -2143,10 +2191,10 @@ void EITFixUp::FixNL(DBEventEIT &event)
     }
 
     // Try to find year
-    static const QRegularExpression nlYear1 { R"(\suit\s([1-2][0-9]{3}))" };
-    static const QRegularExpression nlYear2 { R"((\s\([A-Z]{0,3}/?)([1-2][0-9]{3})\))",
-        QRegularExpression::CaseInsensitiveOption };
-    match = nlYear1.match(fullinfo);
+    static const FixupRule nlYear1 { R"(\suit\s([1-2][0-9]{3}))", { "uit" } };
+    static const FixupRule nlYear2 { R"((\s\([A-Z]{0,3}/?)([1-2][0-9]{3})\))",
+        { "(" }, QRegularExpression::CaseInsensitiveOption };
+    match = nlYear1.Match(fullinfo);
     if (match.hasMatch())
     {
         bool ok = false;
@@ -2155,7 +2203,7 @@ void EITFixUp::FixNL(DBEventEIT &event)
             event.m_originalairdate = QDate(y, 1, 1);
     }
 
-    match = nlYear2.match(fullinfo);
+    match = nlYear2.Match(fullinfo);
     if (match.hasMatch())
     {
         bool ok = false;
@@ -2165,22 +2213,23 @@ void EITFixUp::FixNL(DBEventEIT &event)
     }
 
     // Try to find director
-    static const QRegularExpression nlDirector { R"(\svan\s(([A-Z][a-z]+\s)|([A-Z]\.\s)))" };
-    match = nlDirector.match(fullinfo);
+    static const FixupRule nlDirector { R"(\svan\s(([A-Z][a-z]+\s)|([A-Z]\.\s)))",
+        { "van" } };
+    match = nlDirector.Match(fullinfo);
     if (match.hasMatch())
         event.AddPerson(DBPerson::kDirector, match.captured(1));
 
     // Strip leftovers
-    static const QRegularExpression nlRub { R"(\s?\(\W+\)\s?)" };
-    fullinfo.remove(nlRub);
+    static const FixupRule nlRub { R"(\s?\(\W+\)\s?)", { "(" } };
+    nlRub.Remove(fullinfo);
 
     // Strip category info from description
-    static const QRegularExpression nlCat { "^(Amusement|Muziek|Informatief|Nieuws/actualiteiten|Jeugd|Animatie|Sport|Serie/soap|Kunst/Cultuur|Documentaire|Film|Natuur|Erotiek|Comedy|Misdaad|Religieus)\\.\\s" };
-    fullinfo.remove(nlCat);
+    static const FixupRule nlCat { "^(Amusement|Muziek|Informatief|Nieuws/actualiteiten|Jeugd|Animatie|Sport|Serie/soap|Kunst/Cultuur|Documentaire|Film|Natuur|Erotiek|Comedy|Misdaad|Religieus)\\.\\s", {} };
+    nlCat.Remove(fullinfo);
 
     // Remove omroep from title
-    static const QRegularExpression nlOmroep { R"(\s\(([A-Z]+/?)+\)$)" };
-    event.m_title.remove(nlOmroep);
+    static const FixupRule nlOmroep { R"(\s\(([A-Z]+/?)+\)$)", { ")" } };
+    nlOmroep.Remove(event.m_title);
 
     // Put information back in description
 
@@ -2302,8 +2351,8 @@ void EITFixUp::FixDK(DBEventEIT &event)
 
     // Title search
     // episode and part/part total
-    static const QRegularExpression dkEpisode { R"(\(([0-9]+)\))" };
-    auto match = dkEpisode.match(event.m_title);
+    static const FixupRule dkEpisode { R"(\(([0-9]+)\))", { "(" } };
+    auto match = dkEpisode.Match(event.m_title);
     if (match.hasMatch())
     {
         episode = match.capturedView(1).toInt();
@@ -2311,8 +2360,8 @@ void EITFixUp::FixDK(DBEventEIT &event)
         event.m_title.remove(match.capturedStart(), match.capturedLength());
     }
 
-    static const QRegularExpression dkPart { R"(\(([0-9]+):([0-9]+)\))" };
-    match = dkPart.match(event.m_title);
+    static const FixupRule dkPart { R"(\(([0-9]+):([0-9]+)\))", { ":" } };
+    match = dkPart.Match(event.m_title);
     if (match.hasMatch())
     {
         episode = match.capturedView(1).toInt();
@@ -2322,8 +2371,8 @@ void EITFixUp::FixDK(DBEventEIT &event)
     }
 
     // subtitle delimiters
-    static const QRegularExpression dkSubtitle1 { "^([^:]+): (.+)" };
-    match = dkSubtitle1.match(event.m_title);
+    static const FixupRule dkSubtitle1 { "^([^:]+): (.+)", { ": " } };
+    match = dkSubtitle1.Match(event.m_title);
     if (match.hasMatch())
     {
         event.m_title =    match.captured(1);
@@ -2331,8 +2380,8 @@ void EITFixUp::FixDK(DBEventEIT &event)
     }
     else
     {
-        static const QRegularExpression dkSubtitle2 { "^([^:]+) - (.+)" };
-        match = dkSubtitle2.match(event.m_title);
+        static const FixupRule dkSubtitle2 { "^([^:]+) - (.+)", { " - " } };
+        match = dkSubtitle2.Match(event.m_title);
         if (match.hasMatch())
         {
             event.m_title =    match.captured(1);
@@ -2343,16 +2392,16 @@ void EITFixUp::FixDK(DBEventEIT &event)
     // Description search
     // Season (Sæson [:digit:]+.) => episode = season episode number
     // or year (- år [:digit:]+(\\)|:) ) => episode = total episode number
-    static const QRegularExpression dkSeason1 { "Sæson ([0-9]+)\\." };
-    match = dkSeason1.match(event.m_description);
+    static const FixupRule dkSeason1 { "Sæson ([0-9]+)\\.", { "Sæson " } };
+    match = dkSeason1.Match(event.m_description);
     if (match.hasMatch())
     {
         season = match.capturedView(1).toInt();
     }
     else
     {
-        static const QRegularExpression dkSeason2 { "- år ([0-9]+) :" };
-        match = dkSeason2.match(event.m_description);
+        static const FixupRule dkSeason2 { "- år ([0-9]+) :", { "- år " } };
+        match = dkSeason2.Match(event.m_description);
         if (match.hasMatch())
         {
             season = match.capturedView(1).toInt();
@@ -2366,40 +2415,33 @@ void EITFixUp::FixDK(DBEventEIT &event)
         event.m_season = season;
 
     //Feature:
-    static const QRegularExpression dkFeatures { "Features:(.+)" };
-    match = dkFeatures.match(event.m_description);
+    static const FixupRule dkFeatures { "Features:(.+)", { "Features:" } };
+    match = dkFeatures.Match(event.m_description);
     if (match.hasMatch())
     {
         QString features = match.captured(1);
         event.m_description.remove(match.capturedStart(),
                                    match.capturedLength());
         // 16:9
-        static const QRegularExpression dkWidescreen { " 16:9" };
-        if (features.indexOf(dkWidescreen) !=  -1)
+        if (features.contains(" 16:9"))
             event.m_videoProps |= VID_WIDESCREEN;
         // HDTV
-        static const QRegularExpression dkHD { " HD" };
-        if (features.indexOf(dkHD) !=  -1)
+        if (features.contains(" HD"))
             event.m_videoProps |= VID_HDTV;
         // Dolby Digital surround
-        static const QRegularExpression dkDolby { " 5:1" };
-        if (features.indexOf(dkDolby) !=  -1)
+        if (features.contains(" 5:1"))
             event.m_audioProps |= AUD_DOLBY;
         // surround
-        static const QRegularExpression dkSurround { R"( \(\(S\)\))" };
-        if (features.indexOf(dkSurround) !=  -1)
+        if (features.contains(" ((S))"))
             event.m_audioProps |= AUD_SURROUND;
         // stereo
-        static const QRegularExpression dkStereo { " S" };
-        if (features.indexOf(dkStereo) !=  -1)
+        if (features.contains(" S"))
             event.m_audioProps |= AUD_STEREO;
         // (G)
-        static const QRegularExpression dkReplay { " \\(G\\)" };
-        if (features.indexOf(dkReplay) !=  -1)
+        if (features.contains(" (G)"))
             event.m_previouslyshown = true;
         // TTV
-        static const QRegularExpression dkTxt { " TTV" };
-        if (features.indexOf(dkTxt) !=  -1)
+        if (features.contains(" TTV"))
             event.m_subtitleType |= SUB_NORMAL;
     }
 
@@ -2446,10 +2488,11 @@ void EITFixUp::FixDK(DBEventEIT &event)
     }
 
     // Find actors and director in description
-    static const QRegularExpression dkDirector { "(?:Instr.: |Instrukt.r: )(.+)$" };
+    static const FixupRule dkDirector { "(?:Instr.: |Instrukt.r: )(.+)$",
+        { "Instr" } };
     static const QRegularExpression dkPersonsSeparator { "(, )|(og )" };
     QStringList directors {};
-    match = dkDirector.match(event.m_description);
+    match = dkDirector.Match(event.m_description);
     if (match.hasMatch())
     {
         QString tmpDirectorsString = match.captured(1);
@@ -2468,8 +2511,9 @@ void EITFixUp::FixDK(DBEventEIT &event)
         //event.m_description.remove(match.capturedStart(), match.capturedLength());
     }
 
-    static const QRegularExpression dkActors { "(?:Medvirkende: |Medv\\.: )(.+)" };
-    match = dkActors.match(event.m_description);
+    static const FixupRule dkActors { "(?:Medvirkende: |Medv\\.: )(.+)",
+        { "Medv" } };
+    match = dkActors.Match(event.m_description);
     if (match.hasMatch())
     {
         QString tmpActorsString = match.captured(1);
@@ -2491,8 +2535,8 @@ void EITFixUp::FixDK(DBEventEIT &event)
     }
 
     //find year
-    static const QRegularExpression dkYear { " fra ([0-9]{4})[ \\.]" };
-    match = dkYear.match(event.m_description);
+    static const FixupRule dkYear { " fra ([0-9]{4})[ \\.]", { " fra " } };
+    match = dkYear.Match(event.m_description);
     if (match.hasMatch())
     {
         bool ok = false;
@@ -20,7 +20,7 @@
 #include "scheduledrecording.h" // for ScheduledRecording
 #include "compat.h"             // for gmtime_r on windows.
 
-const uint EITHelper::kChunkSize =   20;
+const uint EITHelper::kChunkSize =  200;
 const uint EITHelper::kMaxSize   = 1000;
 
 EITCache *EITHelper::s_eitCache = new EITCache();
@@ -66,7 +66,8 @@ bool EITHelper::EventQueueFull(void) const
  *  \brief Get events from queue and insert into DB after processing.
  *
  * Process a maximum of kChunkSize events at a time
- * to avoid clogging the machine.
+ * to avoid clogging the machine. The events are written as one batch,
+ * see DBEventEIT::UpdateDB().
  *
  *  \return Returns number of events inserted into DB.
  */
@@ -78,20 +79,23 @@ uint EITHelper::ProcessEvents(void)
     if (m_dbEvents.empty())
         return 0;
 
-    MSqlQuery query(MSqlQuery::InitCon());
+    std::vector<DBEventEIT*> events;
     for (uint i = 0; (i < kChunkSize) && (!m_dbEvents.empty()); i++)
-    {
-        DBEventEIT *event = m_dbEvents.dequeue();
-        m_eitListLock.unlock();
+        events.push_back(m_dbEvents.dequeue());
+    m_eitListLock.unlock();
 
+    for (auto *event : events)
+    {
         EITFixUp::Fix(*event);
-
-        insertCount += event->UpdateDB(query, 1000);
         m_maxStarttime = std::max (m_maxStarttime, event->m_starttime);
+    }
+
+    MSqlQuery query(MSqlQuery::InitCon());
+    insertCount = DBEventEIT::UpdateDB(query, events, 1000);
 
+    for (auto *event : events)
         delete event;
-        m_eitListLock.lock();
-    }
+    m_eitListLock.lock();
 
     if (!insertCount)
         return 0;
@@ -14,7 +14,9 @@
 #include "io/mythfilebuffer.h"
 
 // Std
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstdlib>
 #include <cerrno>
 #include <sys/types.h>
@@ -44,6 +46,15 @@ static int posix_fadvise(int, off_t, off_t, int) { return 0; }
 
 #define LOC QString("FileRingBuf(%1): ").arg(m_filename)
 
+// Seconds of data the kernel is asked to read ahead of local reads
+static constexpr std::chrono::seconds kAdviseAhead { 4s };
+static constexpr long long kAdviseMinWindow { 2LL  * 1024 * 1024 };
+static constexpr long long kAdviseMaxWindow { 64LL * 1024 * 1024 };
+// Windows are aligned to this, so the kernel issues large requests
+static constexpr long long kAdviseAlign     { 1024LL * 1024 };
+// Data kept cached behind the read position, for short rewinds
+static constexpr long long kAdviseKeepBehind { 32LL * 1024 * 1024 };
+
 static const QStringList kSubExt        {".ass", ".srt", ".ssa", ".sub", ".txt"};
 static const QStringList kSubExtNoCheck {".ass", ".srt", ".ssa", ".sub", ".txt", ".gif", ".png"};
 
@@ -74,6 +85,7 @@ MythFileBuffer::MythFileBuffer(const QString &Filename, bool Write, bool UseRead
         else
         {
             m_tfw = new ThreadedFileWriter(m_filename, O_WRONLY|O_TRUNC|O_CREAT|O_LARGEFILE, 0644);
+            m_tfw->SetDirectIO(gCoreContext->GetBoolSetting("RecordingDirectIO", false));
             if (!m_tfw->Open())
             {
                 delete m_tfw;
@@ -485,6 +497,7 @@ int MythFileBuffer::SafeRead(int /*fd*/, void *Buffer, uint Size)
         }
         else if (ret > 0)
         {
+            AdviseRead(m_internalReadPos + tot, static_cast<uint>(ret));
             tot += static_cast<uint>(ret);
         }
 
@@ -520,6 +533,72 @@ int MythFileBuffer::SafeRead(int /*fd*/, void *Buffer, uint Size)
     return static_cast<int>(tot);
 }
 
+/** \brief Tells the kernel about the reads of a local file.
+ *
+ *  The kernel is asked to read a window of kAdviseAhead seconds ahead of
+ *  the reads, at the rate data is read or the stream's bitrate at the
+ *  current play speed, whichever is higher.  The read ahead thread only
+ *  reads as fast as the decoder consumes once its buffer is full, so the
+ *  measured rate follows the decoder, and the window grows when fast
+ *  forwarding.  Pages further than kAdviseKeepBehind, or four windows,
+ *  behind the reads are dropped from the page cache, so that one stream
+ *  doesn't push out the data of the others sharing the disks.
+ */
+void MythFileBuffer::AdviseRead(long long Position, uint Size)
+{
+#ifndef _MSC_VER
+    if (m_fd2 < 0 || m_writeMode)
+        return;
+
+    if (Position != m_adviseNext)
+    {
+        // A seek, start over from here
+        m_adviseAhead  = 0;
+        m_adviseBehind = Position;
+    }
+    m_adviseNext = Position + Size;
+
+    m_adviseBytes += Size;
+    if (!m_adviseTimer.isRunning())
+    {
+        m_adviseTimer.start();
+        m_adviseBytes = Size;
+    }
+    else if (m_adviseTimer.elapsed() >= 1s)
+    {
+        long long rate = m_adviseBytes * 1000 / m_adviseTimer.elapsed().count();
+        m_adviseRate = m_adviseRate ? (m_adviseRate * 3 + rate) / 4 : rate;
+        m_adviseTimer.start();
+        m_adviseBytes = 0;
+    }
+
+    // m_rawBitrate is in kbit/s
+    auto bitrate = static_cast<long long>(m_rawBitrate * 125 * std::max(std::fabs(m_playSpeed), 1.0F));
+    long long window = std::max(m_adviseRate, bitrate) * kAdviseAhead.count();
+    window = std::clamp(window, kAdviseMinWindow, kAdviseMaxWindow);
+
+    if (m_adviseAhead - m_adviseNext < window / 2)
+    {
+        long long start = std::max(m_adviseAhead, m_adviseNext);
+        long long end = ((m_adviseNext + window + kAdviseAlign - 1) / kAdviseAlign) * kAdviseAlign;
+        if (posix_fadvise(m_fd2, start, end - start, POSIX_FADV_WILLNEED) != 0)
+            LOG(VB_FILE, LOG_DEBUG, LOC + "AdviseRead(): fadvise willneed failed: " + ENO);
+        m_adviseAhead = end;
+    }
+
+    long long drop = ((Position - std::max(window * 4, kAdviseKeepBehind)) / kAdviseAlign) * kAdviseAlign;
+    if (drop - m_adviseBehind >= kAdviseAlign * 8)
+    {
+        if (posix_fadvise(m_fd2, m_adviseBehind, drop - m_adviseBehind, POSIX_FADV_DONTNEED) != 0)
+            LOG(VB_FILE, LOG_DEBUG, LOC + "AdviseRead(): fadvise dontneed failed: " + ENO);
+        m_adviseBehind = drop;
+    }
+#else
+    Q_UNUSED(Position);
+    Q_UNUSED(Size);
+#endif
+}
+
 /** \fn FileRingBuffer::safe_read(RemoteFile*, void*, uint)
  *  \brief Reads data from the RemoteFile.
  *
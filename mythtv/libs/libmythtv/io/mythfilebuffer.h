@@ -2,6 +2,7 @@
 #include <QCoreApplication>
 
 // MythTV
+#include "mythtimer.h"
 #include "io/mythmediabuffer.h"
 
 class MTV_PUBLIC MythFileBuffer : public MythMediaBuffer
@@ -25,4 +26,15 @@ class MTV_PUBLIC MythFileBuffer : public MythMediaBuffer
     int       SafeRead        (RemoteFile *Remote, void *Buffer, uint Size);
     long long GetRealFileSizeInternal(void) const override;
     long long SeekInternal    (long long Position, int Whence) override;
+
+  private:
+    void      AdviseRead      (long long Position, uint Size);
+
+    // Kernel read ahead of local files, used with m_rwLock held
+    MythTimer m_adviseTimer;
+    long long m_adviseBytes   { 0 };
+    long long m_adviseRate    { 0 };  ///< bytes per second read, measured
+    long long m_adviseNext    { -1 }; ///< where the next sequential read is
+    long long m_adviseAhead   { 0 };  ///< end of the WILLNEED window
+    long long m_adviseBehind  { 0 };  ///< start of the pages left cached
 };
@@ -375,6 +375,10 @@ void MythMediaBuffer::CalcReadAheadThresh(void)
         m_readBlockSize = rbs;
     else
         m_readBlockSize = m_bitrateInitialized ? std::max(rbs, m_readBlockSize) : rbs;
+    // Fast forward through local files in large reads, the kernel is
+    // asked to read ahead of them, see MythFileBuffer::AdviseRead()
+    if (m_playSpeed > 1.0F && m_fd2 >= 0)
+        m_readBlockSize = std::max(m_readBlockSize, static_cast<int>(KB512));
 
     // minimum seconds of buffering before allowing read
     float secs_min = 0.3F;
@@ -1370,6 +1374,10 @@ int MythMediaBuffer::ReadPriv(void *Buffer, int Count, bool Peek)
     }
 
     int available = ReadBufAvail();
+    if (available - m_readOffset >= Count)
+        m_readHits++;
+    else
+        m_readMisses++;
     MythTimer timer(MythTimer::kStartRunning);
 
     // Wait up to 10000 ms for any data
@@ -1535,9 +1543,16 @@ QString MythMediaBuffer::GetDecoderRate(void)
     return BitrateToString(UpdateDecoderRate());
 }
 
+/// Returns the storage read rate, and how many reads the read ahead
+/// buffer had the data ready for
 QString MythMediaBuffer::GetStorageRate(void)
 {
-    return BitrateToString(UpdateStorageRate());
+    QString rate = BitrateToString(UpdateStorageRate());
+    uint64_t hits = m_readHits;
+    uint64_t reads = hits + m_readMisses;
+    if (!reads)
+        return rate;
+    return QObject::tr("%1 (%2% hits)").arg(rate).arg(hits * 100 / reads);
 }
 
 QString MythMediaBuffer::GetAvailableBuffer(void)
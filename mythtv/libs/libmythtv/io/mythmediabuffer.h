@@ -1,6 +1,9 @@
 #ifndef MYTHMEDIABUFFER_H
 #define MYTHMEDIABUFFER_H
 
+// Std
+#include <atomic>
+
 // Qt
 #include <QReadWriteLock>
 #include <QWaitCondition>
@@ -226,6 +229,9 @@ class MTV_PUBLIC MythMediaBuffer : protected MThread
     QMap<std::chrono::milliseconds, uint64_t> m_decoderReads;
     QMutex                 m_storageReadLock;
     QMap<std::chrono::milliseconds, uint64_t> m_storageReads;
+    // Reads served from the read ahead buffer without waiting for storage
+    std::atomic<uint64_t>  m_readHits   { 0 };
+    std::atomic<uint64_t>  m_readMisses { 0 };
 
     // note 1: numfailures is modified with only a read lock in the
     // read ahead thread, but this is safe since all other places
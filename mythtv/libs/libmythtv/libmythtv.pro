@@ -241,6 +241,7 @@ HEADERS += mpeg/tsstats.h           mpeg/streamlisteners.h
 HEADERS += mpeg/H2645Parser.h mpeg/AVCParser.h mpeg/HEVCParser.h
 HEADERS += mpeg/tablestatus.h
 HEADERS += mpeg/tsstreamdata.h
+HEADERS += mpeg/tssync.h
 
 SOURCES += mpeg/tspacket.cpp        mpeg/pespacket.cpp
 SOURCES += mpeg/mpegtables.cpp      mpeg/atsctables.cpp
@@ -258,6 +259,7 @@ SOURCES += mpeg/iso6937tables.cpp
 SOURCES += mpeg/H2645Parser.cpp mpeg/AVCParser.cpp mpeg/HEVCParser.cpp
 SOURCES += mpeg/tablestatus.cpp
 SOURCES += mpeg/tsstreamdata.cpp
+SOURCES += mpeg/tssync.cpp
 
 # Channels, and the multiplexes that transmit them
 HEADERS += frequencies.h            frequencytables.h
@@ -925,6 +927,7 @@ using_backend {
     HEADERS += recorders/iptvsignalmonitor.h
     HEADERS += recorders/iptvstreamhandler.h
     HEADERS *= recorders/streamhandler.h
+    HEADERS *= recorders/streamfanout.h
 
     HEADERS += recorders/rtp/udppacket.h
     HEADERS += recorders/rtp/udppacketbuffer.h
@@ -940,6 +943,7 @@ using_backend {
     SOURCES += recorders/iptvsignalmonitor.cpp
     SOURCES += recorders/iptvstreamhandler.cpp
     SOURCES *= recorders/streamhandler.cpp
+    SOURCES *= recorders/streamfanout.cpp
 
     SOURCES += recorders/rtp/packetbuffer.cpp
     SOURCES += recorders/rtp/rtppacketbuffer.cpp
@@ -955,12 +959,14 @@ using_backend {
     HEADERS += recorders/HLS/HLSPlaylistWorker.h
     HEADERS += recorders/HLS/HLSReader.h
     HEADERS += recorders/HLS/HLSSegment.h
+    HEADERS += recorders/HLS/HLSSegmentFetcher.h
     HEADERS += recorders/HLS/HLSStream.h
     HEADERS += recorders/HLS/HLSStreamWorker.h
 
     SOURCES += recorders/HLS/HLSPlaylistWorker.cpp
     SOURCES += recorders/HLS/HLSReader.cpp
     SOURCES += recorders/HLS/HLSSegment.cpp
+    SOURCES += recorders/HLS/HLSSegmentFetcher.cpp
     SOURCES += recorders/HLS/HLSStream.cpp
     SOURCES += recorders/HLS/HLSStreamWorker.cpp
 
@@ -982,7 +988,9 @@ using_backend {
         SOURCES += recorders/hdhrstreamhandler.cpp
 
         HEADERS *= recorders/streamhandler.h
+        HEADERS *= recorders/streamfanout.h
         SOURCES *= recorders/streamhandler.cpp
+        SOURCES *= recorders/streamfanout.cpp
 
         DEFINES += USING_HDHOMERUN
         DEFINES += HDHOMERUN_HEADERFILE=\\\"$${HDHOMERUN_PREFIX}hdhomerun.h\\\"
@@ -1036,7 +1044,9 @@ using_backend {
         SOURCES += recorders/cetonstreamhandler.cpp
 
         HEADERS *= recorders/streamhandler.h
+        HEADERS *= recorders/streamfanout.h
         SOURCES *= recorders/streamhandler.cpp
+        SOURCES *= recorders/streamfanout.cpp
 
         DEFINES += USING_CETON
     }
@@ -1074,7 +1084,9 @@ using_backend {
         SOURCES += recorders/dvbstreamhandler.cpp
 
         HEADERS *= recorders/streamhandler.h
+        HEADERS *= recorders/streamfanout.h
         SOURCES *= recorders/streamhandler.cpp
+        SOURCES *= recorders/streamfanout.cpp
 
         # Misc
         HEADERS += recorders/dvbdev/dvbci.h
@@ -1097,7 +1109,9 @@ using_backend {
         SOURCES += recorders/asistreamhandler.cpp
 
         HEADERS *= recorders/streamhandler.h
+        HEADERS *= recorders/streamfanout.h
         SOURCES *= recorders/streamhandler.cpp
+        SOURCES *= recorders/streamfanout.cpp
 
         DEFINES += USING_ASI
     }
@@ -13,6 +13,7 @@
 #include "mpegstreamdata.h"
 #include "mpegtables.h"
 #include "mpegtables.h"
+#include "tssync.h"
 
 #include "atscstreamdata.h"
 #include "atsctables.h"
@@ -142,6 +143,7 @@ void MPEGStreamData::Reset(int desiredProgram)
     m_pidsConditionalAccess.clear();
 
     m_pidVideoSingleProgram = m_pidPmtSingleProgram = 0xffffffff;
+    RebuildPIDRoles();
 
     m_patStatus.clear();
 
@@ -598,11 +600,13 @@ bool MPEGStreamData::CreatePMTSingleProgram(const ProgramMapTable &pmt)
     }
 
     m_pidsAudio.clear();
+    m_pidsWriting.clear();
+    m_pidVideoSingleProgram = !videoPIDs.empty() ? videoPIDs[0] : 0xffffffff;
+    RebuildPIDRoles();
+
     for (uint pid : audioPIDs)
         AddAudioPID(pid);
 
-    m_pidsWriting.clear();
-    m_pidVideoSingleProgram = !videoPIDs.empty() ? videoPIDs[0] : 0xffffffff;
     for (size_t i = 1; i < videoPIDs.size(); i++)
         AddWritingPID(videoPIDs[i]);
 
@@ -1007,7 +1011,10 @@ bool MPEGStreamData::ProcessTSPacket(const TSPacket& tspacket)
 {
     bool ok = !tspacket.TransportError();
 
-    if (IsEncryptionTestPID(tspacket.PID()))
+    // One table lookup gives every role this PID plays, see RebuildPIDRoles()
+    const uint roles = m_pidRoles[tspacket.PID()];
+
+    if (roles & kPIDRoleEncryptionTest)
     {
         ProcessEncryptedPacket(tspacket);
     }
@@ -1035,7 +1042,7 @@ bool MPEGStreamData::ProcessTSPacket(const TSPacket& tspacket)
         }
     }
 
-    if (IsVideoPID(tspacket.PID()))
+    if (roles & kPIDRoleVideo)
     {
         for (auto & listener : m_tsAvListeners)
             listener->ProcessVideoTSPacket(tspacket);
@@ -1043,7 +1050,7 @@ bool MPEGStreamData::ProcessTSPacket(const TSPacket& tspacket)
         return true;
     }
 
-    if (IsAudioPID(tspacket.PID()))
+    if (roles & kPIDRoleAudio)
     {
         for (auto & listener : m_tsAvListeners)
             listener->ProcessAudioTSPacket(tspacket);
@@ -1051,15 +1058,16 @@ bool MPEGStreamData::ProcessTSPacket(const TSPacket& tspacket)
         return true;
     }
 
-    if (IsWritingPID(tspacket.PID()))
+    if (roles & kPIDRoleWriting)
     {
         for (auto & listener : m_tsWritingListeners)
             listener->ProcessTSPacket(tspacket);
     }
 
-    if (tspacket.HasPayload() &&
-        IsListeningPID(tspacket.PID()) &&
-        !IsConditionalAccessPID(tspacket.PID()))
+    static constexpr uint kTableMask = kPIDRoleListening |
+        kPIDRoleNotListening | kPIDRoleConditionalAccess;
+    if (tspacket.HasPayload() && !m_listeningDisabled &&
+        ((roles & kTableMask) == kPIDRoleListening))
     {
         HandleTSTables(&tspacket);          // Table handling starts here....
     }
@@ -1071,24 +1079,13 @@ int MPEGStreamData::ResyncStream(const unsigned char *buffer, int curr_pos,
                                  int len)
 {
     // Search for two sync bytes 188 bytes apart,
-    int pos = curr_pos;
-    int nextpos = pos + TSPacket::kSize;
-    if (nextpos >= len)
-        return -1; // not enough bytes; caller should try again
-
-    while (buffer[pos] != SYNC_BYTE || buffer[nextpos] != SYNC_BYTE)
-    {
-        pos++;
-        nextpos++;
-        if (nextpos == len)
-            return -2; // not found
-    }
-
-    return pos;
+    return TSSync::FindSync(buffer, curr_pos, len);
 }
 
 bool MPEGStreamData::IsConditionalAccessPID(uint pid) const
 {
+    if (pid < kPIDCount)
+        return (m_pidRoles[pid] & kPIDRoleConditionalAccess) != 0;
     pid_map_t::const_iterator it = m_pidsConditionalAccess.find(pid);
     return it != m_pidsConditionalAccess.end();
 }
@@ -1097,28 +1094,67 @@ bool MPEGStreamData::IsListeningPID(uint pid) const
 {
     if (m_listeningDisabled || IsNotListeningPID(pid))
         return false;
+    if (pid < kPIDCount)
+        return (m_pidRoles[pid] & kPIDRoleListening) != 0;
     pid_map_t::const_iterator it = m_pidsListening.find(pid);
     return it != m_pidsListening.end();
 }
 
 bool MPEGStreamData::IsNotListeningPID(uint pid) const
 {
+    if (pid < kPIDCount)
+        return (m_pidRoles[pid] & kPIDRoleNotListening) != 0;
     pid_map_t::const_iterator it = m_pidsNotListening.find(pid);
     return it != m_pidsNotListening.end();
 }
 
 bool MPEGStreamData::IsWritingPID(uint pid) const
 {
+    if (pid < kPIDCount)
+        return (m_pidRoles[pid] & kPIDRoleWriting) != 0;
     pid_map_t::const_iterator it = m_pidsWriting.find(pid);
     return it != m_pidsWriting.end();
 }
 
 bool MPEGStreamData::IsAudioPID(uint pid) const
 {
+    if (pid < kPIDCount)
+        return (m_pidRoles[pid] & kPIDRoleAudio) != 0;
     pid_map_t::const_iterator it = m_pidsAudio.find(pid);
     return it != m_pidsAudio.end();
 }
 
+/** \fn MPEGStreamData::RebuildPIDRoles(void)
+ *  \brief Recreates the PID dispatch table from the PID maps.
+ *
+ *  The Add/Remove PID methods keep the table up to date, this is
+ *  only needed after the maps or the video PID are changed directly,
+ *  e.g. when the PMT changes.
+ */
+void MPEGStreamData::RebuildPIDRoles(void)
+{
+    m_pidRoles.fill(kPIDRoleNone);
+
+    for (auto it = m_pidsListening.cbegin(); it != m_pidsListening.cend(); ++it)
+        SetPIDRole(it.key(), kPIDRoleListening, true);
+    for (auto it = m_pidsNotListening.cbegin(); it != m_pidsNotListening.cend(); ++it)
+        SetPIDRole(it.key(), kPIDRoleNotListening, true);
+    for (auto it = m_pidsWriting.cbegin(); it != m_pidsWriting.cend(); ++it)
+        SetPIDRole(it.key(), kPIDRoleWriting, true);
+    for (auto it = m_pidsAudio.cbegin(); it != m_pidsAudio.cend(); ++it)
+        SetPIDRole(it.key(), kPIDRoleAudio, true);
+    for (auto it = m_pidsConditionalAccess.cbegin();
+         it != m_pidsConditionalAccess.cend(); ++it)
+        SetPIDRole(it.key(), kPIDRoleConditionalAccess, true);
+
+    SetPIDRole(m_pidVideoSingleProgram, kPIDRoleVideo, true);
+
+    QMutexLocker locker(&m_encryptionLock);
+    for (auto it = m_encryptionPidToInfo.cbegin();
+         it != m_encryptionPidToInfo.cend(); ++it)
+        SetPIDRole(it.key(), kPIDRoleEncryptionTest, true);
+}
+
 uint MPEGStreamData::GetPIDs(pid_map_t &pids) const
 {
     uint sz = pids.size();
@@ -1763,6 +1799,7 @@ void MPEGStreamData::AddEncryptionTestPID(uint pnum, uint pid, bool isvideo)
     AddListeningPID(pid);
 
     m_encryptionPidToInfo[pid] = CryptInfo((isvideo) ? 10000 : 500, 8);
+    SetPIDRole(pid, kPIDRoleEncryptionTest, true);
 
     m_encryptionPidToPnums[pid].push_back(pnum);
     m_encryptionPnumToPids[pnum].push_back(pid);
@@ -1804,6 +1841,7 @@ void MPEGStreamData::RemoveEncryptionTestPIDs(uint pnum)
             {
                 m_encryptionPidToPnums.remove(pid);
                 m_encryptionPidToInfo.remove(pid);
+                SetPIDRole(pid, kPIDRoleEncryptionTest, false);
             }
         }
     }
@@ -1813,6 +1851,9 @@ void MPEGStreamData::RemoveEncryptionTestPIDs(uint pnum)
 
 bool MPEGStreamData::IsEncryptionTestPID(uint pid) const
 {
+    if (pid < kPIDCount)
+        return (m_pidRoles[pid] & kPIDRoleEncryptionTest) != 0;
+
     QMutexLocker locker(&m_encryptionLock);
 
     QMap<uint, CryptInfo>::const_iterator it =
@@ -1853,6 +1894,10 @@ void MPEGStreamData::ResetDecryptionMonitoringState(void)
 {
     QMutexLocker locker(&m_encryptionLock);
 
+    for (auto it = m_encryptionPidToInfo.cbegin();
+         it != m_encryptionPidToInfo.cend(); ++it)
+        SetPIDRole(it.key(), kPIDRoleEncryptionTest, false);
+
     m_encryptionPidToInfo.clear();
     m_encryptionPidToPnums.clear();
     m_encryptionPnumToPids.clear();
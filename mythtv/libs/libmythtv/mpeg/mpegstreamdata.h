@@ -4,6 +4,7 @@
 #define MPEGSTREAMDATA_H_
 
 // C++
+#include <array>
 #include <cstdint>  // uint64_t
 #include <vector>
 
@@ -81,6 +82,19 @@ enum PIDPriority
 };
 using pid_map_t = QMap<uint, PIDPriority>;
 
+/// Flags used in the per PID dispatch table, see MPEGStreamData::m_pidRoles
+enum PIDRole : std::uint8_t
+{
+    kPIDRoleNone              = 0x00,
+    kPIDRoleListening         = 0x01,
+    kPIDRoleNotListening      = 0x02,
+    kPIDRoleWriting           = 0x04,
+    kPIDRoleAudio             = 0x08,
+    kPIDRoleVideo             = 0x10,
+    kPIDRoleConditionalAccess = 0x20,
+    kPIDRoleEncryptionTest    = 0x40,
+};
+
 class MTV_PUBLIC MPEGStreamData : public EITSource
 {
   public:
@@ -118,24 +132,36 @@ class MTV_PUBLIC MPEGStreamData : public EITSource
     // Listening
     virtual void AddListeningPID(
         uint pid, PIDPriority priority = kPIDPriorityNormal)
-        { m_pidsListening[pid] = priority; }
+        { m_pidsListening[pid] = priority;
+          SetPIDRole(pid, kPIDRoleListening, true); }
     virtual void AddNotListeningPID(uint pid)
-        { m_pidsNotListening[pid] = kPIDPriorityNormal; }
+        { m_pidsNotListening[pid] = kPIDPriorityNormal;
+          SetPIDRole(pid, kPIDRoleNotListening, true); }
     virtual void AddWritingPID(
         uint pid, PIDPriority priority = kPIDPriorityHigh)
-        { m_pidsWriting[pid] = priority; }
+        { m_pidsWriting[pid] = priority;
+          SetPIDRole(pid, kPIDRoleWriting, true); }
     virtual void AddAudioPID(
         uint pid, PIDPriority priority = kPIDPriorityHigh)
-        { m_pidsAudio[pid] = priority; }
+        { m_pidsAudio[pid] = priority;
+          SetPIDRole(pid, kPIDRoleAudio, true); }
     virtual void AddConditionalAccessPID(
         uint pid, PIDPriority priority = kPIDPriorityNormal)
-        { m_pidsConditionalAccess[pid] = priority; }
+        { m_pidsConditionalAccess[pid] = priority;
+          SetPIDRole(pid, kPIDRoleConditionalAccess, true); }
 
-    virtual void RemoveListeningPID(uint pid) { m_pidsListening.remove(pid);  }
+    virtual void RemoveListeningPID(uint pid)
+        { m_pidsListening.remove(pid);
+          SetPIDRole(pid, kPIDRoleListening, false); }
     virtual void RemoveNotListeningPID(uint pid)
-        { m_pidsNotListening.remove(pid); }
-    virtual void RemoveWritingPID(uint pid) { m_pidsWriting.remove(pid);    }
-    virtual void RemoveAudioPID(uint pid)   { m_pidsAudio.remove(pid);      }
+        { m_pidsNotListening.remove(pid);
+          SetPIDRole(pid, kPIDRoleNotListening, false); }
+    virtual void RemoveWritingPID(uint pid)
+        { m_pidsWriting.remove(pid);
+          SetPIDRole(pid, kPIDRoleWriting, false); }
+    virtual void RemoveAudioPID(uint pid)
+        { m_pidsAudio.remove(pid);
+          SetPIDRole(pid, kPIDRoleAudio, false); }
 
     virtual bool IsListeningPID(uint pid) const;
     virtual bool IsNotListeningPID(uint pid) const;
@@ -153,6 +179,9 @@ class MTV_PUBLIC MPEGStreamData : public EITSource
         { return m_pidsWriting; }
 
     uint GetPIDs(pid_map_t &pids) const;
+    /// Returns the PIDRole flags of a PID, for PIDs found in a TSPacket
+    uint GetPIDRoles(uint pid) const
+        { return (pid < kPIDCount) ? m_pidRoles[pid] : kPIDRoleNone; }
 
     // PID Priorities
     PIDPriority GetPIDPriority(uint pid) const;
@@ -294,6 +323,18 @@ class MTV_PUBLIC MPEGStreamData : public EITSource
 
     static int ResyncStream(const unsigned char *buffer, int curr_pos, int len);
 
+    // PID dispatch table
+    void SetPIDRole(uint pid, PIDRole role, bool on)
+    {
+        if (pid >= kPIDCount)
+            return;
+        if (on)
+            m_pidRoles[pid] |= role;
+        else
+            m_pidRoles[pid] &= ~role;
+    }
+    void RebuildPIDRoles(void);
+
     void UpdateTimeOffset(uint64_t si_utc_time);
 
     // Caching
@@ -326,6 +367,11 @@ class MTV_PUBLIC MPEGStreamData : public EITSource
     pid_map_t                 m_pidsConditionalAccess;
     bool                      m_listeningDisabled           {false};
 
+    /// PIDRole flags for every 13 bit PID, kept in sync with the
+    /// maps above so ProcessTSPacket() needs only one lookup per packet.
+    static constexpr uint     kPIDCount                     {0x2000};
+    std::array<uint8_t,kPIDCount> m_pidRoles                {};
+
     // Encryption monitoring
 #if QT_VERSION < QT_VERSION_CHECK(5,14,0)
     mutable QMutex            m_encryptionLock              {QMutex::Recursive};
@@ -0,0 +1,101 @@
+// -*- Mode: c++ -*-
+
+#include "config.h"
+#include "tssync.h"
+#include "tspacket.h"
+
+extern "C" {
+#include "libavutil/cpu.h"
+}
+
+#if (HAVE_SSE2 && ARCH_X86_64)
+#include "libavutil/x86/cpu.h"
+#include <emmintrin.h>
+bool TSSync::s_haveSIMD = (av_get_cpu_flags() & AV_CPU_FLAG_SSE2) != 0;
+#elif HAVE_INTRINSICS_NEON
+#if ARCH_AARCH64
+#include "libavutil/aarch64/cpu.h"
+#elif ARCH_ARM
+#include "libavutil/arm/cpu.h"
+#endif
+#include <arm_neon.h>
+bool TSSync::s_haveSIMD = have_neon(av_get_cpu_flags());
+#else
+bool TSSync::s_haveSIMD = false;
+#endif
+
+/** \fn TSSync::FindSyncScalar(const unsigned char*,int,int)
+ *  \brief Searches for two sync bytes 188 bytes apart, one byte at a time.
+ *
+ *  \return position of the first sync byte, -1 if there are not
+ *          enough bytes to search or -2 if no sync was found.
+ */
+int TSSync::FindSyncScalar(const unsigned char *buffer, int pos, int len)
+{
+    int nextpos = pos + TSPacket::kSize;
+    if (nextpos >= len)
+        return -1; // not enough bytes; caller should try again
+
+    while (buffer[pos] != SYNC_BYTE || buffer[nextpos] != SYNC_BYTE)
+    {
+        pos++;
+        nextpos++;
+        if (nextpos == len)
+            return -2; // not found
+    }
+
+    return pos;
+}
+
+/** \fn TSSync::FindSync(const unsigned char*,int,int)
+ *  \brief Searches for two sync bytes 188 bytes apart, 16 bytes at a
+ *         time when SIMD is available.
+ *
+ *  Returns the same results as FindSyncScalar().
+ */
+int TSSync::FindSync(const unsigned char *buffer, int pos, int len)
+{
+    if (pos + int(TSPacket::kSize) >= len)
+        return -1; // not enough bytes; caller should try again
+
+#if (HAVE_SSE2 && ARCH_X86_64) || HAVE_INTRINSICS_NEON
+    if (s_haveSIMD)
+    {
+        // Compare 16 candidate positions, and the bytes a packet
+        // after them, per pass.
+        const int last = len - TSPacket::kSize - 16;
+#if (HAVE_SSE2 && ARCH_X86_64)
+        const __m128i sync = _mm_set1_epi8(SYNC_BYTE);
+        for (; pos <= last; pos += 16)
+        {
+            __m128i here = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(buffer + pos));
+            __m128i next = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(buffer + pos + TSPacket::kSize));
+            __m128i both = _mm_and_si128(_mm_cmpeq_epi8(here, sync),
+                                         _mm_cmpeq_epi8(next, sync));
+            int mask = _mm_movemask_epi8(both);
+            if (mask)
+                return pos + __builtin_ctz(static_cast<unsigned>(mask));
+        }
+#endif
+#if HAVE_INTRINSICS_NEON
+        const uint8x16_t sync = vdupq_n_u8(SYNC_BYTE);
+        for (; pos <= last; pos += 16)
+        {
+            uint8x16_t here = vld1q_u8(buffer + pos);
+            uint8x16_t next = vld1q_u8(buffer + pos + TSPacket::kSize);
+            uint8x16_t both = vandq_u8(vceqq_u8(here, sync),
+                                       vceqq_u8(next, sync));
+            uint8x8_t any = vorr_u8(vget_low_u8(both), vget_high_u8(both));
+            if (vget_lane_u64(vreinterpret_u64_u8(any), 0))
+                break; // the scalar search below finds the exact byte
+        }
+#endif
+        if (pos + int(TSPacket::kSize) >= len)
+            return -2; // not found
+    }
+#endif
+
+    return FindSyncScalar(buffer, pos, len);
+}
@@ -0,0 +1,24 @@
+// -*- Mode: c++ -*-
+#ifndef TS_SYNC_H
+#define TS_SYNC_H
+
+#include "mythtvexp.h"
+
+/** \class TSSync
+ *  \brief Finds transport stream packet boundaries in read blocks.
+ *
+ *  The sync search uses SSE2 or NEON when available, with a scalar
+ *  fallback that gives identical results.
+ */
+class MTV_PUBLIC TSSync
+{
+  public:
+    static int FindSync(const unsigned char *buffer, int pos, int len);
+    static int FindSyncScalar(const unsigned char *buffer, int pos, int len);
+    static bool HaveSIMD(void) { return s_haveSIMD; }
+
+  private:
+    static bool s_haveSIMD;
+};
+
+#endif // TS_SYNC_H
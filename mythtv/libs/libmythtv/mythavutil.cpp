@@ -235,7 +235,45 @@ int MythAVCopy::Copy(AVFrame* To, const MythVideoFrame* From,
     AVPixelFormat fromfmt = MythAVUtil::FrameTypeToPixelFormat(From->m_type);
     MythAVUtil::FillAVFrame(&frame, From, fromfmt);
     av_image_fill_arrays(To->data, To->linesize, Buffer, Fmt, From->m_width, From->m_height, IMAGE_ALIGN);
-    return Copy(To, Fmt, &frame, fromfmt, From->m_width, From->m_height);
+
+    // Conversions between semi planar and planar formats only move samples
+    // around, which doesn't need swscale
+    int width    = From->m_width;
+    int height   = From->m_height;
+    int uvwidth  = (width + 1) >> 1;
+    int uvheight = (height + 1) >> 1;
+    const uint8_t* buffer = From->m_buffer;
+    if ((From->m_type == FMT_NV12 && Fmt == AV_PIX_FMT_YUV420P) ||
+        (From->m_type == FMT_P010 && Fmt == AV_PIX_FMT_YUV420P10))
+    {
+        int depth = MythVideoFrame::ColorDepth(From->m_type);
+        if (depth > 8)
+        {
+            MythVideoFrame::ShiftPlane(To->data[0], To->linesize[0], buffer + From->m_offsets[0],
+                                       From->m_pitches[0], width, height, depth - 16);
+        }
+        else
+        {
+            MythVideoFrame::CopyPlane(To->data[0], To->linesize[0], buffer + From->m_offsets[0],
+                                      From->m_pitches[0], width, height);
+        }
+        MythVideoFrame::SplitPlane(To->data[1], To->linesize[1], To->data[2], To->linesize[2],
+                                   buffer + From->m_offsets[1], From->m_pitches[1],
+                                   uvwidth, uvheight, depth);
+        return SizeData(width, height, Fmt);
+    }
+    if (From->m_type == FMT_YV12 && Fmt == AV_PIX_FMT_NV12)
+    {
+        MythVideoFrame::CopyPlane(To->data[0], To->linesize[0], buffer + From->m_offsets[0],
+                                  From->m_pitches[0], width, height);
+        MythVideoFrame::MergePlanes(To->data[1], To->linesize[1],
+                                    buffer + From->m_offsets[1], From->m_pitches[1],
+                                    buffer + From->m_offsets[2], From->m_pitches[2],
+                                    uvwidth, uvheight);
+        return SizeData(width, height, Fmt);
+    }
+
+    return Copy(To, Fmt, &frame, fromfmt, width, height);
 }
 
 /*! \class MythCodecMap
@@ -319,6 +357,55 @@ void MythCodecMap::FreeAllContexts()
     }
 }
 
+/*! \class MythAVPacketPool
+ * Keeps the AVPackets a decoder is done with, so that reading and storing
+ * packets reuses them instead of allocating new ones.  Packet data is owned
+ * by the reference counted buffers FFmpeg attaches to them, which Put()
+ * releases.  Not thread safe, except for GetAllocationRate().
+*/
+MythAVPacketPool::~MythAVPacketPool()
+{
+    for (auto *packet : m_packets)
+        av_packet_free(&packet);
+}
+
+/// Returns an empty packet
+AVPacket *MythAVPacketPool::Get(void)
+{
+    if (!m_rateTimer.isRunning())
+        m_rateTimer.start();
+    else if (m_rateTimer.elapsed() >= 1s)
+    {
+        m_allocationRate = static_cast<int>(m_allocations * 1000 / m_rateTimer.elapsed().count());
+        m_allocations = 0;
+        m_rateTimer.start();
+    }
+
+    if (!m_packets.empty())
+    {
+        AVPacket *packet = m_packets.back();
+        m_packets.pop_back();
+        return packet;
+    }
+
+    m_allocations++;
+    return av_packet_alloc();
+}
+
+/// Releases the data of a packet from Get() and keeps it for reuse
+void MythAVPacketPool::Put(AVPacket *Packet)
+{
+    if (!Packet)
+        return;
+    if (m_packets.size() >= kMaxPackets)
+    {
+        av_packet_free(&Packet);
+        return;
+    }
+    av_packet_unref(Packet);
+    m_packets.push_back(Packet);
+}
+
 MythStreamInfoList::MythStreamInfoList(const QString& filename)
 {
     const int probeBufferSize = 8 * 1024;
@@ -1,6 +1,10 @@
 #ifndef MYTHAVUTIL_H
 #define MYTHAVUTIL_H
 
+// Std
+#include <atomic>
+#include <vector>
+
 // Qt
 #include <QMap>
 #if QT_VERSION < QT_VERSION_CHECK(5,14,0)
@@ -11,6 +15,7 @@
 #include <QVector>
 
 // MythTV
+#include "mythtimer.h"
 #include "mythframe.h"
 #include "mythhdr.h"
 
@@ -65,6 +70,25 @@ class MTV_PUBLIC MythAVCopy
     int           m_size    { 0 };
 };
 
+class MTV_PUBLIC MythAVPacketPool
+{
+  public:
+    MythAVPacketPool() = default;
+   ~MythAVPacketPool();
+    AVPacket* Get(void);
+    void      Put(AVPacket* Packet);
+    int       GetAllocationRate(void) const { return m_allocationRate; }
+
+  private:
+    Q_DISABLE_COPY(MythAVPacketPool)
+    static constexpr size_t kMaxPackets { 64 };
+
+    std::vector<AVPacket*> m_packets;
+    MythTimer        m_rateTimer;
+    int              m_allocations    { 0 };
+    std::atomic<int> m_allocationRate { 0 };
+};
+
 class MTV_PUBLIC MythAVUtil
 {
   public:
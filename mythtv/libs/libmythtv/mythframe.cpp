@@ -1,4 +1,8 @@
+// Std
+#include <cstdlib>
+
 // MythTV
+#include "config.h"
 #include "mythlogging.h"
 #include "mythvideoprofile.h"
 #include "mythframe.h"
@@ -6,8 +10,25 @@
 // FFmpeg - for av_malloc/av_free
 extern "C" {
 #include "libavcodec/avcodec.h"
+#include "libavutil/cpu.h"
 }
 
+#if (HAVE_SSE2 && ARCH_X86_64)
+#include "libavutil/x86/cpu.h"
+#include <emmintrin.h>
+bool MythVideoFrame::s_haveSIMD = (av_get_cpu_flags() & AV_CPU_FLAG_SSE2) != 0;
+#elif HAVE_INTRINSICS_NEON
+#if ARCH_AARCH64
+#include "libavutil/aarch64/cpu.h"
+#elif ARCH_ARM
+#include "libavutil/arm/cpu.h"
+#endif
+#include <arm_neon.h>
+bool MythVideoFrame::s_haveSIMD = have_neon(av_get_cpu_flags());
+#else
+bool MythVideoFrame::s_haveSIMD = false;
+#endif
+
 #define LOC QString("VideoFrame: ")
 
 /*! \class MythVideoFrame
@@ -202,6 +223,243 @@ void MythVideoFrame::CopyPlane(uint8_t *To, int ToPitch, const uint8_t *From, in
     }
 }
 
+static void SplitRow8(uint8_t* U, uint8_t* V, const uint8_t* UV, int Width, [[maybe_unused]] bool SIMD)
+{
+    int x = 0;
+#if (HAVE_SSE2 && ARCH_X86_64)
+    if (SIMD)
+    {
+        const __m128i mask = _mm_set1_epi16(0x00ff);
+        for (; x + 16 <= Width; x += 16)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(UV + (2 * x)));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(UV + (2 * x) + 16));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(U + x),
+                             _mm_packus_epi16(_mm_and_si128(a, mask), _mm_and_si128(b, mask)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(V + x),
+                             _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8)));
+        }
+    }
+#endif
+#if HAVE_INTRINSICS_NEON
+    if (SIMD)
+    {
+        for (; x + 16 <= Width; x += 16)
+        {
+            uint8x16x2_t uv = vld2q_u8(UV + (2 * x));
+            vst1q_u8(U + x, uv.val[0]);
+            vst1q_u8(V + x, uv.val[1]);
+        }
+    }
+#endif
+    for (; x < Width; x++)
+    {
+        U[x] = UV[2 * x];
+        V[x] = UV[(2 * x) + 1];
+    }
+}
+
+static void MergeRow8(uint8_t* UV, const uint8_t* U, const uint8_t* V, int Width, [[maybe_unused]] bool SIMD)
+{
+    int x = 0;
+#if (HAVE_SSE2 && ARCH_X86_64)
+    if (SIMD)
+    {
+        for (; x + 16 <= Width; x += 16)
+        {
+            __m128i u = _mm_loadu_si128(reinterpret_cast<const __m128i*>(U + x));
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(V + x));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(UV + (2 * x)), _mm_unpacklo_epi8(u, v));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(UV + (2 * x) + 16), _mm_unpackhi_epi8(u, v));
+        }
+    }
+#endif
+#if HAVE_INTRINSICS_NEON
+    if (SIMD)
+    {
+        for (; x + 16 <= Width; x += 16)
+        {
+            uint8x16x2_t uv { vld1q_u8(U + x), vld1q_u8(V + x) };
+            vst2q_u8(UV + (2 * x), uv);
+        }
+    }
+#endif
+    for (; x < Width; x++)
+    {
+        UV[2 * x]       = U[x];
+        UV[(2 * x) + 1] = V[x];
+    }
+}
+
+static void SplitRow16(uint16_t* U, uint16_t* V, const uint16_t* UV, int Width, int Shift, [[maybe_unused]] bool SIMD)
+{
+    int x = 0;
+#if (HAVE_SSE2 && ARCH_X86_64)
+    if (SIMD)
+    {
+        const __m128i shift = _mm_cvtsi32_si128(Shift);
+        for (; x + 8 <= Width; x += 8)
+        {
+            // u0 v0 u1 v1 u2 v2 u3 v3 -> u0 u1 u2 u3 v0 v1 v2 v3
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(UV + (2 * x)));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(UV + (2 * x) + 8));
+            a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(a, _MM_SHUFFLE(3, 1, 2, 0)), _MM_SHUFFLE(3, 1, 2, 0));
+            b = _mm_shufflehi_epi16(_mm_shufflelo_epi16(b, _MM_SHUFFLE(3, 1, 2, 0)), _MM_SHUFFLE(3, 1, 2, 0));
+            a = _mm_shuffle_epi32(a, _MM_SHUFFLE(3, 1, 2, 0));
+            b = _mm_shuffle_epi32(b, _MM_SHUFFLE(3, 1, 2, 0));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(U + x), _mm_srl_epi16(_mm_unpacklo_epi64(a, b), shift));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(V + x), _mm_srl_epi16(_mm_unpackhi_epi64(a, b), shift));
+        }
+    }
+#endif
+#if HAVE_INTRINSICS_NEON
+    if (SIMD)
+    {
+        const int16x8_t shift = vdupq_n_s16(static_cast<int16_t>(-Shift));
+        for (; x + 8 <= Width; x += 8)
+        {
+            uint16x8x2_t uv = vld2q_u16(UV + (2 * x));
+            vst1q_u16(U + x, vshlq_u16(uv.val[0], shift));
+            vst1q_u16(V + x, vshlq_u16(uv.val[1], shift));
+        }
+    }
+#endif
+    for (; x < Width; x++)
+    {
+        U[x] = static_cast<uint16_t>(UV[2 * x] >> Shift);
+        V[x] = static_cast<uint16_t>(UV[(2 * x) + 1] >> Shift);
+    }
+}
+
+static void MergeRow16(uint16_t* UV, const uint16_t* U, const uint16_t* V, int Width, int Shift, [[maybe_unused]] bool SIMD)
+{
+    int x = 0;
+#if (HAVE_SSE2 && ARCH_X86_64)
+    if (SIMD)
+    {
+        const __m128i shift = _mm_cvtsi32_si128(Shift);
+        for (; x + 8 <= Width; x += 8)
+        {
+            __m128i u = _mm_sll_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(U + x)), shift);
+            __m128i v = _mm_sll_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(V + x)), shift);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(UV + (2 * x)), _mm_unpacklo_epi16(u, v));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(UV + (2 * x) + 8), _mm_unpackhi_epi16(u, v));
+        }
+    }
+#endif
+#if HAVE_INTRINSICS_NEON
+    if (SIMD)
+    {
+        const int16x8_t shift = vdupq_n_s16(static_cast<int16_t>(Shift));
+        for (; x + 8 <= Width; x += 8)
+        {
+            uint16x8x2_t uv { vshlq_u16(vld1q_u16(U + x), shift), vshlq_u16(vld1q_u16(V + x), shift) };
+            vst2q_u16(UV + (2 * x), uv);
+        }
+    }
+#endif
+    for (; x < Width; x++)
+    {
+        UV[2 * x]       = static_cast<uint16_t>(U[x] << Shift);
+        UV[(2 * x) + 1] = static_cast<uint16_t>(V[x] << Shift);
+    }
+}
+
+static void ShiftRow16(uint16_t* To, const uint16_t* From, int Width, int Shift, [[maybe_unused]] bool SIMD)
+{
+    int x = 0;
+#if (HAVE_SSE2 && ARCH_X86_64)
+    if (SIMD)
+    {
+        const __m128i shift = _mm_cvtsi32_si128(std::abs(Shift));
+        for (; x + 8 <= Width; x += 8)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(From + x));
+            v = (Shift > 0) ? _mm_sll_epi16(v, shift) : _mm_srl_epi16(v, shift);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(To + x), v);
+        }
+    }
+#endif
+#if HAVE_INTRINSICS_NEON
+    if (SIMD)
+    {
+        const int16x8_t shift = vdupq_n_s16(static_cast<int16_t>(Shift));
+        for (; x + 8 <= Width; x += 8)
+            vst1q_u16(To + x, vshlq_u16(vld1q_u16(From + x), shift));
+    }
+#endif
+    for (; x < Width; x++)
+        To[x] = static_cast<uint16_t>((Shift > 0) ? (From[x] << Shift) : (From[x] >> -Shift));
+}
+
+/*! \brief Splits an interleaved chroma plane (NV12, P010) into separate U and V planes.
+ *
+ * Width is the number of chroma samples per row.  With a Depth above 8 the
+ * samples are 16 bit, most significant bit aligned in the interleaved plane
+ * (as in P010) and least significant bit aligned in the separate planes (as
+ * in YUV420P10).
+*/
+void MythVideoFrame::SplitPlane(uint8_t* ToU, int ToUPitch, uint8_t* ToV, int ToVPitch,
+                                const uint8_t* From, int FromPitch, int Width, int Height,
+                                int Depth)
+{
+    for (int y = 0; y < Height; y++)
+    {
+        if (Depth > 8)
+        {
+            SplitRow16(reinterpret_cast<uint16_t*>(ToU), reinterpret_cast<uint16_t*>(ToV),
+                       reinterpret_cast<const uint16_t*>(From), Width, 16 - Depth, s_haveSIMD);
+        }
+        else
+        {
+            SplitRow8(ToU, ToV, From, Width, s_haveSIMD);
+        }
+        ToU  += ToUPitch;
+        ToV  += ToVPitch;
+        From += FromPitch;
+    }
+}
+
+/// \brief Interleaves separate U and V planes into one chroma plane, the reverse of SplitPlane.
+void MythVideoFrame::MergePlanes(uint8_t* To, int ToPitch, const uint8_t* FromU, int FromUPitch,
+                                 const uint8_t* FromV, int FromVPitch, int Width, int Height,
+                                 int Depth)
+{
+    for (int y = 0; y < Height; y++)
+    {
+        if (Depth > 8)
+        {
+            MergeRow16(reinterpret_cast<uint16_t*>(To), reinterpret_cast<const uint16_t*>(FromU),
+                       reinterpret_cast<const uint16_t*>(FromV), Width, 16 - Depth, s_haveSIMD);
+        }
+        else
+        {
+            MergeRow8(To, FromU, FromV, Width, s_haveSIMD);
+        }
+        To    += ToPitch;
+        FromU += FromUPitch;
+        FromV += FromVPitch;
+    }
+}
+
+/*! \brief Copies a plane of 16 bit samples, shifting them left (positive Shift)
+ * or right (negative Shift).
+ *
+ * Converts between most significant bit aligned (P010) and least significant
+ * bit aligned (YUV420P10) luma. Width is the number of samples per row.
+*/
+void MythVideoFrame::ShiftPlane(uint8_t* To, int ToPitch, const uint8_t* From, int FromPitch,
+                                int Width, int Height, int Shift)
+{
+    for (int y = 0; y < Height; y++)
+    {
+        ShiftRow16(reinterpret_cast<uint16_t*>(To), reinterpret_cast<const uint16_t*>(From),
+                   Width, Shift, s_haveSIMD);
+        To   += ToPitch;
+        From += FromPitch;
+    }
+}
+
 void MythVideoFrame::ClearBufferToBlank()
 {
     if (!m_buffer)
@@ -108,6 +108,15 @@ class MTV_PUBLIC MythVideoFrame
 
     static void     CopyPlane(uint8_t* To, int ToPitch, const uint8_t* From, int FromPitch,
                               int PlaneWidth, int PlaneHeight);
+    static void     SplitPlane(uint8_t* ToU, int ToUPitch, uint8_t* ToV, int ToVPitch,
+                               const uint8_t* From, int FromPitch, int Width, int Height,
+                               int Depth = 8);
+    static void     MergePlanes(uint8_t* To, int ToPitch, const uint8_t* FromU, int FromUPitch,
+                                const uint8_t* FromV, int FromVPitch, int Width, int Height,
+                                int Depth = 8);
+    static void     ShiftPlane(uint8_t* To, int ToPitch, const uint8_t* From, int FromPitch,
+                               int Width, int Height, int Shift);
+    static bool     HaveSIMD() { return s_haveSIMD; }
     static QString  FormatDescription(VideoFrameType Type);
     static uint8_t* GetAlignedBuffer(size_t Size);
     static uint8_t* CreateBuffer(VideoFrameType Type, int Width, int Height);
@@ -477,6 +486,7 @@ class MTV_PUBLIC MythVideoFrame
 
   private:
     static MythDeintType GetDeinterlacer(MythDeintType Option);
+    static bool s_haveSIMD;
 };
 
 #endif
@@ -805,7 +805,10 @@ void MythPlayerUI::GetPlaybackData(InfoMap& Map)
         Map.insert("videoframes", frames);
     }
     if (m_decoder)
+    {
         Map["videodecoder"] = m_decoder->GetCodecDecoderName();
+        Map["packetallocs"] = QString::number(m_decoder->GetPacketAllocationRate());
+    }
 
     Map["framerate"] = QString("%1%2%3")
             .arg(static_cast<double>(m_outputJmeter.GetLastFPS()), 0, 'f', 2).arg(QChar(0xB1, 0))
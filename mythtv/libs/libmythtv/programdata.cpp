@@ -427,6 +427,16 @@ uint DBEvent::UpdateDB(
 //
 uint DBEvent::GetOverlappingPrograms(
     MSqlQuery &query, uint chanid, std::vector<DBEvent> &programs) const
+{
+    return GetOverlappingPrograms(query, chanid, m_starttime, m_endtime,
+                                  programs);
+}
+
+// Get all programs in the database that overlap with the time span
+// starttime to endtime, in the same three ways as above.
+uint DBEvent::GetOverlappingPrograms(
+    MSqlQuery &query, uint chanid, const QDateTime &starttime,
+    const QDateTime &endtime, std::vector<DBEvent> &programs)
 {
     uint count = 0;
     query.prepare(
@@ -449,12 +459,12 @@ uint DBEvent::GetOverlappingPrograms(
         "        ( endtime   >  :STIME2 AND endtime   <= :ETIME2 ) OR "
         "        ( starttime <  :STIME3 AND endtime   >  :ETIME3 ) )");
     query.bindValue(":CHANID", chanid);
-    query.bindValue(":STIME1", m_starttime);
-    query.bindValue(":ETIME1", m_endtime);
-    query.bindValue(":STIME2", m_starttime);
-    query.bindValue(":ETIME2", m_endtime);
-    query.bindValue(":STIME3", m_starttime);
-    query.bindValue(":ETIME3", m_endtime);
+    query.bindValue(":STIME1", starttime);
+    query.bindValue(":ETIME1", endtime);
+    query.bindValue(":STIME2", starttime);
+    query.bindValue(":ETIME2", endtime);
+    query.bindValue(":STIME3", starttime);
+    query.bindValue(":ETIME3", endtime);
 
     if (!query.exec())
     {
@@ -745,102 +755,113 @@ static int change_record(MSqlQuery &query, uint chanid,
     return rows;
 }
 
-// Update matched item with current data.
+// Combine our data with that of the matched program, our data wins
+// where we have it.
 //
-uint DBEvent::UpdateDB(
-    MSqlQuery &query, uint chanid, const DBEvent &match)  const
+DBEvent DBEvent::Merge(const DBEvent &match) const
 {
-    QString  ltitle           = m_title;
-    QString  lsubtitle        = m_subtitle;
-    QString  ldesc            = m_description;
-    QString  lcategory        = m_category;
-    uint16_t lairdate         = m_airdate;
-    QString  lprogramId       = m_programId;
-    QString  lseriesId        = m_seriesId;
-    QString  linetref         = m_inetref;
-    QDate    loriginalairdate = m_originalairdate;
-
-    // Update starttime also in database table record so that
-    // tables program and record remain consistent.
-    if (m_starttime != match.m_starttime)
-    {
-        QDateTime const &old_starttime = match.m_starttime;
-        QDateTime const &new_starttime = m_starttime;
-        change_record(query, chanid, old_starttime, new_starttime);
+    DBEvent merged(m_listingsource | match.m_listingsource);
 
-        LOG(VB_EIT, LOG_DEBUG,
-            QString("EIT: (U) change starttime from %1 to %2 for chanid:%3 program '%4' ")
-                    .arg(old_starttime.toString(Qt::ISODate),
-                         new_starttime.toString(Qt::ISODate),
-                         QString::number(chanid),
-                         m_title.left(35)));
-    }
+    merged.m_title       = m_title;
+    merged.m_subtitle    = m_subtitle;
+    merged.m_description = m_description;
+    merged.m_category    = m_category;
+    merged.m_starttime   = m_starttime;
+    merged.m_endtime     = m_endtime;
+    merged.m_airdate     = m_airdate;
+    merged.m_programId   = m_programId;
+    merged.m_seriesId    = m_seriesId;
+    merged.m_inetref     = m_inetref;
+    merged.m_originalairdate = m_originalairdate;
+    merged.m_stars       = match.m_stars;
 
-    if (ltitle.isEmpty() && !match.m_title.isEmpty())
-        ltitle = match.m_title;
+    if (merged.m_title.isEmpty() && !match.m_title.isEmpty())
+        merged.m_title = match.m_title;
 
-    if (lsubtitle.isEmpty() && !match.m_subtitle.isEmpty())
-        lsubtitle = match.m_subtitle;
+    if (merged.m_subtitle.isEmpty() && !match.m_subtitle.isEmpty())
+        merged.m_subtitle = match.m_subtitle;
 
-    if (ldesc.isEmpty() && !match.m_description.isEmpty())
-        ldesc = match.m_description;
+    if (merged.m_description.isEmpty() && !match.m_description.isEmpty())
+        merged.m_description = match.m_description;
 
-    if (lcategory.isEmpty() && !match.m_category.isEmpty())
-        lcategory = match.m_category;
+    if (merged.m_category.isEmpty() && !match.m_category.isEmpty())
+        merged.m_category = match.m_category;
 
-    if (!lairdate && match.m_airdate)
-        lairdate = match.m_airdate;
+    if (!merged.m_airdate && match.m_airdate)
+        merged.m_airdate = match.m_airdate;
 
-    if (!loriginalairdate.isValid() && match.m_originalairdate.isValid())
-        loriginalairdate = match.m_originalairdate;
+    if (!merged.m_originalairdate.isValid() && match.m_originalairdate.isValid())
+        merged.m_originalairdate = match.m_originalairdate;
 
-    if (lprogramId.isEmpty() && !match.m_programId.isEmpty())
-        lprogramId = match.m_programId;
+    if (merged.m_programId.isEmpty() && !match.m_programId.isEmpty())
+        merged.m_programId = match.m_programId;
 
-    if (lseriesId.isEmpty() && !match.m_seriesId.isEmpty())
-        lseriesId = match.m_seriesId;
+    if (merged.m_seriesId.isEmpty() && !match.m_seriesId.isEmpty())
+        merged.m_seriesId = match.m_seriesId;
 
-    if (linetref.isEmpty() && !match.m_inetref.isEmpty())
-        linetref= match.m_inetref;
+    if (merged.m_inetref.isEmpty() && !match.m_inetref.isEmpty())
+        merged.m_inetref = match.m_inetref;
 
-    ProgramInfo::CategoryType tmp = m_categoryType;
+    merged.m_categoryType = m_categoryType;
     if (!m_categoryType && match.m_categoryType)
-        tmp = match.m_categoryType;
+        merged.m_categoryType = match.m_categoryType;
 
-    QString lcattype = myth_category_type_to_string(tmp);
+    merged.m_subtitleType = m_subtitleType | match.m_subtitleType;
+    merged.m_audioProps   = m_audioProps   | match.m_audioProps;
+    merged.m_videoProps   = m_videoProps   | match.m_videoProps;
 
-    unsigned char lsubtype = m_subtitleType | match.m_subtitleType;
-    unsigned char laudio   = m_audioProps   | match.m_audioProps;
-    unsigned char lvideo   = m_videoProps   | match.m_videoProps;
-
-    uint lseason = match.m_season;
-    uint lepisode = match.m_episode;
-    uint lepisodeTotal = match.m_totalepisodes;
+    merged.m_season        = match.m_season;
+    merged.m_episode       = match.m_episode;
+    merged.m_totalepisodes = match.m_totalepisodes;
 
     if (m_season || m_episode || m_totalepisodes)
     {
-        lseason = m_season;
-        lepisode = m_episode;
-        lepisodeTotal = m_totalepisodes;
+        merged.m_season        = m_season;
+        merged.m_episode       = m_episode;
+        merged.m_totalepisodes = m_totalepisodes;
     }
 
-    uint lpartnumber = match.m_partnumber;
-    uint lparttotal = match.m_parttotal;
+    merged.m_partnumber = match.m_partnumber;
+    merged.m_parttotal  = match.m_parttotal;
 
     if (m_partnumber || m_parttotal)
     {
-        lpartnumber = m_partnumber;
-        lparttotal  = m_parttotal;
+        merged.m_partnumber = m_partnumber;
+        merged.m_parttotal  = m_parttotal;
     }
 
-    bool lpreviouslyshown = m_previouslyshown || match.m_previouslyshown;
-
-    uint32_t llistingsource = m_listingsource | match.m_listingsource;
+    merged.m_previouslyshown = m_previouslyshown || match.m_previouslyshown;
 
-    QString lsyndicatedepisodenumber = m_syndicatedepisodenumber;
-    if (lsyndicatedepisodenumber.isEmpty() &&
+    merged.m_syndicatedepisodenumber = m_syndicatedepisodenumber;
+    if (merged.m_syndicatedepisodenumber.isEmpty() &&
         !match.m_syndicatedepisodenumber.isEmpty())
-        lsyndicatedepisodenumber = match.m_syndicatedepisodenumber;
+        merged.m_syndicatedepisodenumber = match.m_syndicatedepisodenumber;
+
+    return merged;
+}
+
+// Update matched item with current data.
+//
+uint DBEvent::UpdateDB(
+    MSqlQuery &query, uint chanid, const DBEvent &match)  const
+{
+    // Update starttime also in database table record so that
+    // tables program and record remain consistent.
+    if (m_starttime != match.m_starttime)
+    {
+        QDateTime const &old_starttime = match.m_starttime;
+        QDateTime const &new_starttime = m_starttime;
+        change_record(query, chanid, old_starttime, new_starttime);
+
+        LOG(VB_EIT, LOG_DEBUG,
+            QString("EIT: (U) change starttime from %1 to %2 for chanid:%3 program '%4' ")
+                    .arg(old_starttime.toString(Qt::ISODate),
+                         new_starttime.toString(Qt::ISODate),
+                         QString::number(chanid),
+                         m_title.left(35)));
+    }
+
+    DBEvent merged = Merge(match);
 
     query.prepare(
         "UPDATE program "
@@ -865,33 +886,33 @@ uint DBEvent::UpdateDB(
 
     query.bindValue(":CHANID",      chanid);
     query.bindValue(":OLDSTART",    match.m_starttime);
-    query.bindValue(":TITLE",       denullify(ltitle));
-    query.bindValue(":SUBTITLE",    denullify(lsubtitle));
-    query.bindValue(":DESC",        denullify(ldesc));
-    query.bindValue(":CATEGORY",    denullify(lcategory));
-    query.bindValue(":CATTYPE",     lcattype);
-    query.bindValue(":STARTTIME",   m_starttime);
-    query.bindValue(":ENDTIME",     m_endtime);
-    query.bindValue(":CC",          (lsubtype & SUB_HARDHEAR) != 0);
-    query.bindValue(":HASSUBTITLES",(lsubtype & SUB_NORMAL) != 0);
-    query.bindValue(":STEREO",      (laudio   & AUD_STEREO) != 0);
-    query.bindValue(":HDTV",        (lvideo   & VID_HDTV) != 0);
-    query.bindValue(":SUBTYPE",     lsubtype);
-    query.bindValue(":AUDIOPROP",   laudio);
-    query.bindValue(":VIDEOPROP",   lvideo);
-    query.bindValue(":SEASON",      lseason);
-    query.bindValue(":EPISODE",     lepisode);
-    query.bindValue(":TOTALEPS",    lepisodeTotal);
-    query.bindValue(":PARTNO",      lpartnumber);
-    query.bindValue(":PARTTOTAL",   lparttotal);
-    query.bindValue(":SYNDICATENO", denullify(lsyndicatedepisodenumber));
-    query.bindValue(":AIRDATE",     lairdate ? QString::number(lairdate) : "0000");
-    query.bindValue(":ORIGAIRDATE", loriginalairdate);
-    query.bindValue(":LSOURCE",     llistingsource);
-    query.bindValue(":SERIESID",    denullify(lseriesId));
-    query.bindValue(":PROGRAMID",   denullify(lprogramId));
-    query.bindValue(":PREVSHOWN",   lpreviouslyshown);
-    query.bindValue(":INETREF",     linetref);
+    query.bindValue(":TITLE",       denullify(merged.m_title));
+    query.bindValue(":SUBTITLE",    denullify(merged.m_subtitle));
+    query.bindValue(":DESC",        denullify(merged.m_description));
+    query.bindValue(":CATEGORY",    denullify(merged.m_category));
+    query.bindValue(":CATTYPE",     myth_category_type_to_string(merged.m_categoryType));
+    query.bindValue(":STARTTIME",   merged.m_starttime);
+    query.bindValue(":ENDTIME",     merged.m_endtime);
+    query.bindValue(":CC",          (merged.m_subtitleType & SUB_HARDHEAR) != 0);
+    query.bindValue(":HASSUBTITLES",(merged.m_subtitleType & SUB_NORMAL) != 0);
+    query.bindValue(":STEREO",      (merged.m_audioProps   & AUD_STEREO) != 0);
+    query.bindValue(":HDTV",        (merged.m_videoProps   & VID_HDTV) != 0);
+    query.bindValue(":SUBTYPE",     merged.m_subtitleType);
+    query.bindValue(":AUDIOPROP",   merged.m_audioProps);
+    query.bindValue(":VIDEOPROP",   merged.m_videoProps);
+    query.bindValue(":SEASON",      merged.m_season);
+    query.bindValue(":EPISODE",     merged.m_episode);
+    query.bindValue(":TOTALEPS",    merged.m_totalepisodes);
+    query.bindValue(":PARTNO",      merged.m_partnumber);
+    query.bindValue(":PARTTOTAL",   merged.m_parttotal);
+    query.bindValue(":SYNDICATENO", denullify(merged.m_syndicatedepisodenumber));
+    query.bindValue(":AIRDATE",     merged.m_airdate ? QString::number(merged.m_airdate) : "0000");
+    query.bindValue(":ORIGAIRDATE", merged.m_originalairdate);
+    query.bindValue(":LSOURCE",     merged.m_listingsource);
+    query.bindValue(":SERIESID",    denullify(merged.m_seriesId));
+    query.bindValue(":PROGRAMID",   denullify(merged.m_programId));
+    query.bindValue(":PREVSHOWN",   merged.m_previouslyshown);
+    query.bindValue(":INETREF",     merged.m_inetref);
 
     if (!query.exec())
     {
@@ -899,28 +920,7 @@ uint DBEvent::UpdateDB(
         return 0;
     }
 
-    if (m_credits)
-    {
-        for (auto & credit : *m_credits)
-            credit.InsertDB(query, chanid, m_starttime);
-    }
-
-    for (const auto & rating : qAsConst(m_ratings))
-    {
-        query.prepare(
-            "INSERT IGNORE INTO programrating "
-            "       ( chanid, starttime, `system`, rating) "
-            "VALUES (:CHANID, :START,    :SYS,  :RATING)");
-        query.bindValue(":CHANID", chanid);
-        query.bindValue(":START",  m_starttime);
-        query.bindValue(":SYS",    rating.m_system);
-        query.bindValue(":RATING", rating.m_rating);
-
-        if (!query.exec())
-            MythDB::DBError("programrating insert", query);
-    }
-
-    add_genres(query, m_genres, chanid, m_starttime);
+    InsertExtrasDB(query, chanid, false);
 
     return 1;
 }
@@ -1209,7 +1209,16 @@ uint DBEvent::InsertDB(MSqlQuery &query, uint chanid,
         return 0;
     }
 
-    table = recording ? "recordedrating" : "programrating";
+    InsertExtrasDB(query, chanid, recording);
+
+    return 1;
+}
+
+// Insert the ratings, credits and genres of a program.
+void DBEvent::InsertExtrasDB(MSqlQuery &query, uint chanid,
+                             bool recording) const
+{
+    QString table = recording ? "recordedrating" : "programrating";
     for (const auto & rating : qAsConst(m_ratings))
     {
         query.prepare(QString(
@@ -1232,8 +1241,320 @@ uint DBEvent::InsertDB(MSqlQuery &query, uint chanid,
     }
 
     add_genres(query, m_genres, chanid, m_starttime);
+}
 
-    return 1;
+// Columns of the program table written by upsert_programs(), in the
+// order of program_values().
+static const QStringList kProgramColumns
+{
+    "title",          "subtitle",      "description",
+    "category",       "category_type",
+    "starttime",      "endtime",
+    "closecaptioned", "stereo",        "hdtv",          "subtitled",
+    "subtitletypes",  "audioprop",     "videoprop",
+    "stars",          "partnumber",    "parttotal",
+    "syndicatedepisodenumber",
+    "airdate",        "originalairdate", "listingsource",
+    "seriesid",       "programid",     "previouslyshown",
+    "season",         "episode",       "totalepisodes",
+    "inetref",
+};
+
+static QVariantList program_values(const DBEvent &prog)
+{
+    return {
+        denullify(prog.m_title),
+        denullify(prog.m_subtitle),
+        denullify(prog.m_description),
+        denullify(prog.m_category),
+        myth_category_type_to_string(prog.m_categoryType),
+        prog.m_starttime,
+        prog.m_endtime,
+        (prog.m_subtitleType & SUB_HARDHEAR) != 0,
+        (prog.m_audioProps   & AUD_STEREO) != 0,
+        (prog.m_videoProps   & VID_HDTV) != 0,
+        (prog.m_subtitleType & SUB_NORMAL) != 0,
+        prog.m_subtitleType,
+        prog.m_audioProps,
+        prog.m_videoProps,
+        prog.m_stars,
+        prog.m_partnumber,
+        prog.m_parttotal,
+        denullify(prog.m_syndicatedepisodenumber),
+        prog.m_airdate ? QString::number(prog.m_airdate) : "0000",
+        prog.m_originalairdate,
+        prog.m_listingsource,
+        denullify(prog.m_seriesId),
+        denullify(prog.m_programId),
+        prog.m_previouslyshown,
+        prog.m_season,
+        prog.m_episode,
+        prog.m_totalepisodes,
+        prog.m_inetref,
+    };
+}
+
+// Insert new programs and update existing ones with one statement for
+// up to kRowsPerQuery programs. Existing programs get the columns set
+// that DBEvent::UpdateDB() sets, which leaves out the stars.
+static bool upsert_programs(MSqlQuery &query, uint chanid,
+                            const std::vector<DBEvent> &rows)
+{
+    static constexpr size_t kRowsPerQuery { 100 };
+
+    QStringList updates;
+    for (const auto & column : kProgramColumns)
+    {
+        if (column != "stars")
+            updates << QString("%1 = VALUES(%1)").arg(column);
+    }
+
+    for (size_t first = 0; first < rows.size(); first += kRowsPerQuery)
+    {
+        size_t last = std::min(rows.size(), first + kRowsPerQuery);
+
+        QStringList values;
+        for (size_t i = first; i < last; ++i)
+        {
+            QStringList holders(QString(":CHANID%1").arg(i - first));
+            for (const auto & column : kProgramColumns)
+                holders << QString(":%1%2").arg(column.toUpper()).arg(i - first);
+            values << QString("(%1)").arg(holders.join(", "));
+        }
+
+        query.prepare(QString(
+            "INSERT INTO program ( chanid, %1 ) "
+            "VALUES %2 "
+            "ON DUPLICATE KEY UPDATE %3")
+            .arg(kProgramColumns.join(", "), values.join(", "),
+                 updates.join(", ")));
+
+        for (size_t i = first; i < last; ++i)
+        {
+            QVariantList row = program_values(rows[i]);
+            query.bindValue(QString(":CHANID%1").arg(i - first), chanid);
+            for (int j = 0; j < kProgramColumns.size(); ++j)
+            {
+                query.bindValue(QString(":%1%2").arg(kProgramColumns[j].toUpper())
+                                .arg(i - first), row[j]);
+            }
+        }
+
+        if (!query.exec())
+        {
+            MythDB::DBError("upsert_programs", query);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Same overlap test as the query in DBEvent::GetOverlappingPrograms()
+static bool is_overlapping(const DBEvent &prog, const QDateTime &starttime,
+                           const QDateTime &endtime)
+{
+    return (prog.m_starttime >= starttime && prog.m_starttime <  endtime) ||
+           (prog.m_endtime   >  starttime && prog.m_endtime   <= endtime) ||
+           (prog.m_starttime <  starttime && prog.m_endtime   >  endtime);
+}
+
+// True if DBEvent::UpdateDB() would write the same values as already
+// in the database.
+static bool is_unchanged(const DBEvent &merged, const DBEvent &prog)
+{
+    return merged.m_title         == prog.m_title         &&
+           merged.m_subtitle      == prog.m_subtitle      &&
+           merged.m_description   == prog.m_description   &&
+           merged.m_category      == prog.m_category      &&
+           merged.m_categoryType  == prog.m_categoryType  &&
+           merged.m_starttime     == prog.m_starttime     &&
+           merged.m_endtime       == prog.m_endtime       &&
+           merged.m_subtitleType  == prog.m_subtitleType  &&
+           merged.m_audioProps    == prog.m_audioProps    &&
+           merged.m_videoProps    == prog.m_videoProps    &&
+           merged.m_season        == prog.m_season        &&
+           merged.m_episode       == prog.m_episode       &&
+           merged.m_totalepisodes == prog.m_totalepisodes &&
+           merged.m_partnumber    == prog.m_partnumber    &&
+           merged.m_parttotal     == prog.m_parttotal     &&
+           merged.m_airdate       == prog.m_airdate       &&
+           merged.m_listingsource == prog.m_listingsource &&
+           merged.m_seriesId      == prog.m_seriesId      &&
+           merged.m_programId     == prog.m_programId     &&
+           merged.m_inetref       == prog.m_inetref       &&
+           merged.m_originalairdate == prog.m_originalairdate &&
+           merged.m_previouslyshown == prog.m_previouslyshown &&
+           merged.m_syndicatedepisodenumber == prog.m_syndicatedepisodenumber;
+}
+
+// std::vector<DBEvent> copies the credits pointer, not the credits,
+// so the programs kept in one must not have any.
+static DBEvent program_copy(const DBEvent &event)
+{
+    DBEvent prog(event.m_listingsource);
+    prog = event;
+    delete prog.m_credits;
+    prog.m_credits = nullptr;
+    return prog;
+}
+
+/**
+ *  \brief Insert or update a batch of EIT events.
+ *
+ *  This gives the same result as calling UpdateDB() for each event in
+ *  turn, but it reads the programs of a channel that overlap the batch
+ *  with one query and matches the events against them in memory. New
+ *  programs and updates of a single matching program are then written
+ *  with one statement per channel, and unchanged programs not at all.
+ *  Only events that move other programs out of the way, or change the
+ *  starttime of a program, use the queries of DBEvent::UpdateDB().
+ *
+ *  \return Number of programs inserted or updated.
+ */
+uint DBEventEIT::UpdateDB(MSqlQuery &query,
+                          const std::vector<DBEventEIT*> &events,
+                          int match_threshold)
+{
+    // Group the events by channel, in their order within a channel
+    std::vector<DBEventEIT*> sorted(events);
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const DBEventEIT *a, const DBEventEIT *b)
+                     { return a->m_chanid < b->m_chanid; });
+
+    QDateTime now = QDateTime::currentDateTimeUtc();
+    uint count = 0;
+    auto it = sorted.cbegin();
+    while (it != sorted.cend())
+    {
+        uint chanid = (*it)->m_chanid;
+        std::vector<const DBEventEIT*> chanevents;
+        QDateTime starttime;
+        QDateTime endtime;
+
+        for (; (it != sorted.cend()) && ((*it)->m_chanid == chanid); ++it)
+        {
+            // Do not insert or update when the program is in the past
+            if ((*it)->m_endtime < now)
+            {
+                LOG(VB_EIT, LOG_DEBUG,
+                    QString("EIT: skip '%1' endtime is in the past")
+                            .arg((*it)->m_title.left(35)));
+                continue;
+            }
+
+            if (chanevents.empty() || (*it)->m_starttime < starttime)
+                starttime = (*it)->m_starttime;
+            if (chanevents.empty() || (*it)->m_endtime > endtime)
+                endtime = (*it)->m_endtime;
+            chanevents.push_back(*it);
+        }
+
+        if (!chanevents.empty())
+        {
+            count += UpdateChannelDB(query, chanid, chanevents,
+                                     starttime, endtime, match_threshold);
+        }
+    }
+
+    return count;
+}
+
+uint DBEventEIT::UpdateChannelDB(MSqlQuery &query, uint chanid,
+                                 const std::vector<const DBEventEIT*> &events,
+                                 const QDateTime &starttime,
+                                 const QDateTime &endtime,
+                                 int match_threshold)
+{
+    // All programs that overlap any of the events, kept in step with
+    // the database as the events are processed.
+    std::vector<DBEvent> programs;
+    GetOverlappingPrograms(query, chanid, starttime, endtime, programs);
+
+    uint count = 0;
+    std::vector<DBEvent> rows;
+    std::vector<const DBEventEIT*> extras;
+    auto flush = [&]()
+    {
+        if (upsert_programs(query, chanid, rows))
+            count += rows.size();
+        for (const auto *event : extras)
+            event->InsertExtrasDB(query, chanid, false);
+        rows.clear();
+        extras.clear();
+    };
+
+    for (const auto *event : events)
+    {
+        LOG(VB_EIT, LOG_DEBUG,
+            QString("EIT: new program: %1 %2 '%3' chanid %4")
+                    .arg(event->m_starttime.toString(Qt::ISODate),
+                         event->m_endtime.toString(Qt::ISODate),
+                         event->m_title.left(35),
+                         QString::number(chanid)));
+
+        std::vector<DBEvent> overlapping;
+        std::vector<size_t> index;
+        for (size_t j = 0; j < programs.size(); ++j)
+        {
+            if (is_overlapping(programs[j], event->m_starttime, event->m_endtime))
+            {
+                overlapping.push_back(programs[j]);
+                index.push_back(j);
+            }
+        }
+
+        if (overlapping.empty())
+        {
+            LOG(VB_EIT, LOG_DEBUG,
+                QString("EIT: insert '%1'").arg(event->m_title.left(35)));
+            rows.push_back(program_copy(*event));
+            programs.push_back(rows.back());
+            if (event->HasExtras())
+                extras.push_back(event);
+            continue;
+        }
+
+        int i = -1;
+        int match = event->GetMatch(overlapping, i);
+        if ((match >= match_threshold) && (overlapping.size() == 1) &&
+            (overlapping[0].m_starttime == event->m_starttime))
+        {
+            if (event->HasExtras())
+                extras.push_back(event);
+
+            DBEvent &prog = programs[index[0]];
+            DBEvent merged = event->Merge(prog);
+            if (is_unchanged(merged, prog))
+            {
+                LOG(VB_EIT, LOG_DEBUG,
+                    QString("EIT: unchanged '%1'").arg(event->m_title.left(35)));
+                continue;
+            }
+
+            LOG(VB_EIT, LOG_DEBUG,
+                QString("EIT: update '%1' with '%2'")
+                        .arg(prog.m_title.left(35), event->m_title.left(35)));
+            rows.push_back(merged);
+            prog = merged;
+            continue;
+        }
+
+        // Write what we have so far, the database must be up to date
+        // for moving programs out of the way.
+        flush();
+
+        if (match < match_threshold)
+            i = -1;
+        count += event->DBEvent::UpdateDB(query, chanid, overlapping, i);
+
+        programs.clear();
+        GetOverlappingPrograms(query, chanid, starttime, endtime, programs);
+    }
+
+    flush();
+
+    return count;
 }
 
 ProgInfo::ProgInfo(const ProgInfo &other) :
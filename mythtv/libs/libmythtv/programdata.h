@@ -131,6 +131,9 @@ class MTV_PUBLIC DBEvent
   protected:
     uint GetOverlappingPrograms(
         MSqlQuery &query, uint chanid, std::vector<DBEvent> &programs) const;
+    static uint GetOverlappingPrograms(
+        MSqlQuery &query, uint chanid, const QDateTime &starttime,
+        const QDateTime &endtime, std::vector<DBEvent> &programs);
     int  GetMatch(
         const std::vector<DBEvent> &programs, int &bestmatch) const;
     uint UpdateDB(
@@ -139,8 +142,12 @@ class MTV_PUBLIC DBEvent
         MSqlQuery &query, uint chanid, const DBEvent &match) const;
     bool MoveOutOfTheWayDB(
         MSqlQuery &query, uint chanid, const DBEvent &prog) const;
+    DBEvent Merge(const DBEvent &match) const;
     virtual uint InsertDB(MSqlQuery &query, uint chanid,
                           bool recording = false) const; // DBEvent
+    bool HasExtras(void) const
+        { return m_credits || !m_ratings.isEmpty() || !m_genres.isEmpty(); }
+    void InsertExtrasDB(MSqlQuery &query, uint chanid, bool recording) const;
 
     virtual void Squeeze(void);
 
@@ -217,6 +224,17 @@ class MTV_PUBLIC DBEventEIT : public DBEvent
         return DBEvent::UpdateDB(query, m_chanid, match_threshold);
     }
 
+    static uint UpdateDB(MSqlQuery &query,
+                         const std::vector<DBEventEIT*> &events,
+                         int match_threshold);
+
+  private:
+    static uint UpdateChannelDB(MSqlQuery &query, uint chanid,
+                                const std::vector<const DBEventEIT*> &events,
+                                const QDateTime &starttime,
+                                const QDateTime &endtime,
+                                int match_threshold);
+
   public:
     uint32_t              m_chanid;
     FixupValue            m_fixup;
@@ -9,6 +9,12 @@
 
 #ifndef _WIN32
 #include <sys/poll.h>
+#include <sys/mman.h>
+#endif
+
+// Map the ring twice with a memfd so wrapped data stays contiguous
+#if defined(__linux__) && defined(MFD_CLOEXEC)
+#define USING_MIRRORED_RING 1
 #endif
 
 /// Set this to 1 to report on statistics
@@ -37,11 +43,7 @@ DeviceReadBuffer::DeviceReadBuffer(
 DeviceReadBuffer::~DeviceReadBuffer()
 {
     Stop();
-    if (m_buffer)
-    {
-        delete[] m_buffer;
-        m_buffer = nullptr;
-    }
+    FreeBuffer();
 }
 
 bool DeviceReadBuffer::Setup(const QString &streamName, int streamfd,
@@ -50,7 +52,7 @@ bool DeviceReadBuffer::Setup(const QString &streamName, int streamfd,
 {
     QMutexLocker locker(&m_lock);
 
-    delete[] m_buffer;
+    FreeBuffer();
 
     m_videoDevice   = streamName;
     m_videoDevice   = m_videoDevice.isNull() ? "" : m_videoDevice;
@@ -66,27 +68,23 @@ bool DeviceReadBuffer::Setup(const QString &streamName, int streamfd,
     m_devBufferCount = deviceBufferCount;
     m_size          = gCoreContext->GetNumSetting(
         "HDRingbufferSize", static_cast<int>(50 * m_readQuanta)) * 1024;
-    m_used          = 0;
+    m_readPos       = 0;
+    m_writePos      = 0;
+    m_discardPos    = kNoDiscard;
     m_devReadSize = m_readQuanta * (m_usingPoll ? 256 : 48);
     m_devReadSize = (deviceBufferSize) ?
         std::min(m_devReadSize, (size_t)deviceBufferSize) : m_devReadSize;
     m_readThreshold = m_readQuanta * 128;
 
-    m_buffer        = new (std::nothrow) unsigned char[m_size + m_devReadSize];
-    m_readPtr       = m_buffer;
-    m_writePtr      = m_buffer;
-
     // Initialize buffer, if it exists
-    if (!m_buffer)
+    if (!AllocateBuffer())
     {
-        m_endPtr = nullptr;
         LOG(VB_GENERAL, LOG_ERR, LOC +
             QString("Failed to allocate buffer of size %1 = %2 + %3")
                 .arg(m_size+m_devReadSize).arg(m_size).arg(m_devReadSize));
         return false;
     }
-    m_endPtr = m_buffer + m_size;
-    memset(m_buffer, 0xFF, m_size + m_readQuanta);
+    memset(m_buffer, 0xFF, m_mirrored ? m_size : m_size + m_mirrorSize);
 
     // Initialize statistics
     m_maxUsed        = 0;
@@ -96,11 +94,90 @@ bool DeviceReadBuffer::Setup(const QString &streamName, int streamfd,
     m_avgBufSleepCnt = 0;
     m_lastReport.start();
 
-    LOG(VB_RECORD, LOG_INFO, LOC + QString("buffer size %1 KB").arg(m_size/1024));
+    LOG(VB_RECORD, LOG_INFO, LOC + QString("buffer size %1 KB%2")
+        .arg(m_size/1024).arg(m_mirrored ? ", mirrored" : ""));
 
     return true;
 }
 
+/** \fn DeviceReadBuffer::AllocateBuffer(void)
+ *  \brief Allocates the ring, mapped twice in a row when possible.
+ *
+ *  Otherwise m_mirrorSize extra bytes are allocated past the end of the
+ *  ring and MirrorWrite() keeps them equal to the start of the ring.
+ */
+bool DeviceReadBuffer::AllocateBuffer(void)
+{
+#ifdef USING_MIRRORED_RING
+    size_t page = sysconf(_SC_PAGESIZE);
+    size_t size = ((m_size + page - 1) / page) * page;
+    int fd = memfd_create("DeviceReadBuffer", MFD_CLOEXEC);
+    if (fd >= 0 && ftruncate(fd, static_cast<off_t>(size)) == 0)
+    {
+        void *base = mmap(nullptr, 2 * size, PROT_NONE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base != MAP_FAILED)
+        {
+            auto *addr = static_cast<unsigned char*>(base);
+            if (mmap(addr, size, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED &&
+                mmap(addr + size, size, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED)
+            {
+                close(fd);
+                m_buffer     = addr;
+                m_size       = size;
+                m_mirrorSize = size;
+                m_mirrored   = true;
+                return true;
+            }
+            munmap(base, 2 * size);
+        }
+    }
+    LOG(VB_RECORD, LOG_WARNING, LOC +
+        "Failed to map mirrored buffer, copying at the wrap instead" + ENO);
+    if (fd >= 0)
+        close(fd);
+#endif
+
+    m_mirrored   = false;
+    m_mirrorSize = m_devReadSize;
+    m_buffer     = new (std::nothrow) unsigned char[m_size + m_mirrorSize];
+    return m_buffer != nullptr;
+}
+
+void DeviceReadBuffer::FreeBuffer(void)
+{
+    if (!m_buffer)
+        return;
+#ifdef USING_MIRRORED_RING
+    if (m_mirrored)
+        munmap(m_buffer, 2 * m_size);
+    else
+#endif
+        delete[] m_buffer;
+    m_buffer   = nullptr;
+    m_mirrored = false;
+}
+
+/** \fn DeviceReadBuffer::MirrorWrite(size_t,size_t)
+ *  \brief Keeps the start of the ring and the bytes past its end equal,
+ *         when the ring is not mapped twice.
+ */
+void DeviceReadBuffer::MirrorWrite(size_t offset, size_t len)
+{
+    if (offset + len > m_size)
+    {
+        // the device wrote past the official end of the buffer
+        memcpy(m_buffer, m_buffer + m_size, offset + len - m_size);
+    }
+    else if (offset < m_mirrorSize)
+    {
+        memcpy(m_buffer + m_size + offset, m_buffer + offset,
+               std::min(offset + len, m_mirrorSize) - offset);
+    }
+}
+
 void DeviceReadBuffer::Start(void)
 {
     LOG(VB_RECORD, LOG_INFO, LOC + "Start() -- begin");
@@ -137,9 +214,9 @@ void DeviceReadBuffer::Reset(const QString &streamName, int streamfd)
     m_videoDevice   = m_videoDevice.isNull() ? "" : m_videoDevice;
     m_streamFd      = streamfd;
 
-    m_used          = 0;
-    m_readPtr       = m_buffer;
-    m_writePtr      = m_buffer;
+    // Discard unread data. Only the reader may move the read position,
+    // so ask it to skip everything written so far, see ApplyDiscard().
+    m_discardPos    = m_writePos.load();
 
     m_error         = false;
 }
@@ -257,43 +334,66 @@ bool DeviceReadBuffer::IsRunning(void) const
 
 uint DeviceReadBuffer::GetUnused(void) const
 {
-    QMutexLocker locker(&m_lock);
-    return m_size - m_used;
+    return m_size - GetUsed();
 }
 
 uint DeviceReadBuffer::GetUsed(void) const
 {
-    QMutexLocker locker(&m_lock);
-    return m_used;
-}
-
-uint DeviceReadBuffer::GetContiguousUnused(void) const
-{
-    QMutexLocker locker(&m_lock);
-    return m_endPtr - m_writePtr;
+    // Load the read position first, it never passes the write position
+    size_t read = m_readPos.load();
+    return m_writePos.load() - read;
 }
 
 void DeviceReadBuffer::IncrWritePointer(uint len)
 {
-    QMutexLocker locker(&m_lock);
-    m_used     += len;
-    m_writePtr += len;
-    m_writePtr  = (m_writePtr >= m_endPtr) ? m_buffer + (m_writePtr - m_endPtr) : m_writePtr;
+    size_t write = m_writePos.load(std::memory_order_relaxed);
+    if (!m_mirrored)
+        MirrorWrite(write % m_size, len);
+    m_writePos.store(write + len);
 #if REPORT_RING_STATS
-    m_maxUsed = std::max(m_used, m_maxUsed);
-    m_avgUsed = ((m_avgUsed * m_avgBufWriteCnt) + m_used) / (m_avgBufWriteCnt+1);
-    ++m_avgBufWriteCnt;
+    {
+        QMutexLocker locker(&m_lock);
+        size_t used = GetUsed();
+        m_maxUsed = std::max(used, m_maxUsed);
+        m_avgUsed = ((m_avgUsed * m_avgBufWriteCnt) + used) / (m_avgBufWriteCnt+1);
+        ++m_avgBufWriteCnt;
+    }
 #endif
-    m_dataWait.wakeAll();
+    // The reader sets m_readerWaiting under the lock before checking
+    // the write position a last time, so this cannot miss it.
+    if (m_readerWaiting.load())
+    {
+        QMutexLocker locker(&m_lock);
+        m_dataWait.wakeAll();
+    }
 }
 
-void DeviceReadBuffer::IncrReadPointer(uint len)
+/** \fn DeviceReadBuffer::ApplyDiscard(void)
+ *  \brief Skips the data discarded by Reset(), called by the reader.
+ *
+ *  The reader may have consumed data written after the Reset() by
+ *  now, so the read position only ever moves forward.
+ */
+void DeviceReadBuffer::ApplyDiscard(void)
 {
-    QMutexLocker locker(&m_lock);
-    m_used    -= len;
-    m_readPtr += len;
-    m_readPtr  = (m_readPtr == m_endPtr) ? m_buffer : m_readPtr;
+    size_t discard = m_discardPos.exchange(kNoDiscard);
+    if (discard != kNoDiscard && discard > m_readPos.load())
+        m_readPos.store(discard);
+}
+
+/** \fn DeviceReadBuffer::Consume(uint)
+ *  \brief Releases count bytes returned by Peek() for the device thread
+ *         to reuse.
+ *
+ *  Data returned by Peek() stays valid until it is consumed, even when
+ *  Reset() is called in the meantime, as only the reader moves the
+ *  read position.
+ */
+void DeviceReadBuffer::Consume(uint count)
+{
+    m_readPos.store(m_readPos.load() + count);
 #if REPORT_RING_STATS
+    QMutexLocker locker(&m_lock);
     ++m_avgBufReadCnt;
 #endif
 }
@@ -350,15 +450,12 @@ void DeviceReadBuffer::run(void)
             // if read_size > 0 do the read...
             if (read_size)
             {
-                read_len = read(m_streamFd, m_writePtr, read_size);
+                size_t offset = m_writePos.load(std::memory_order_relaxed) % m_size;
+                read_len = read(m_streamFd, m_buffer + offset, read_size);
                 if (!CheckForErrors(read_len, read_size, errcnt))
                     break;
                 errcnt = 0;
 
-                // if we wrote past the official end of the buffer,
-                // copy to start
-                if (m_writePtr + read_len > m_endPtr)
-                    memcpy(m_buffer, m_endPtr, m_writePtr + read_len - m_endPtr);
                 IncrWritePointer(read_len);
                 total += read_len;
             }
@@ -613,34 +710,17 @@ bool DeviceReadBuffer::CheckForErrors(
  */
 uint DeviceReadBuffer::Read(unsigned char *buf, const uint count)
 {
+    ApplyDiscard();
     uint avail = WaitForUsed(std::min(count, (uint)m_readThreshold), 20ms);
-    size_t cnt = std::min(count, avail);
+    size_t offset = m_readPos.load() % m_size;
+    size_t cnt = std::min({(size_t)count, (size_t)avail,
+                           m_size + m_mirrorSize - offset});
 
     if (!cnt)
         return 0;
 
-    if (m_readPtr + cnt > m_endPtr)
-    {
-        // Process as two pieces
-        size_t len = m_endPtr - m_readPtr;
-        if (len)
-        {
-            memcpy(buf, m_readPtr, len);
-            buf += len;
-            IncrReadPointer(len);
-        }
-        if (cnt > len)
-        {
-            len = cnt - len;
-            memcpy(buf, m_readPtr, len);
-            IncrReadPointer(len);
-        }
-    }
-    else
-    {
-        memcpy(buf, m_readPtr, cnt);
-        IncrReadPointer(cnt);
-    }
+    memcpy(buf, m_buffer + offset, cnt);
+    Consume(cnt);
 
 #if REPORT_RING_STATS
     ReportStats();
@@ -649,6 +729,31 @@ uint DeviceReadBuffer::Read(unsigned char *buf, const uint count)
     return cnt;
 }
 
+/** \fn DeviceReadBuffer::Peek(uint&)
+ *  \brief Waits briefly for data and returns a pointer to it in the ring
+ *
+ *  The data stays valid until it is released with Consume(). Anything
+ *  not consumed is returned again by the next call, followed by any
+ *  newer data, so a partial packet at the end can simply be left in
+ *  the ring.
+ *
+ *  \param count  Set to the number of contiguous bytes available
+ *  \return pointer to the oldest unconsumed byte
+ */
+const unsigned char *DeviceReadBuffer::Peek(uint &count)
+{
+    ApplyDiscard();
+    uint avail = WaitForUsed(m_readThreshold, 20ms);
+    size_t offset = m_readPos.load() % m_size;
+    count = std::min((size_t)avail, m_size + m_mirrorSize - offset);
+
+#if REPORT_RING_STATS
+    ReportStats();
+#endif
+
+    return m_buffer + offset;
+}
+
 /** \fn DeviceReadBuffer::WaitForUnused(uint) const
  *  \param needed Number of bytes we want to write
  *  \return bytes available for writing
@@ -681,18 +786,24 @@ uint DeviceReadBuffer::WaitForUnused(uint needed) const
  */
 uint DeviceReadBuffer::WaitForUsed(uint needed, std::chrono::milliseconds max_wait) const
 {
+    size_t avail = GetUsed();
+    if (avail >= needed)
+        return avail;
+
     MythTimer timer;
     timer.start();
 
     QMutexLocker locker(&m_lock);
-    size_t avail = m_used;
+    m_readerWaiting = true;
+    avail = GetUsed();
     while ((needed > avail) && isRunning() &&
            !m_requestPause && !m_error && !m_eof &&
            (timer.elapsed() < max_wait))
     {
         m_dataWait.wait(locker.mutex(), 10);
-        avail = m_used;
+        avail = GetUsed();
     }
+    m_readerWaiting = false;
     return avail;
 }
 
@@ -4,12 +4,15 @@
 #ifndef DEVICEREADBUFFER_H
 #define DEVICEREADBUFFER_H
 
+#include <atomic>
+#include <cstdint>
 #include <unistd.h>
 
 #include <QMutex>
 #include <QWaitCondition>
 #include <QString>
 
+#include "mythtvexp.h"
 #include "mythbaseutil.h"
 #include "mythtimer.h"
 #include "tspacket.h"
@@ -30,8 +33,17 @@ class DeviceReaderCB
  *  This allows us to read the device regularly even in the presence
  *  of long blocking conditions on writing to disk or accessing the
  *  database.
+ *
+ *  The ring has a single writer, the device thread, and a single
+ *  reader. The read and write positions are atomics, so neither side
+ *  takes a lock unless the reader has to wait for data. Each position
+ *  is only moved by its own side, Reset() asks the reader to skip the
+ *  unread data rather than moving the read position itself. Where
+ *  possible the ring is mapped twice in a row in virtual memory, so
+ *  that data which wraps around the end is still contiguous and the
+ *  reader can parse it in place with Peek() and Consume().
  */
-class DeviceReadBuffer : protected MThread
+class MTV_PUBLIC DeviceReadBuffer : protected MThread
 {
   public:
     explicit DeviceReadBuffer(DeviceReaderCB *cb,
@@ -59,14 +71,20 @@ class DeviceReadBuffer : protected MThread
     bool IsRunning(void) const;
 
     uint Read(unsigned char *buf, uint count);
+    const unsigned char *Peek(uint &count);
+    void Consume(uint count);
     uint GetUsed(void) const;
+    bool IsMirrored(void) const { return m_mirrored; }
 
   private:
     void run(void) override; // MThread
 
     void SetPaused(bool val);
     void IncrWritePointer(uint len);
-    void IncrReadPointer(uint len);
+    void ApplyDiscard(void);
+    bool AllocateBuffer(void);
+    void FreeBuffer(void);
+    void MirrorWrite(size_t offset, size_t len);
 
     bool HandlePausing(void);
     bool Poll(void) const;
@@ -78,7 +96,6 @@ class DeviceReadBuffer : protected MThread
     bool IsOpen(void) const { return m_streamFd >= 0; }
     void ClosePipes(void) const;
     uint GetUnused(void) const;
-    uint GetContiguousUnused(void) const;
 
     bool CheckForErrors(ssize_t read_len, size_t requested_len, uint &errcnt);
     void ReportStats(void);
@@ -102,15 +119,24 @@ class DeviceReadBuffer : protected MThread
     std::chrono::milliseconds m_maxPollWait         {2500ms};
 
     size_t                  m_size                  {0};
-    size_t                  m_used                  {0};
     size_t                  m_readQuanta            {0};
     size_t                  m_devBufferCount        {1};
     size_t                  m_devReadSize           {0};
     size_t                  m_readThreshold         {0};
     unsigned char          *m_buffer                {nullptr};
-    unsigned char          *m_readPtr               {nullptr};
-    unsigned char          *m_writePtr              {nullptr};
-    unsigned char          *m_endPtr                {nullptr};
+    /// Bytes past m_size that mirror the start of the ring
+    size_t                  m_mirrorSize            {0};
+    /// True when m_buffer is mapped twice instead of copied at the wrap
+    bool                    m_mirrored              {false};
+    /// Total bytes consumed, only the reader changes this
+    std::atomic<size_t>     m_readPos               {0};
+    /// Write position at the last Reset(), the reader skips what came
+    /// before it. kNoDiscard when there is nothing to skip.
+    std::atomic<size_t>     m_discardPos            {kNoDiscard};
+    static constexpr size_t kNoDiscard              {SIZE_MAX};
+    /// Total bytes read from the device, only the device thread changes this
+    std::atomic<size_t>     m_writePos              {0};
+    mutable std::atomic<bool> m_readerWaiting       {false};
 
     mutable QWaitCondition  m_dataWait;
     QWaitCondition          m_runWait;
@@ -6,7 +6,10 @@
 #include <QStringConverter>
 #endif
 
+#include <algorithm>
+
 #include "HLSReader.h"
+#include "HLSSegmentFetcher.h"
 #include "HLS/m3u.h"
 
 #define LOC QString("%1: ").arg(m_curstream ? m_curstream->M3U8Url() : "HLSReader")
@@ -45,6 +48,13 @@ bool HLSReader::Open(const QString & m3u, int bitrate_index)
     Close(true);
     m_cancel = false;
 
+    m_segmentCnt      = 0;
+    m_prefetchedCnt   = 0;
+    m_segmentBytes    = 0;
+    m_downloadTime    = 0ms;
+    m_maxDownloadTime = 0ms;
+    m_prefetchWait    = 0ms;
+
     QByteArray buffer;
 
 #ifdef HLS_USE_MYTHDOWNLOADMANAGER // MythDownloadManager leaks memory
@@ -161,6 +171,8 @@ void HLSReader::Close(bool quiet)
     delete m_playlistWorker;
     m_playlistWorker = nullptr;
 
+    LogSegmentStats();
+
     LOG(VB_RECORD, (quiet ? LOG_DEBUG : LOG_INFO), LOC + "Close -- end");
 }
 
@@ -778,7 +790,8 @@ void HLSReader::IncreaseBitrate(int progid)
     }
 }
 
-bool HLSReader::LoadSegments(MythSingleDownload& downloader)
+bool HLSReader::LoadSegments(MythSingleDownload& downloader,
+                             const std::vector<HLSSegmentFetcher*>& fetchers)
 {
     LOG(VB_RECORD, LOG_DEBUG, LOC + "LoadSegment -- start");
 
@@ -790,6 +803,7 @@ bool HLSReader::LoadSegments(MythSingleDownload& downloader)
     }
 
     HLSRecSegment seg;
+    SegmentContainer ahead;
     for (;;)
     {
         m_seqLock.lock();
@@ -800,6 +814,11 @@ bool HLSReader::LoadSegments(MythSingleDownload& downloader)
         }
 
         seg = m_segments.front();
+        // Don't add to the load if the reader can't keep up
+        if (m_slowCnt == 0)
+            ahead = m_segments.mid(1, static_cast<int>(fetchers.size()));
+        else
+            ahead.clear();
         if (m_segments.size() > m_playlistSize)
         {
             LOG(VB_RECORD, (m_debug ? LOG_INFO : LOG_DEBUG), LOC +
@@ -827,7 +846,9 @@ bool HLSReader::LoadSegments(MythSingleDownload& downloader)
             return false;
         }
 
-        long throttle = DownloadSegmentData(downloader,hls,seg,m_playlistSize);
+        HLSSegmentFetcher *fetcher = StartPrefetch(fetchers, seg, ahead);
+        long throttle = DownloadSegmentData(downloader, hls, seg,
+                                            m_playlistSize, fetcher);
 
         m_seqLock.lock();
         if (throttle < 0)
@@ -879,6 +900,52 @@ bool HLSReader::LoadSegments(MythSingleDownload& downloader)
     return true;
 }
 
+/**
+ * Hands the segments after the current one to idle fetchers, and
+ * discards the downloads of segments which are not wanted any more
+ * after a failure or a stream switch.
+ *
+ * \return the fetcher already downloading the current segment, if any
+ */
+HLSSegmentFetcher* HLSReader::StartPrefetch(
+    const std::vector<HLSSegmentFetcher*>& fetchers,
+    const HLSRecSegment& segment, const SegmentContainer& ahead)
+{
+    HLSSegmentFetcher *current = nullptr;
+    for (auto *fetcher : fetchers)
+    {
+        if (fetcher->IsIdle())
+            continue;
+        if (fetcher->Has(segment.Url()))
+        {
+            current = fetcher;
+            continue;
+        }
+        auto wanted = [fetcher](const HLSRecSegment& s)
+            { return fetcher->Has(s.Url()); };
+        if (std::none_of(ahead.cbegin(), ahead.cend(), wanted))
+            fetcher->Discard();
+    }
+
+    for (const auto & next : ahead)
+    {
+        auto queued = [&next](const HLSSegmentFetcher *f)
+            { return f->Has(next.Url()); };
+        if (std::any_of(fetchers.cbegin(), fetchers.cend(), queued))
+            continue;
+        auto idle = std::find_if(fetchers.cbegin(), fetchers.cend(),
+                                 [](const HLSSegmentFetcher *f)
+                                 { return f->IsIdle(); });
+        if (idle == fetchers.cend())
+            break;
+        LOG(VB_RECORD, LOG_DEBUG, LOC +
+            QString("Prefetching segment %1").arg(next.Sequence()));
+        (*idle)->Fetch(next.Url());
+    }
+
+    return current;
+}
+
 uint HLSReader::PercentBuffered(void) const
 {
     if (m_playlistSize == 0 || m_segments.size() > m_playlistSize)
@@ -889,7 +956,8 @@ uint HLSReader::PercentBuffered(void) const
 
 int HLSReader::DownloadSegmentData(MythSingleDownload& downloader,
                                    HLSRecStream* hls,
-                                   const HLSRecSegment& segment, int playlist_size)
+                                   const HLSRecSegment& segment, int playlist_size,
+                                   HLSSegmentFetcher* fetcher)
 {
     uint64_t bandwidth = hls->AverageBandwidth();
 
@@ -935,17 +1003,33 @@ int HLSReader::DownloadSegmentData(MythSingleDownload& downloader,
         else
             return 0;
     }
+    auto downloadduration = nowAsDuration<std::chrono::milliseconds>() - start;
 #else
-    if (!downloader.DownloadURL(segment.Url(), &buffer))
+    std::chrono::milliseconds downloadduration = 0ms;
+    if (fetcher)
+    {
+        QString error;
+        if (!fetcher->Take(buffer, downloadduration, error))
+        {
+            LOG(VB_RECORD, LOG_ERR, LOC + QString("%1 prefetch failed: %2")
+                .arg(segment.Sequence()).arg(error));
+            return -1;
+        }
+        m_prefetchWait += nowAsDuration<std::chrono::milliseconds>() - start;
+        ++m_prefetchedCnt;
+    }
+    else
     {
-        LOG(VB_RECORD, LOG_ERR, LOC + QString("%1 failed: %2")
-            .arg(segment.Sequence()).arg(downloader.ErrorString()));
-        return -1;
+        if (!downloader.DownloadURL(segment.Url(), &buffer))
+        {
+            LOG(VB_RECORD, LOG_ERR, LOC + QString("%1 failed: %2")
+                .arg(segment.Sequence()).arg(downloader.ErrorString()));
+            return -1;
+        }
+        downloadduration = nowAsDuration<std::chrono::milliseconds>() - start;
     }
 #endif
 
-    auto downloadduration = nowAsDuration<std::chrono::milliseconds>() - start;
-
 #ifdef USING_LIBCRYPTO
     /* If the segment is encrypted, decode it */
     if (segment.HasKeyPath())
@@ -998,6 +1082,11 @@ int HLSReader::DownloadSegmentData(MythSingleDownload& downloader,
     if (downloadduration < 1ms)
         downloadduration = 1ms;
 
+    ++m_segmentCnt;
+    m_segmentBytes += segment_len;
+    m_downloadTime += downloadduration;
+    m_maxDownloadTime = std::max(m_maxDownloadTime, downloadduration);
+
     /* bits/sec */
     bandwidth = segment_len * 8 * 1000ULL / downloadduration.count();
     hls->AverageBandwidth(bandwidth);
@@ -1007,15 +1096,31 @@ int HLSReader::DownloadSegmentData(MythSingleDownload& downloader,
 
     LOG(VB_RECORD, (m_debug ? LOG_INFO : LOG_DEBUG), LOC +
         QString("%1 took %3ms for %4 bytes: "
-                "bandwidth:%5kiB/s")
+                "bandwidth:%5kiB/s%6")
         .arg(segment.Sequence())
         .arg(downloadduration.count())
         .arg(segment_len)
-        .arg(bandwidth / 8192.0));
+        .arg(bandwidth / 8192.0)
+        .arg(fetcher ? " (prefetched)" : ""));
 
     return m_slowCnt;
 }
 
+void HLSReader::LogSegmentStats(void) const
+{
+    if (m_segmentCnt == 0)
+        return;
+
+    LOG(VB_RECORD, LOG_INFO, LOC +
+        QString("Downloaded %1 segments (%2 prefetched), %3 MiB, "
+                "average %4ms, max %5ms, waited %6ms for prefetches")
+        .arg(m_segmentCnt).arg(m_prefetchedCnt)
+        .arg(m_segmentBytes / (1024.0 * 1024.0), 0, 'f', 1)
+        .arg(m_downloadTime.count() / static_cast<int64_t>(m_segmentCnt))
+        .arg(m_maxDownloadTime.count())
+        .arg(m_prefetchWait.count()));
+}
+
 void HLSReader::PlaylistGood(void)
 {
     QMutexLocker lock(&m_streamLock);
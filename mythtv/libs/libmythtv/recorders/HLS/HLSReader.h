@@ -1,6 +1,8 @@
 #ifndef HLS_READER_H
 #define HLS_READER_H
 
+#include <vector>
+
 #include <QObject>
 #include <QString>
 #include <QUrl>
@@ -30,6 +32,8 @@
 #include "HLSStreamWorker.h"
 #include "HLSPlaylistWorker.h"
 
+class HLSSegmentFetcher;
+
 
 class MTV_PUBLIC  HLSReader
 {
@@ -51,6 +55,10 @@ class MTV_PUBLIC  HLSReader
     bool IsOpen(const QString& url) const
     { return m_curstream && m_m3u8 == url; }
     bool FatalError(void) const { return m_fatal; }
+    /// \brief Sets how many segments are downloaded ahead of the current
+    ///        one, it takes effect when the stream is next opened.
+    void SetPrefetch(uint segments) { m_prefetch = segments; }
+    uint Prefetch(void) const { return m_prefetch; }
 
     bool LoadMetaPlaylists(MythSingleDownload& downloader);
     void ResetStream(void)
@@ -70,7 +78,8 @@ class MTV_PUBLIC  HLSReader
 
   protected:
     void Cancel(bool quiet = false);
-    bool LoadSegments(MythSingleDownload& downloader);
+    bool LoadSegments(MythSingleDownload& downloader,
+                      const std::vector<HLSSegmentFetcher*>& fetchers);
     uint PercentBuffered(void) const;
     std::chrono::seconds TargetDuration(void) const
     { return (m_curstream ? m_curstream->TargetDuration() : 0s); }
@@ -88,8 +97,13 @@ class MTV_PUBLIC  HLSReader
 
     // Downloading
     bool LoadSegments(HLSRecStream & hlsstream);
+    HLSSegmentFetcher* StartPrefetch(const std::vector<HLSSegmentFetcher*>& fetchers,
+                                     const HLSRecSegment& segment,
+                                     const SegmentContainer& ahead);
     int DownloadSegmentData(MythSingleDownload& downloader, HLSRecStream* hls,
-			    const HLSRecSegment& segment, int playlist_size);
+			    const HLSRecSegment& segment, int playlist_size,
+			    HLSSegmentFetcher* fetcher = nullptr);
+    void LogSegmentStats(void) const;
 
     // Debug
     void EnableDebugging(void);
@@ -127,6 +141,16 @@ class MTV_PUBLIC  HLSReader
     int                m_slowCnt        {0};
     QByteArray         m_buffer;
     QMutex             m_bufLock;
+    uint               m_prefetch       {0};
+
+    // Segment download statistics
+    uint64_t           m_segmentCnt     {0};
+    uint64_t           m_prefetchedCnt  {0};
+    uint64_t           m_segmentBytes   {0};
+    std::chrono::milliseconds m_downloadTime    {0ms};
+    std::chrono::milliseconds m_maxDownloadTime {0ms};
+    /// Time spent waiting for a segment that was already being prefetched
+    std::chrono::milliseconds m_prefetchWait    {0ms};
 };
 
 #endif // HLS_READER_H
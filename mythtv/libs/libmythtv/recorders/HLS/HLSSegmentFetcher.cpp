@@ -0,0 +1,161 @@
+#include "mythlogging.h"
+#include "mythsingledownload.h"
+
+#include "HLSSegmentFetcher.h"
+
+#define LOC QString("HLSFetcher[%1]: ").arg(objectName())
+
+HLSSegmentFetcher::HLSSegmentFetcher(int id)
+    : MThread(QString("HLSFetch%1").arg(id))
+{
+    LOG(VB_RECORD, LOG_DEBUG, LOC + "ctor");
+}
+
+HLSSegmentFetcher::~HLSSegmentFetcher(void)
+{
+    LOG(VB_RECORD, LOG_DEBUG, LOC + "dtor");
+}
+
+void HLSSegmentFetcher::Fetch(const QUrl &url)
+{
+    QMutexLocker locker(&m_lock);
+    m_url   = url;
+    m_state = kQueued;
+    m_buffer.clear();
+    m_error.clear();
+    m_waitCond.wakeAll();
+}
+
+bool HLSSegmentFetcher::Has(const QUrl &url) const
+{
+    QMutexLocker locker(&m_lock);
+    return m_state != kIdle && m_url == url;
+}
+
+bool HLSSegmentFetcher::IsIdle(void) const
+{
+    QMutexLocker locker(&m_lock);
+    return m_state == kIdle;
+}
+
+bool HLSSegmentFetcher::Take(QByteArray &buffer,
+                             std::chrono::milliseconds &duration,
+                             QString &error)
+{
+    QMutexLocker locker(&m_lock);
+    while (m_state == kQueued || m_state == kFetching)
+        m_waitCond.wait(&m_lock);
+    if (m_state == kIdle)
+        return false;
+
+    buffer.swap(m_buffer);
+    m_buffer.clear();
+    duration = m_duration;
+    error    = m_error;
+    m_state  = kIdle;
+    return m_ok;
+}
+
+void HLSSegmentFetcher::Abort(void)
+{
+    m_lock.lock();
+    if (m_state == kQueued)
+    {
+        // never started, fail it right away
+        m_ok    = false;
+        m_error = "canceled";
+        m_state = kDone;
+        m_waitCond.wakeAll();
+    }
+    bool fetching = (m_state == kFetching);
+    m_lock.unlock();
+
+    if (fetching)
+    {
+        QMutexLocker locker(&m_downloaderLock);
+        if (m_downloader)
+            m_downloader->Cancel();
+    }
+}
+
+void HLSSegmentFetcher::Discard(void)
+{
+    Abort();
+
+    QMutexLocker locker(&m_lock);
+    while (m_state == kFetching)
+        m_waitCond.wait(&m_lock);
+    m_buffer.clear();
+    m_state = kIdle;
+}
+
+void HLSSegmentFetcher::Cancel(void)
+{
+    m_lock.lock();
+    m_cancel = true;
+    m_waitCond.wakeAll();
+    m_lock.unlock();
+
+    Abort();
+    wait();
+}
+
+void HLSSegmentFetcher::run(void)
+{
+    RunProlog();
+    LOG(VB_RECORD, LOG_DEBUG, LOC + "run -- begin");
+
+    m_downloaderLock.lock();
+    m_downloader = new MythSingleDownload;
+    m_downloaderLock.unlock();
+
+    QMutexLocker locker(&m_lock);
+    while (!m_cancel)
+    {
+        if (m_state != kQueued)
+        {
+            m_waitCond.wait(&m_lock);
+            continue;
+        }
+        m_state = kFetching;
+        QUrl url = m_url;
+        locker.unlock();
+
+        QByteArray buffer;
+        auto start = nowAsDuration<std::chrono::milliseconds>();
+        bool ok = m_downloader->DownloadURL(url, &buffer);
+        auto duration = nowAsDuration<std::chrono::milliseconds>() - start;
+        QString error;
+        if (!ok)
+        {
+            error = m_downloader->ErrorString();
+
+            // See HLSStreamWorker::run(), a new instance is needed to
+            // download again after a failure.
+            m_downloaderLock.lock();
+            delete m_downloader;
+            m_downloader = new MythSingleDownload;
+            m_downloaderLock.unlock();
+        }
+
+        locker.relock();
+        if (m_state == kFetching)
+        {
+            m_buffer.swap(buffer);
+            m_ok       = ok;
+            m_error    = error;
+            m_duration = duration;
+            m_state    = kDone;
+        }
+        m_waitCond.wakeAll();
+    }
+    locker.unlock();
+
+    m_downloaderLock.lock();
+    delete m_downloader;
+    m_downloader = nullptr;
+    m_downloaderLock.unlock();
+
+    LOG(VB_RECORD, LOG_DEBUG, LOC + "run -- end");
+    RunEpilog();
+}
@@ -0,0 +1,69 @@
+#ifndef HLS_SEGMENT_FETCHER_H
+#define HLS_SEGMENT_FETCHER_H
+
+#include <QByteArray>
+#include <QMutex>
+#include <QUrl>
+#include <QWaitCondition>
+
+#include "mthread.h"
+#include "mythchrono.h"
+
+class MythSingleDownload;
+
+/** \brief Downloads one segment ahead of the one being recorded.
+ *
+ *  HLSStreamWorker keeps a few of these so that the segments after the
+ *  current one are downloaded at the same time. Each fetcher keeps its
+ *  MythSingleDownload, and with it its HTTP connection, for as long as
+ *  it runs.
+ */
+class HLSSegmentFetcher : public MThread
+{
+  public:
+    explicit HLSSegmentFetcher(int id);
+    ~HLSSegmentFetcher(void) override;
+
+    /// Starts downloading url, the fetcher must be idle.
+    void Fetch(const QUrl &url);
+    /// True if the fetcher is downloading, or holding the data of, url.
+    bool Has(const QUrl &url) const;
+    bool IsIdle(void) const;
+
+    /// Waits for the download to finish and hands over its data,
+    /// the fetcher is idle afterwards.
+    bool Take(QByteArray &buffer, std::chrono::milliseconds &duration,
+              QString &error);
+    /// Aborts the download, Take() returns false for it.
+    void Abort(void);
+    /// Aborts the download and throws its data away.
+    void Discard(void);
+    void Cancel(void);
+
+  protected:
+    void run(void) override; // MThread
+
+  private:
+    enum State : std::uint8_t
+    {
+        kIdle,
+        kQueued,
+        kFetching,
+        kDone,
+    };
+
+    MythSingleDownload       *m_downloader {nullptr};
+    QMutex                    m_downloaderLock;
+
+    mutable QMutex            m_lock;
+    QWaitCondition            m_waitCond;
+    State                     m_state      {kIdle};
+    bool                      m_cancel     {false};
+    QUrl                      m_url;
+    QByteArray                m_buffer;
+    bool                      m_ok         {false};
+    QString                   m_error;
+    std::chrono::milliseconds m_duration   {0ms};
+};
+
+#endif // HLS_SEGMENT_FETCHER_H
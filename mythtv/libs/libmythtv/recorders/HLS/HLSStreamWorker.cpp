@@ -1,4 +1,5 @@
 #include "HLSReader.h"
+#include "HLSSegmentFetcher.h"
 #include "HLSStreamWorker.h"
 
 #define LOC QString("%1 worker: ").arg(m_parent->StreamURL().isEmpty() ? "Stream" : m_parent->StreamURL())
@@ -30,6 +31,8 @@ void HLSStreamWorker::CancelCurrentDownload(void)
     QMutexLocker locker(&m_downloaderLock);
     if (m_downloader)
         m_downloader->Cancel();
+    for (auto *fetcher : m_fetchers)
+        fetcher->Abort();
 }
 
 void HLSStreamWorker::run(void)
@@ -39,6 +42,12 @@ void HLSStreamWorker::run(void)
 
     m_downloaderLock.lock();
     m_downloader = new MythSingleDownload;
+    for (uint i = 0; i < m_parent->Prefetch(); i++)
+    {
+        auto *fetcher = new HLSSegmentFetcher(i);
+        fetcher->start();
+        m_fetchers.push_back(fetcher);
+    }
     m_downloaderLock.unlock();
 
     std::chrono::milliseconds delay = 0ms;
@@ -50,7 +59,7 @@ void HLSStreamWorker::run(void)
             LOG(VB_GENERAL, LOG_CRIT, LOC + "Fatal error detected");
             break;
         }
-        if (!m_parent->LoadSegments(*m_downloader))
+        if (!m_parent->LoadSegments(*m_downloader, m_fetchers))
         {
             LOG(VB_RECORD, LOG_WARNING, LOC +
                 QString("download failed, retry #%1").arg(++retries));
@@ -93,6 +102,16 @@ void HLSStreamWorker::run(void)
         m_lock.unlock();
     }
 
+    m_downloaderLock.lock();
+    std::vector<HLSSegmentFetcher*> fetchers;
+    fetchers.swap(m_fetchers);
+    m_downloaderLock.unlock();
+    for (auto *fetcher : fetchers)
+    {
+        fetcher->Cancel();
+        delete fetcher;
+    }
+
     m_downloader->Cancel();
     delete m_downloader;
     m_downloader = nullptr;
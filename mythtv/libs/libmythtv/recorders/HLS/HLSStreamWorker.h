@@ -1,6 +1,8 @@
 #ifndef HLS_SEGMENT_WORKER_H
 #define HLS_SEGMENT_WORKER_H
 
+#include <vector>
+
 #include <QMap>
 #include <QWaitCondition>
 #include <QMutex>
@@ -8,6 +10,7 @@
 #include "mthread.h"
 
 class HLSReader;
+class HLSSegmentFetcher;
 
 class HLSStreamWorker : public MThread
 {
@@ -28,6 +31,8 @@ class HLSStreamWorker : public MThread
     // Class vars
     HLSReader          *m_parent     {nullptr};
     MythSingleDownload *m_downloader {nullptr};
+    /// Download the segments after the current one
+    std::vector<HLSSegmentFetcher*> m_fetchers;
     bool                m_cancel     {false};
     bool                m_wokenup    {false};
     mutable QMutex      m_lock;
@@ -105,6 +105,7 @@ ASIStreamHandler::ASIStreamHandler(const QString &device, int inputid)
     : StreamHandler(device, inputid)
 {
     setObjectName("ASISH");
+    m_fanoutCapable = true;
 }
 
 void ASIStreamHandler::SetClockSource(ASIClockSource cs)
@@ -225,9 +226,7 @@ void ASIStreamHandler::run(void)
             continue;
         }
 
-        for (auto sit = m_streamDataList.cbegin();
-             sit != m_streamDataList.cend(); ++sit)
-            remainder = sit.key()->ProcessData(buffer, len);
+        remainder = DistributeData(buffer, len);
 
         WriteMPTS(buffer, len - remainder);
 
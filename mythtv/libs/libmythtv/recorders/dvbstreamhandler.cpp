@@ -106,6 +106,7 @@ DVBStreamHandler::DVBStreamHandler(const QString &dvb_device, int inputid)
     , m_drb(nullptr)
 {
     setObjectName("DVBRead");
+    m_fanoutCapable = true;
 }
 
 void DVBStreamHandler::run(void)
@@ -206,10 +207,14 @@ void DVBStreamHandler::RunTS(void)
         UpdateFiltersFromStreamData();
 
         ssize_t len = 0;
+        const unsigned char *data = buffer;
 
         if (drb)
         {
-            len = drb->Read(&(buffer[remainder]), buffer_size - remainder);
+            // Parse in place, any remainder is still at the front
+            uint avail = 0;
+            data = drb->Peek(avail);
+            len = avail;
 
             // Check for DRB errors
             if (drb->IsErrored())
@@ -244,9 +249,9 @@ void DVBStreamHandler::RunTS(void)
                 std::this_thread::sleep_for(100us);
                 continue;
             }
-        }
 
-        len += remainder;
+            len += remainder;
+        }
 
         if (len < 10) // 10 bytes = 4 bytes TS header + 6 bytes PES header
         {
@@ -259,17 +264,23 @@ void DVBStreamHandler::RunTS(void)
         if (m_streamDataList.empty())
         {
             m_listenerLock.unlock();
+            if (drb)
+            {
+                drb->Consume(len);
+                remainder = 0;
+            }
             continue;
         }
 
-        for (auto sit = m_streamDataList.cbegin(); sit != m_streamDataList.cend(); ++sit)
-            remainder = sit.key()->ProcessData(buffer, len);
+        remainder = DistributeData(data, len);
 
-        WriteMPTS(buffer, len - remainder);
+        WriteMPTS(data, len - remainder);
 
         m_listenerLock.unlock();
 
-        if (remainder > 0 && (len > remainder)) // leftover bytes
+        if (drb)
+            drb->Consume(len - remainder);
+        else if (remainder > 0 && (len > remainder)) // leftover bytes
             memmove(buffer, &(buffer[len - remainder]), remainder);
     }
     LOG(VB_RECORD, LOG_DEBUG, LOC + "RunTS(): " + "shutdown");
@@ -103,6 +103,7 @@ HDHRStreamHandler::HDHRStreamHandler(const QString &device, int inputid,
     , m_majorId(majorid)
 {
     setObjectName("HDHRStreamHandler");
+    m_fanoutCapable = true;
 }
 
 /** \fn HDHRStreamHandler::run(void)
@@ -170,8 +171,7 @@ void HDHRStreamHandler::run(void)
             continue;
         }
 
-        for (auto sit = m_streamDataList.cbegin(); sit != m_streamDataList.cend(); ++sit)
-            remainder = sit.key()->ProcessData(data_buffer, data_length);
+        remainder = DistributeData(data_buffer, data_length);
 
         WriteMPTS(data_buffer, data_length - remainder);
 
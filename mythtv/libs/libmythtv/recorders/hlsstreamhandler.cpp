@@ -10,6 +10,7 @@
 
 // MythTV headers
 #include "hlsstreamhandler.h"
+#include "mythcorecontext.h"
 #include "mythlogging.h"
 #include "recorders/HLS/HLSReader.h"
 
@@ -101,7 +102,10 @@ HLSStreamHandler::HLSStreamHandler(const IPTVTuningData& tuning, int inputid)
     : IPTVStreamHandler(tuning, inputid)
 {
     LOG(VB_GENERAL, LOG_INFO, LOC + "ctor");
+    // Data is passed to the listeners directly, not through DistributeData()
+    m_fanoutCapable = false;
     m_hls        = new HLSReader();
+    m_hls->SetPrefetch(gCoreContext->GetNumSetting("HLSPrefetchSegments", 2));
     m_readbuffer = new uint8_t[BUFFER_SIZE];
 }
 
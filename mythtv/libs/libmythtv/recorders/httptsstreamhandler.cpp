@@ -93,6 +93,8 @@ HTTPTSStreamHandler::HTTPTSStreamHandler(const IPTVTuningData& tuning,
     : IPTVStreamHandler(tuning, inputid)
 {
     LOG(VB_GENERAL, LOG_INFO, LOC + "ctor");
+    // Data is passed to the listeners directly, not through DistributeData()
+    m_fanoutCapable = false;
 }
 
 HTTPTSStreamHandler::~HTTPTSStreamHandler(void)
@@ -161,6 +161,14 @@ bool IPTVChannel::IsOpen(void) const
     return ret;
 }
 
+bool IPTVChannel::GetFECStats(uint64_t &recovered,
+                              uint64_t &unrecoverable) const
+{
+    QMutexLocker locker(&m_streamLock);
+    return m_streamHandler &&
+        m_streamHandler->GetFECStats(recovered, unrecoverable);
+}
+
 bool IPTVChannel::Tune(const IPTVTuningData &tuning, bool scanning)
 {
     QMutexLocker locker(&m_tuneLock);
@@ -46,6 +46,7 @@ class IPTVChannel : QObject, public DTVChannel
     QString GetDevice(void) const override // ChannelBase
         { return m_lastTuning.GetDeviceKey(); }
     IPTVStreamHandler *GetStreamHandler(void) const { return m_streamHandler; }
+    bool GetFECStats(uint64_t &recovered, uint64_t &unrecoverable) const;
     bool IsIPTV(void) const override { return true; } // DTVChannel
     bool IsPIDTuningSupported(void) const  override // DTVChannel
         { return true; }
@@ -1,5 +1,9 @@
 // -*- Mode: c++ -*-
 
+// C++ headers
+#include <algorithm>
+#include <climits>
+
 // MythTV headers
 #include "iptvsignalmonitor.h"
 #include "mpegstreamdata.h"
@@ -26,7 +30,11 @@ IPTVSignalMonitor::IPTVSignalMonitor(int db_cardnum,
                                      IPTVChannel *_channel,
                                      bool _release_stream,
                                      uint64_t _flags)
-    : DTVSignalMonitor(db_cardnum, _channel, _release_stream, _flags)
+    : DTVSignalMonitor(db_cardnum, _channel, _release_stream, _flags),
+      m_fecRecovered    (tr("FEC Recovered"),      "fecr",
+                         0,  false, 0, INT_MAX, 0ms),
+      m_fecUnrecoverable(tr("FEC Unrecoverable"),  "fecu",
+                         0,  false, 0, INT_MAX, 0ms)
 {
     LOG(VB_CHANNEL, LOG_INFO, LOC + "ctor");
     m_signalLock.SetValue(0);
@@ -72,6 +80,18 @@ void IPTVSignalMonitor::HandlePAT(const ProgramAssociationTable *pat)
     DTVSignalMonitor::HandlePAT(pat);
 }
 
+QStringList IPTVSignalMonitor::GetStatusList(void) const
+{
+    QStringList list = DTVSignalMonitor::GetStatusList();
+    QMutexLocker locker(&m_statusLock);
+    if (m_usingFEC)
+    {
+        list<<m_fecRecovered.GetName()<<m_fecRecovered.GetStatus();
+        list<<m_fecUnrecoverable.GetName()<<m_fecUnrecoverable.GetStatus();
+    }
+    return list;
+}
+
 /** \fn IPTVSignalMonitor::UpdateValues(void)
  *  \brief Fills in frontend stats and emits status Qt signals.
  *
@@ -95,6 +115,16 @@ void IPTVSignalMonitor::UpdateValues(void)
         m_locked = true;
     }
 
+    uint64_t recovered = 0;
+    uint64_t unrecoverable = 0;
+    if (channel->GetFECStats(recovered, unrecoverable))
+    {
+        QMutexLocker locker(&m_statusLock);
+        m_usingFEC = true;
+        m_fecRecovered.SetValue(std::min<uint64_t>(recovered, INT_MAX));
+        m_fecUnrecoverable.SetValue(std::min<uint64_t>(unrecoverable, INT_MAX));
+    }
+
     EmitStatus();
     if (IsAllGood())
         SendMessageAllGood();
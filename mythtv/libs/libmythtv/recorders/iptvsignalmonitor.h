@@ -24,6 +24,8 @@ class IPTVSignalMonitor : public DTVSignalMonitor
     // MPEG
     void HandlePAT(const ProgramAssociationTable *pat) override; // DTVSignalMonitor
 
+    QStringList GetStatusList(void) const override; // DTVSignalMonitor
+
   protected:
     IPTVSignalMonitor(void);
     IPTVSignalMonitor(const IPTVSignalMonitor&);
@@ -34,6 +36,10 @@ class IPTVSignalMonitor : public DTVSignalMonitor
   protected:
     bool m_streamHandlerStarted {false};
     bool m_locked               {false};
+    bool m_usingFEC             {false};
+
+    SignalMonitorValue m_fecRecovered;
+    SignalMonitorValue m_fecUnrecoverable;
 };
 
 #endif // IPTVSIGNALMONITOR_H
@@ -8,6 +8,7 @@
 # include <sys/socket.h>
 # include <netinet/in.h>
 # include <netinet/ip.h>
+# include <poll.h>
 #endif
 
 // Qt headers
@@ -110,6 +111,7 @@ IPTVStreamHandler::IPTVStreamHandler(const IPTVTuningData &tuning, int inputid)
     , m_tuning(tuning)
 {
     m_useRtpStreaming = m_tuning.IsRTP();
+    m_fanoutCapable   = true;
 }
 
 void IPTVStreamHandler::run(void)
@@ -217,7 +219,9 @@ void IPTVStreamHandler::run(void)
             // the requested server
             m_sender[i] = dest_addr;
         }
+#ifndef USING_RECVMMSG
         m_readHelpers[i] = new IPTVStreamHandlerReadHelper(this,m_sockets[i],i);
+#endif
 
         // we need to open the descriptor ourselves so we
         // can set some socket options
@@ -239,6 +243,28 @@ void IPTVStreamHandler::run(void)
                 QString("Increasing buffer size to %1 failed")
                 .arg(buf_size) + ENO);
         }
+#ifdef USING_RECVMMSG
+        else
+        {
+            // The kernel limits this to net.core.rmem_max, and reports
+            // double the size, to allow for its bookkeeping overhead.
+            int actual = 0;
+            socklen_t len = sizeof(actual);
+            if (getsockopt(fd, SOL_SOCKET, SO_RCVBUF, &actual, &len) == 0 &&
+                actual / 2 < buf_size)
+            {
+                LOG(VB_GENERAL, LOG_WARNING, LOC +
+                    QString("Socket buffer is %1 bytes instead of %2, "
+                            "increase net.core.rmem_max to avoid drops")
+                    .arg(actual / 2).arg(buf_size));
+            }
+        }
+# ifdef SO_RXQ_OVFL
+        // report the number of datagrams dropped with each one received
+        int on = 1;
+        setsockopt(fd, SOL_SOCKET, SO_RXQ_OVFL, &on, sizeof(on));
+# endif
+#endif
 
         m_sockets[i]->setSocketDescriptor(
             fd, QAbstractSocket::UnconnectedState, QIODevice::ReadOnly);
@@ -279,6 +305,10 @@ void IPTVStreamHandler::run(void)
             m_buffer = new UDPPacketBuffer(tuning.GetBitrate(0));
         m_writeHelper = new IPTVStreamHandlerWriteHelper(this);
         m_writeHelper->Start();
+#ifdef USING_RECVMMSG
+        m_receiver = new IPTVStreamHandlerReceiver(this);
+        m_receiver->start();
+#endif
     }
 
     if (!error && rtsp)
@@ -306,6 +336,10 @@ void IPTVStreamHandler::run(void)
     }
 
     // Clean up
+#ifdef USING_RECVMMSG
+    delete m_receiver;
+    m_receiver = nullptr;
+#endif
     for (uint i = 0; i < IPTV_SOCKET_COUNT; i++)
     {
         if (m_sockets[i])
@@ -316,8 +350,10 @@ void IPTVStreamHandler::run(void)
             m_readHelpers[i] = nullptr;
         }
     }
+    m_bufferLock.lock();
     delete m_buffer;
     m_buffer = nullptr;
+    m_bufferLock.unlock();
     delete m_writeHelper;
     m_writeHelper = nullptr;
 
@@ -331,6 +367,34 @@ void IPTVStreamHandler::run(void)
     RunEpilog();
 }
 
+/** \fn IPTVStreamHandler::GetFECStats(uint64_t&,uint64_t&) const
+ *  \brief Returns the number of packets recovered with Forward Error
+ *         Correction and the number lost despite it.
+ *  \return false if no FEC packets have been received.
+ */
+bool IPTVStreamHandler::GetFECStats(uint64_t &recovered,
+                                    uint64_t &unrecoverable) const
+{
+    QMutexLocker locker(&m_bufferLock);
+    if (!m_buffer || !m_buffer->HasFEC())
+        return false;
+    recovered     = m_buffer->GetFECRecovered();
+    unrecoverable = m_buffer->GetFECUnrecoverable();
+    return true;
+}
+
+UDPPacket IPTVStreamHandler::PopDataPacket(void)
+{
+    QMutexLocker locker(&m_bufferLock);
+    return m_buffer->PopDataPacket();
+}
+
+void IPTVStreamHandler::FreePacket(const UDPPacket &packet)
+{
+    QMutexLocker locker(&m_bufferLock);
+    m_buffer->FreePacket(packet);
+}
+
 IPTVStreamHandlerReadHelper::IPTVStreamHandlerReadHelper(
     IPTVStreamHandler *p, QUdpSocket *s, uint stream) :
     m_parent(p), m_socket(s), m_sender(p->m_sender[stream]),
@@ -347,6 +411,7 @@ void IPTVStreamHandlerReadHelper::ReadPending(void)
     QHostAddress sender;
     quint16 senderPort = 0;
     bool sender_null = m_sender.isNull();
+    QMutexLocker locker(&m_parent->m_bufferLock);
 
     if (0 == m_stream)
     {
@@ -396,6 +461,206 @@ void IPTVStreamHandlerReadHelper::ReadPending(void)
     }
 }
 
+#ifdef USING_RECVMMSG
+
+#define LOC_RX QString("IPTVSH(%1): ").arg(m_parent->m_device)
+
+IPTVStreamHandlerReceiver::IPTVStreamHandlerReceiver(IPTVStreamHandler *p)
+    : MThread("IPTVReceiver"), m_parent(p)
+{
+    for (uint i = 0; i < IPTV_SOCKET_COUNT; i++)
+    {
+        if (p->m_sockets[i])
+            m_fds[i] = p->m_sockets[i]->socketDescriptor();
+        m_sender[i] = p->m_sender[i];
+    }
+
+    QMutexLocker locker(&m_parent->m_bufferLock);
+    for (uint i = 0; i < kBatchSize; i++)
+        FillSlot(i);
+}
+
+IPTVStreamHandlerReceiver::~IPTVStreamHandlerReceiver()
+{
+    Stop();
+}
+
+void IPTVStreamHandlerReceiver::Stop(void)
+{
+    m_stop = true;
+    wait();
+}
+
+/// Replaces a slab packet that was handed to the packet buffer.
+/// Must be called with the buffer lock held.
+void IPTVStreamHandlerReceiver::FillSlot(uint slot)
+{
+    m_slab[slot] = m_parent->m_buffer->GetEmptyPacket();
+    // recycled packets already have the space, so this doesn't allocate
+    m_slab[slot].GetDataReference().resize(kMaxDatagramSize);
+}
+
+bool IPTVStreamHandlerReceiver::IsExpectedSender(
+    uint stream, const struct sockaddr_storage &addr) const
+{
+    const QHostAddress &expected = m_sender[stream];
+    if (expected.isNull())
+        return true;
+
+    if (addr.ss_family == AF_INET)
+    {
+        const auto *in = reinterpret_cast<const sockaddr_in*>(&addr);
+        return expected.protocol() == QAbstractSocket::IPv4Protocol &&
+            ntohl(in->sin_addr.s_addr) == expected.toIPv4Address();
+    }
+    if (addr.ss_family == AF_INET6)
+    {
+        const auto *in6 = reinterpret_cast<const sockaddr_in6*>(&addr);
+        Q_IPV6ADDR want = expected.toIPv6Address();
+        return expected.protocol() == QAbstractSocket::IPv6Protocol &&
+            memcmp(&in6->sin6_addr, &want, sizeof(want)) == 0;
+    }
+    return false;
+}
+
+void IPTVStreamHandlerReceiver::run(void)
+{
+    RunProlog();
+
+    LOG(VB_RECORD, LOG_INFO, LOC_RX + "Receiver -- begin");
+
+    std::array<struct pollfd,IPTV_SOCKET_COUNT> polls {};
+    std::array<uint,IPTV_SOCKET_COUNT> streams {};
+    uint count = 0;
+    for (uint i = 0; i < IPTV_SOCKET_COUNT; i++)
+    {
+        if (m_fds[i] < 0)
+            continue;
+        polls[count].fd     = m_fds[i];
+        polls[count].events = POLLIN;
+        streams[count]      = i;
+        count++;
+    }
+
+    while (!m_stop)
+    {
+        int ret = poll(polls.data(), count, 100);
+        if (ret < 0)
+        {
+            if (errno != EINTR)
+            {
+                LOG(VB_GENERAL, LOG_ERR, LOC_RX + "poll() failed" + ENO);
+                usleep(10ms);
+            }
+            continue;
+        }
+
+        for (uint i = 0; i < count; i++)
+        {
+            if (polls[i].revents & POLLIN)
+                ReceiveBatch(streams[i], polls[i].fd);
+        }
+    }
+
+    LOG(VB_RECORD, LOG_INFO, LOC_RX +
+        QString("Receiver -- end, %1 datagrams in %2 batches, "
+                "%3 truncated, %4 from other senders, "
+                "%5 dropped by the kernel")
+        .arg(m_datagrams).arg(m_batches).arg(m_truncated).arg(m_rejected)
+        .arg(m_kernelDrops[0] + m_kernelDrops[1] + m_kernelDrops[2]));
+
+    RunEpilog();
+}
+
+void IPTVStreamHandlerReceiver::ReceiveBatch(uint stream, int fd)
+{
+    std::array<struct mmsghdr,kBatchSize>          msgs {};
+    std::array<struct iovec,kBatchSize>            iovs {};
+    std::array<struct sockaddr_storage,kBatchSize> addrs {};
+    std::array<std::array<char,CMSG_SPACE(sizeof(uint32_t))>,kBatchSize> controls {};
+
+    for (uint i = 0; i < kBatchSize; i++)
+    {
+        QByteArray &data = m_slab[i].GetDataReference();
+        iovs[i].iov_base = data.data();
+        iovs[i].iov_len  = data.size();
+        msgs[i].msg_hdr.msg_iov        = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen     = 1;
+        msgs[i].msg_hdr.msg_name       = &addrs[i];
+        msgs[i].msg_hdr.msg_namelen    = sizeof(addrs[i]);
+        msgs[i].msg_hdr.msg_control    = controls[i].data();
+        msgs[i].msg_hdr.msg_controllen = controls[i].size();
+    }
+
+    int received = recvmmsg(fd, msgs.data(), kBatchSize, MSG_DONTWAIT, nullptr);
+    if (received <= 0)
+    {
+        if (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK &&
+            errno != EINTR)
+        {
+            LOG(VB_RECORD, LOG_ERR, LOC_RX +
+                QString("recvmmsg() on socket(%1) failed").arg(stream) + ENO);
+        }
+        return;
+    }
+    m_batches++;
+
+    uint32_t drops = m_kernelDrops[stream];
+
+    QMutexLocker locker(&m_parent->m_bufferLock);
+    for (int i = 0; i < received; i++)
+    {
+        struct msghdr &hdr = msgs[i].msg_hdr;
+#ifdef SO_RXQ_OVFL
+        for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&hdr); cmsg;
+             cmsg = CMSG_NXTHDR(&hdr, cmsg))
+        {
+            if (cmsg->cmsg_level == SOL_SOCKET &&
+                cmsg->cmsg_type == SO_RXQ_OVFL)
+            {
+                memcpy(&drops, CMSG_DATA(cmsg), sizeof(drops));
+            }
+        }
+#endif
+
+        if (hdr.msg_flags & MSG_TRUNC)
+        {
+            m_truncated++;
+            continue;
+        }
+
+        if (!IsExpectedSender(stream, addrs[i]))
+        {
+            m_rejected++;
+            LOG(VB_RECORD, LOG_WARNING, LOC_RX +
+                QString("Received on socket(%1) %2 bytes from non expected "
+                        "sender (expected:%3) ignoring")
+                .arg(stream).arg(msgs[i].msg_len)
+                .arg(m_sender[stream].toString()));
+            continue;
+        }
+
+        m_slab[i].GetDataReference().resize(msgs[i].msg_len);
+        if (0 == stream)
+            m_parent->m_buffer->PushDataPacket(m_slab[i]);
+        else
+            m_parent->m_buffer->PushFECPacket(m_slab[i], stream - 1);
+        m_datagrams++;
+        FillSlot(i);
+    }
+    locker.unlock();
+
+    if (drops != m_kernelDrops[stream])
+    {
+        LOG(VB_RECORD, LOG_WARNING, LOC_RX +
+            QString("Socket(%1) buffer overflowed, %2 datagrams dropped")
+            .arg(stream).arg(drops - m_kernelDrops[stream]));
+        m_kernelDrops[stream] = drops;
+    }
+}
+
+#endif // USING_RECVMMSG
+
 IPTVStreamHandlerWriteHelper::~IPTVStreamHandlerWriteHelper()
 {
     if (m_timer)
@@ -419,12 +684,15 @@ void IPTVStreamHandlerWriteHelper::timerEvent(QTimerEvent* event)
         return;
     }
 
-    if (!m_parent->m_buffer->HasAvailablePacket())
-        return;
+    {
+        QMutexLocker locker(&m_parent->m_bufferLock);
+        if (!m_parent->m_buffer->HasAvailablePacket())
+            return;
+    }
 
     while (!m_parent->m_useRtpStreaming)
     {
-        UDPPacket packet(m_parent->m_buffer->PopDataPacket());
+        UDPPacket packet(m_parent->PopDataPacket());
 
         if (packet.GetDataReference().isEmpty())
             break;
@@ -433,13 +701,9 @@ void IPTVStreamHandlerWriteHelper::timerEvent(QTimerEvent* event)
         {
             QMutexLocker locker(&m_parent->m_listenerLock);
             QByteArray &data = packet.GetDataReference();
-            for (auto sit = m_parent->m_streamDataList.cbegin();
-                 sit != m_parent->m_streamDataList.cend(); ++sit)
-            {
-                remainder = sit.key()->ProcessData(
-                    reinterpret_cast<const unsigned char*>(data.data()),
-                    data.size());
-            }
+            remainder = m_parent->DistributeData(
+                reinterpret_cast<const unsigned char*>(data.data()),
+                data.size());
         }
 
         if (remainder != 0)
@@ -449,12 +713,12 @@ void IPTVStreamHandlerWriteHelper::timerEvent(QTimerEvent* event)
                 .arg(packet.GetDataReference().size()).arg(remainder));
         }
 
-        m_parent->m_buffer->FreePacket(packet);
+        m_parent->FreePacket(packet);
     }
 
     while (m_parent->m_useRtpStreaming)
     {
-        RTPDataPacket packet(m_parent->m_buffer->PopDataPacket());
+        RTPDataPacket packet(m_parent->PopDataPacket());
 
         if (!packet.IsValid())
             break;
@@ -465,7 +729,7 @@ void IPTVStreamHandlerWriteHelper::timerEvent(QTimerEvent* event)
 
             if (!ts_packet.IsValid())
             {
-                m_parent->m_buffer->FreePacket(packet);
+                m_parent->FreePacket(packet);
                 continue;
             }
 
@@ -491,13 +755,8 @@ void IPTVStreamHandlerWriteHelper::timerEvent(QTimerEvent* event)
 
             m_parent->m_listenerLock.lock();
 
-            int remainder = 0;
-            for (auto sit = m_parent->m_streamDataList.cbegin();
-                 sit != m_parent->m_streamDataList.cend(); ++sit)
-            {
-                remainder = sit.key()->ProcessData(
-                    ts_packet.GetTSData(), ts_packet.GetTSDataSize());
-            }
+            int remainder = m_parent->DistributeData(
+                ts_packet.GetTSData(), ts_packet.GetTSDataSize());
 
             m_parent->m_listenerLock.unlock();
 
@@ -508,7 +767,7 @@ void IPTVStreamHandlerWriteHelper::timerEvent(QTimerEvent* event)
                     .arg(ts_packet.GetTSDataSize()).arg(remainder));
             }
         }
-        m_parent->m_buffer->FreePacket(packet);
+        m_parent->FreePacket(packet);
     }
 }
 
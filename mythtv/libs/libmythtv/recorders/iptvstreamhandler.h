@@ -3,6 +3,7 @@
 #ifndef IPTVSTREAMHANDLER_H
 #define IPTVSTREAMHANDLER_H
 
+#include <atomic>
 #include <vector>
 
 #include <QHostAddress>
@@ -16,8 +17,16 @@
 
 #include "channelutil.h"
 #include "streamhandler.h"
+#include "mthread.h"
+#include "udppacket.h"
 
 #define IPTV_SOCKET_COUNT   3
+
+// Receive datagrams in batches on a dedicated thread where available
+#if defined(__linux__) && !defined(Q_OS_ANDROID)
+#define USING_RECVMMSG 1
+#include <sys/socket.h>
+#endif
 static constexpr std::chrono::milliseconds RTCP_TIMER { 10s };
 
 class IPTVStreamHandler;
@@ -43,6 +52,52 @@ class IPTVStreamHandlerReadHelper : public QObject
     uint               m_stream;
 };
 
+#ifdef USING_RECVMMSG
+/** \class IPTVStreamHandlerReceiver
+ *  \brief Reads the data and FEC sockets with recvmmsg() and feeds
+ *         the packet buffer, instead of a read helper per socket.
+ *
+ *  Datagrams are received directly into a slab of preallocated
+ *  packets, which are replaced by recycled packets from the buffer, so
+ *  no memory is allocated per datagram.
+ */
+class IPTVStreamHandlerReceiver : public MThread
+{
+  public:
+    explicit IPTVStreamHandlerReceiver(IPTVStreamHandler *p);
+    ~IPTVStreamHandlerReceiver() override;
+
+    void Stop(void);
+
+  protected:
+    void run(void) override; // MThread
+
+  private:
+    void ReceiveBatch(uint stream, int fd);
+    bool IsExpectedSender(uint stream, const struct sockaddr_storage &addr) const;
+    void FillSlot(uint slot);
+
+    /// Datagrams read per recvmmsg() call
+    static constexpr uint kBatchSize       { 64 };
+    /// Largest datagram expected, anything longer is counted and dropped
+    static constexpr uint kMaxDatagramSize { 2048 };
+
+    IPTVStreamHandler *m_parent  {nullptr};
+    std::atomic<bool>  m_stop    {false};
+    std::array<int,IPTV_SOCKET_COUNT>          m_fds     {-1, -1, -1};
+    std::array<QHostAddress,IPTV_SOCKET_COUNT> m_sender;
+    std::array<UDPPacket,kBatchSize>           m_slab;
+
+    // statistics
+    uint64_t m_datagrams {0};
+    uint64_t m_batches   {0};
+    uint64_t m_truncated {0};
+    uint64_t m_rejected  {0};
+    /// Datagrams dropped by the kernel because the socket buffer was full
+    std::array<uint32_t,IPTV_SOCKET_COUNT> m_kernelDrops {0, 0, 0};
+};
+#endif // USING_RECVMMSG
+
 class IPTVStreamHandlerWriteHelper : QObject
 {
     Q_OBJECT
@@ -81,6 +136,9 @@ class IPTVStreamHandler : public StreamHandler
 {
     friend class IPTVStreamHandlerReadHelper;
     friend class IPTVStreamHandlerWriteHelper;
+#ifdef USING_RECVMMSG
+    friend class IPTVStreamHandlerReceiver;
+#endif
   public:
     static IPTVStreamHandler *Get(const IPTVTuningData &tuning, int inputid);
     static void Return(IPTVStreamHandler * & ref, int inputid);
@@ -94,18 +152,28 @@ class IPTVStreamHandler : public StreamHandler
         StreamHandler::AddListener(data, false, false, output_file);
     }
 
+    bool GetFECStats(uint64_t &recovered, uint64_t &unrecoverable) const;
+
   protected:
     explicit IPTVStreamHandler(const IPTVTuningData &tuning, int inputid);
 
     void run(void) override; // MThread
 
+    UDPPacket PopDataPacket(void);
+    void FreePacket(const UDPPacket &packet);
+
   protected:
     IPTVTuningData                m_tuning;
     std::array<QUdpSocket*,IPTV_SOCKET_COUNT>                  m_sockets {};
     std::array<IPTVStreamHandlerReadHelper*,IPTV_SOCKET_COUNT> m_readHelpers {};
     std::array<QHostAddress,IPTV_SOCKET_COUNT>                 m_sender;
     IPTVStreamHandlerWriteHelper *m_writeHelper       {nullptr};
+#ifdef USING_RECVMMSG
+    IPTVStreamHandlerReceiver    *m_receiver          {nullptr};
+#endif
     PacketBuffer                 *m_buffer            {nullptr};
+    /// Protects m_buffer when it is filled by m_receiver
+    mutable QMutex                m_bufferLock;
 
     bool                          m_useRtpStreaming;
     ushort                        m_rtspRtpPort       {0};
@@ -7,8 +7,8 @@
 #ifndef PACKET_BUFFER_H
 #define PACKET_BUFFER_H
 
-#include <QList>
-#include <QMap>
+#include <deque>
+#include <vector>
 
 #include "udppacket.h"
 
@@ -40,17 +40,30 @@ class PacketBuffer
      */
     void FreePacket(const UDPPacket &packet);
 
+    /// \brief Returns true once Forward Error Correction packets are seen.
+    bool HasFEC(void) const { return m_fecPackets > 0; }
+    /// \brief Returns the number of packets rebuilt from FEC packets.
+    uint64_t GetFECRecovered(void) const { return m_fecRecovered; }
+    /// \brief Returns the number of packets lost despite FEC.
+    uint64_t GetFECUnrecoverable(void) const { return m_fecUnrecoverable; }
+
   protected:
     uint m_bitrate;
 
+    // FEC statistics
+    uint64_t m_fecPackets       {0};
+    uint64_t m_fecRecovered     {0};
+    uint64_t m_fecUnrecoverable {0};
+
     /// Packets key to use for next empty packet
     uint64_t m_next_empty_packet_key;
     
-    /// Packets ready for reuse
-    QMap<uint64_t, UDPPacket> m_empty_packets;
+    /// Packets ready for reuse, a stack so that no memory is allocated
+    /// once it has grown to the number of packets in flight
+    std::vector<UDPPacket> m_empty_packets;
 
     /// Ordered list of available packets
-    QList<UDPPacket> m_available_packets;
+    std::deque<UDPPacket> m_available_packets;
 };
 
 #endif // PACKET_BUFFER_H
@@ -3,21 +3,76 @@
  * Distributed as part of MythTV under GPL v2 and later.
  */
 
-#include "udppacket.h"
+#include "rtpdatapacket.h"
 
 #ifndef RTP_FEC_PACKET_H
 #define RTP_FEC_PACKET_H
 
 /** \brief RTP FEC Packet
+ *
+ *  SMPTE 2022-1 Forward Error Correction packet. The 16 byte FEC
+ *  header follows the RTP header, the rest of the packet is the XOR
+ *  of everything after the 12 byte RTP header of the protected
+ *  packets, which are NA packets starting at SNBase and Offset
+ *  sequence numbers apart.
  */
-class RTPFECPacket : public UDPPacket
+class RTPFECPacket : public RTPDataPacket
 {
   public:
-    explicit RTPFECPacket(const UDPPacket &o) : UDPPacket(o) { }
-    explicit RTPFECPacket(uint64_t key) : UDPPacket(key) { }
-    RTPFECPacket(void) : UDPPacket(0ULL) { }
+    explicit RTPFECPacket(const UDPPacket &o) : RTPDataPacket(o) { }
+    explicit RTPFECPacket(uint64_t key) : RTPDataPacket(key) { }
+    RTPFECPacket(void) : RTPDataPacket(0ULL) { }
 
-    // TODO
+    bool IsValid(void) const override // RTPDataPacket
+    {
+        return RTPDataPacket::IsValid() &&
+            (m_data.size() >= static_cast<int>(m_off + kHeaderSize)) &&
+            GetOffset() && GetNA();
+    }
+
+    uint GetSNBase(void) const
+    {
+        return qFromBigEndian(*reinterpret_cast<const uint16_t*>(FECHeader()));
+    }
+
+    uint GetLengthRecovery(void) const
+    {
+        return qFromBigEndian(*reinterpret_cast<const uint16_t*>(FECHeader()+2));
+    }
+
+    uint GetPTRecovery(void) const { return FECHeader()[4] & 0x7f; }
+
+    uint GetTSRecovery(void) const
+    {
+        return qFromBigEndian(*reinterpret_cast<const uint32_t*>(FECHeader()+8));
+    }
+
+    /// \brief True for row FEC, false for column FEC
+    bool IsRow(void) const { return (FECHeader()[12] & 0x40) != 0; }
+
+    /// \brief Sequence number step between the protected packets
+    uint GetOffset(void) const { return FECHeader()[13]; }
+
+    /// \brief Number of protected packets
+    uint GetNA(void) const { return FECHeader()[14]; }
+
+    const unsigned char *GetFECData(void) const
+    {
+        return FECHeader() + kHeaderSize;
+    }
+
+    uint GetFECDataSize(void) const
+    {
+        return m_data.size() - m_off - kHeaderSize;
+    }
+
+    static constexpr uint kHeaderSize { 16 };
+
+  private:
+    const unsigned char *FECHeader(void) const
+    {
+        return reinterpret_cast<const unsigned char*>(m_data.data()) + m_off;
+    }
 };
 
 #endif // RTP_FEC_PACKET_H
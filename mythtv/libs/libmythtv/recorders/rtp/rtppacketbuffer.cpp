@@ -5,68 +5,320 @@
  */
 
 #include <algorithm>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #include "rtppacketbuffer.h"
 #include "rtpdatapacket.h"
 #include "rtpfecpacket.h"
 
+/// Size of the RTP header that FEC does not protect
+static constexpr uint kRTPHeaderSize { 12 };
+
+/// XORs len bytes of src into dst, 16 bytes at a time where possible
+static void xor_into(unsigned char *dst, const unsigned char *src, uint len)
+{
+    uint i = 0;
+#ifdef __SSE2__
+    for (; i + 16 <= len; i += 16)
+    {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm_xor_si128(a, b));
+    }
+#endif
+    for (; i + 8 <= len; i += 8)
+    {
+        uint64_t a = 0;
+        uint64_t b = 0;
+        memcpy(&a, dst + i, sizeof(a));
+        memcpy(&b, src + i, sizeof(b));
+        a ^= b;
+        memcpy(dst + i, &a, sizeof(a));
+    }
+    for (; i < len; i++)
+        dst[i] ^= src[i];
+}
+
+RTPPacketBuffer::RTPPacketBuffer(unsigned int bitrate) :
+    PacketBuffer(bitrate),
+    m_window(kWindowSize),
+    m_windowKeys(kWindowSize, kNoKey)
+{
+}
+
+/// Returns the extended sequence number closest to the newest one seen
+/// which has seq as its low 16 bits.
+uint64_t RTPPacketBuffer::ExtendSequenceNumber(uint seq) const
+{
+    auto diff = static_cast<int16_t>(static_cast<uint16_t>(seq - m_lastKey));
+    return m_lastKey + diff;
+}
+
 void RTPPacketBuffer::PushDataPacket(const UDPPacket &udp_packet)
 {
     RTPDataPacket packet(udp_packet);
 
-    uint key = packet.GetSequenceNumber();
+    if (!packet.IsValid())
+    {
+        FreePacket(packet);
+        return;
+    }
+
+    if (!m_started)
+    {
+        m_started = true;
+        Restart(packet.GetSequenceNumber() + (1ULL<<16));
+    }
 
-    bool large_was_seen_recently = m_largeSequenceNumberSeenRecently > 0;
-    m_largeSequenceNumberSeenRecently = 
-        (key > (1U<<15)) ? 500 : m_largeSequenceNumberSeenRecently - 1;
-    m_largeSequenceNumberSeenRecently =
-        std::max(m_largeSequenceNumberSeenRecently, 0);
+    uint64_t key = ExtendSequenceNumber(packet.GetSequenceNumber());
 
-    if (m_largeSequenceNumberSeenRecently > 0)
+    if (key < m_nextKey)
     {
-        if (key < 500) 
-            key += 1ULL<<16;
+        if (m_nextKey - key <= kWindowSize)
+        {
+            // too late, the packets after it have been released
+            FreePacket(packet);
+            return;
+        }
+        // the sender restarted the sequence numbers
+        ReleasePackets(m_lastKey + 1);
+        Restart(key);
     }
-    else if (large_was_seen_recently)
+    else if (key >= m_nextKey + kWindowSize)
     {
-        m_currentSequence += 1ULL<<16;
+        // a jump forward that doesn't fit in the window
+        ReleasePackets(m_lastKey + 1);
+        Restart(key);
     }
 
-    key += m_currentSequence;
-
 /*
-    LOG(VB_RECORD, LOG_DEBUG, QString("Pushing %1 as %2 (lr %3)")
-        .arg(packet.GetSequenceNumber()).arg(key)
-        .arg(m_largeSequenceNumberSeenRecently));
+    LOG(VB_RECORD, LOG_DEBUG, QString("Pushing %1 as %2")
+        .arg(packet.GetSequenceNumber()).arg(key));
 */
 
-    m_unorderedPackets[key] = packet;
+    if (!InsertPacket(key, packet))
+        return;
+
+    // A late packet, or the end of a group, may let FEC recover a packet
+    bool retry = false;
+    for (const auto & fec : m_pendingFEC)
+        retry |= fec.Covers(key) || (!fec.m_pastEnd && key > fec.End());
+    if (retry)
+        RetryPendingFEC();
+
+    if (m_lastKey >= m_nextKey + m_reorderDelay)
+        ReleasePackets(m_lastKey + 1 - m_reorderDelay);
+}
+
+/** \fn RTPPacketBuffer::PushFECPacket(const UDPPacket&,uint)
+ *  \brief Uses a SMPTE 2022-1 row or column FEC packet to recover a lost
+ *         packet, or keeps it until only one of its packets is missing.
+ *
+ *  Whether it is a row or column packet doesn't matter, the FEC header
+ *  says which packets it protects.
+ */
+void RTPPacketBuffer::PushFECPacket(
+    const UDPPacket &packet, uint /*fec_stream_num*/)
+{
+    RTPFECPacket fec_packet(packet);
+
+    if (!m_started || !fec_packet.IsValid())
+    {
+        FreePacket(packet);
+        return;
+    }
+    m_fecPackets++;
+
+    PendingFEC fec;
+    fec.m_packet = fec_packet;
+    fec.m_base   = ExtendSequenceNumber(fec_packet.GetSNBase());
+    fec.m_offset = fec_packet.GetOffset();
+    fec.m_count  = fec_packet.GetNA();
+
+    // A column covers L x D packets and its FEC packet may be sent up
+    // to a whole matrix later, so keep two matrices for reordering.
+    uint span = ((fec.m_count - 1) * fec.m_offset) + 1;
+    if (span > m_fecSpan)
+    {
+        m_fecSpan = span;
+        m_reorderDelay = std::clamp(2 * span, kMinReorderDelay, kReorderDelay);
+    }
+
+    switch (RecoverPacket(fec))
+    {
+        case kFECPending:
+            fec.m_pastEnd = m_lastKey > fec.End();
+            if (m_pendingFEC.size() >= kMaxPendingFEC)
+            {
+                FreePacket(m_pendingFEC.front().m_packet);
+                m_pendingFEC.erase(m_pendingFEC.begin());
+            }
+            m_pendingFEC.push_back(fec);
+            break;
+        case kFECRecovered:
+            FreePacket(packet);
+            RetryPendingFEC();
+            break;
+        case kFECDone:
+            FreePacket(packet);
+            break;
+    }
+}
+
+bool RTPPacketBuffer::InsertPacket(uint64_t key, const RTPDataPacket &packet)
+{
+    uint slot = key & (kWindowSize - 1);
+    if (m_windowKeys[slot] == key)
+    {
+        FreePacket(packet); // duplicate
+        return false;
+    }
+    m_window[slot]     = packet;
+    m_windowKeys[slot] = key;
+    m_lastKey = std::max(m_lastKey, key);
+    return true;
+}
 
-    // TODO pushing packets onto the ordered list should be based on
-    // the bitrate and the M+N of the FEC.. but for now...
-    const int kHighWaterMark = 500;
-    const int kLowWaterMark  = 100;
-    if (m_unorderedPackets.size() > kHighWaterMark)
+/// Makes the packets before end available in order
+void RTPPacketBuffer::ReleasePackets(uint64_t end)
+{
+    for (; m_nextKey < end; m_nextKey++)
     {
-        while (m_unorderedPackets.size() > kLowWaterMark)
+        uint slot = m_nextKey & (kWindowSize - 1);
+        if (m_windowKeys[slot] == m_nextKey)
         {
-            QMap<uint64_t, RTPDataPacket>::iterator it =
-                m_unorderedPackets.begin();
-/*
-            LOG(VB_RECORD, LOG_DEBUG, QString("Popping %1 as %2")
-                .arg((*it).GetSequenceNumber()).arg(it.key()));
-*/
-            m_available_packets.push_back(*it);
-            m_unorderedPackets.erase(it);
+            m_available_packets.push_back(m_window[slot]);
+            m_window[slot]     = RTPDataPacket();
+            m_windowKeys[slot] = kNoKey;
+        }
+        else if (HasFEC())
+        {
+            m_fecUnrecoverable++;
         }
     }
+
+    // FEC packets protecting released packets are no use any more
+    auto keep = m_pendingFEC.begin();
+    for (auto & fec : m_pendingFEC)
+    {
+        if (fec.m_base < m_nextKey)
+            FreePacket(fec.m_packet);
+        else
+            *keep++ = fec;
+    }
+    m_pendingFEC.erase(keep, m_pendingFEC.end());
 }
 
-void RTPPacketBuffer::PushFECPacket(
-    const UDPPacket &packet, uint fec_stream_num)
+void RTPPacketBuffer::Restart(uint64_t key)
+{
+    for (const auto & fec : m_pendingFEC)
+        FreePacket(fec.m_packet);
+    m_pendingFEC.clear();
+    m_nextKey = key;
+    m_lastKey = key;
+}
+
+/** \fn RTPPacketBuffer::RecoverPacket(const PendingFEC&)
+ *  \brief Rebuilds the packet missing from an FEC group if all the
+ *         others are in the reorder window.
+ */
+RTPPacketBuffer::FECResult RTPPacketBuffer::RecoverPacket(const PendingFEC &fec)
 {
-    (void) fec_stream_num;
-    // TODO IMPLEMENT
-    // for now just free the packet for immediate reuse
-    FreePacket(packet);
+    uint64_t missing = kNoKey;
+    for (uint i = 0; i < fec.m_count; i++)
+    {
+        uint64_t key = fec.m_base + (static_cast<uint64_t>(i) * fec.m_offset);
+        if (key < m_nextKey || key >= m_nextKey + kWindowSize)
+            return kFECDone;
+        if (m_windowKeys[key & (kWindowSize - 1)] == key)
+            continue;
+        // more than one packet missing, or it may still arrive
+        if (missing != kNoKey || key > m_lastKey)
+            return kFECPending;
+        missing = key;
+    }
+    if (missing == kNoKey)
+        return kFECDone;
+
+    const RTPFECPacket &fec_packet = fec.m_packet;
+    uint     size   = fec_packet.GetFECDataSize();
+    uint     length = fec_packet.GetLengthRecovery();
+    uint     pt     = fec_packet.GetPTRecovery();
+    uint32_t ts     = fec_packet.GetTSRecovery();
+
+    UDPPacket recovered(GetEmptyPacket());
+    QByteArray &data = recovered.GetDataReference();
+    data.resize(kRTPHeaderSize + size);
+    auto *out = reinterpret_cast<unsigned char*>(data.data());
+    memcpy(out + kRTPHeaderSize, fec_packet.GetFECData(), size);
+
+    // First byte and SSRC are the same for all the packets of a stream
+    out[0] = 0x80;
+    memset(out + 8, 0, 4);
+
+    for (uint i = 0; i < fec.m_count; i++)
+    {
+        uint64_t key = fec.m_base + (static_cast<uint64_t>(i) * fec.m_offset);
+        if (key == missing)
+            continue;
+        RTPDataPacket &packet = m_window[key & (kWindowSize - 1)];
+        const QByteArray &pdata = packet.GetDataReference();
+        const auto *in = reinterpret_cast<const unsigned char*>(pdata.constData());
+        uint len = pdata.size() - kRTPHeaderSize;
+
+        length ^= len;
+        pt     ^= packet.GetPayloadType();
+        ts     ^= packet.GetTimeStamp();
+        xor_into(out + kRTPHeaderSize, in + kRTPHeaderSize, std::min(len, size));
+
+        out[0] = in[0];
+        memcpy(out + 8, in + 8, 4);
+    }
+
+    if (length > size)
+    {
+        // The FEC packet doesn't match the packets it protects
+        FreePacket(recovered);
+        return kFECDone;
+    }
+
+    out[1] = pt & 0x7f;
+    qToBigEndian(static_cast<uint16_t>(missing & 0xffff), out + 2);
+    qToBigEndian(ts, out + 4);
+    data.resize(kRTPHeaderSize + length);
+
+    InsertPacket(missing, RTPDataPacket(recovered));
+    m_fecRecovered++;
+
+    return kFECRecovered;
+}
+
+/// Tries the pending FEC packets until no more packets can be recovered,
+/// a recovered packet may complete another row or column.
+void RTPPacketBuffer::RetryPendingFEC(void)
+{
+    bool progress = true;
+    while (progress)
+    {
+        progress = false;
+        for (size_t i = 0; i < m_pendingFEC.size(); )
+        {
+            PendingFEC &fec = m_pendingFEC[i];
+            FECResult result = RecoverPacket(fec);
+            if (result == kFECPending)
+            {
+                fec.m_pastEnd = m_lastKey > fec.End();
+                i++;
+                continue;
+            }
+            progress |= (result == kFECRecovered);
+            FreePacket(fec.m_packet);
+            m_pendingFEC.erase(m_pendingFEC.begin() + i);
+        }
+    }
 }
@@ -7,16 +7,16 @@
 #ifndef RTP_PACKET_BUFFER_H
 #define RTP_PACKET_BUFFER_H
 
-#include <QMap>
+#include <vector>
 
 #include "rtpdatapacket.h"
+#include "rtpfecpacket.h"
 #include "packetbuffer.h"
 
 class RTPPacketBuffer : public PacketBuffer
 {
   public:
-    explicit RTPPacketBuffer(unsigned int bitrate) :
-        PacketBuffer(bitrate) {}
+    explicit RTPPacketBuffer(unsigned int bitrate);
 
     /// Adds RFC 3550 RTP data packet
     void PushDataPacket(const UDPPacket &udp_packet) override; // PacketBuffer
@@ -25,11 +25,68 @@ class RTPPacketBuffer : public PacketBuffer
     void PushFECPacket(const UDPPacket &packet, unsigned int fec_stream_num) override; // PacketBuffer
 
   private:
-    int      m_largeSequenceNumberSeenRecently { 0   };
-    uint64_t m_currentSequence                 { 0LL };
+    /// An FEC packet waiting for all but one of its packets to arrive
+    class PendingFEC
+    {
+      public:
+        RTPFECPacket m_packet;
+        uint64_t     m_base    {0};
+        uint         m_offset  {0};
+        uint         m_count   {0};
+        /// True once packets newer than the last protected one arrived
+        bool         m_pastEnd {false};
 
-    /// The key is the RTP sequence number + sequence if applicable
-    QMap<uint64_t, RTPDataPacket> m_unorderedPackets;
+        uint64_t End(void) const
+        {
+            return m_base + (static_cast<uint64_t>(m_count - 1) * m_offset);
+        }
+
+        bool Covers(uint64_t key) const
+        {
+            return key >= m_base && ((key - m_base) % m_offset) == 0 &&
+                ((key - m_base) / m_offset) < m_count;
+        }
+    };
+
+    enum FECResult : std::uint8_t
+    {
+        kFECDone,       ///< nothing to recover, or too late to do so
+        kFECRecovered,  ///< recovered the one missing packet
+        kFECPending,    ///< more than one packet missing so far
+    };
+
+    uint64_t ExtendSequenceNumber(uint seq) const;
+    bool InsertPacket(uint64_t key, const RTPDataPacket &packet);
+    void ReleasePackets(uint64_t end);
+    void Restart(uint64_t key);
+    FECResult RecoverPacket(const PendingFEC &fec);
+    void RetryPendingFEC(void);
+
+    /// Packets kept for reordering and FEC, must be a power of two
+    /// larger than kReorderDelay plus the largest FEC matrix.
+    static constexpr uint     kWindowSize   { 1024 };
+    /// Packets are released once this many newer ones have arrived,
+    /// until FEC packets give the size of the FEC matrix
+    static constexpr uint     kReorderDelay { 500 };
+    static constexpr uint     kMinReorderDelay { 32 };
+    static constexpr uint     kMaxPendingFEC { 64 };
+    static constexpr uint64_t kNoKey        { UINT64_MAX };
+
+    bool     m_started { false };
+    /// The RTP sequence number extended to 64 bits of the next packet
+    /// to release
+    uint64_t m_nextKey { 0 };
+    /// The newest extended sequence number seen
+    uint64_t m_lastKey { 0 };
+    /// The most packets spanned by an FEC row or column so far
+    uint     m_fecSpan { 0 };
+    uint     m_reorderDelay { kReorderDelay };
+
+    /// Reorder window indexed by extended sequence number
+    std::vector<RTPDataPacket> m_window;
+    std::vector<uint64_t>      m_windowKeys;
+
+    std::vector<PendingFEC>    m_pendingFEC;
 };
 
 #endif // RTP_PACKET_BUFFER_H
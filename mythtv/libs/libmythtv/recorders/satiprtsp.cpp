@@ -546,10 +546,7 @@ void SatIPWriteHelper::timerEvent(QTimerEvent* /*event*/)
                         const unsigned char *data_buffer = ts_packet.GetTSData();
                         size_t data_length = ts_packet.GetTSDataSize();
 
-                        for (auto sit = streamDataList.cbegin(); sit != streamDataList.cend(); ++sit)
-                        {
-                            remainder = sit.key()->ProcessData(data_buffer, data_length);
-                        }
+                        remainder = m_streamHandler->DistributeData(data_buffer, data_length);
 
                         m_streamHandler->WriteMPTS(data_buffer, data_length - remainder);
                     }
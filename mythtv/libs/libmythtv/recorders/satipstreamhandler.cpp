@@ -110,6 +110,7 @@ SatIPStreamHandler::SatIPStreamHandler(const QString &device, int inputid)
     , m_rtsp(new SatIPRTSP(this))
 {
     setObjectName("SatIPStreamHandler");
+    m_fanoutCapable = true;
 
     LOG(VB_RECORD, LOG_DEBUG, LOC +
         QString("ctor for %2").arg(device));
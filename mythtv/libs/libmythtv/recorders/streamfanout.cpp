@@ -0,0 +1,297 @@
+// -*- Mode: c++ -*-
+
+// C++ headers
+#include <algorithm>
+
+// MythTV headers
+#include "streamfanout.h"
+#include "mpegstreamdata.h"
+#include "tspacket.h"
+#include "tssync.h"
+#include "mythcorecontext.h"
+#include "mythlogging.h"
+#include "mythtimer.h"
+
+#define LOC      QString("SFO[%1]: ").arg(m_inputId)
+
+StreamFanoutWorker::StreamFanoutWorker(MPEGStreamData *data, int inputid,
+                                       uint64_t max_queued)
+    : MThread("StreamFanout"), m_streamData(data), m_inputId(inputid),
+      m_maxQueued(max_queued)
+{
+}
+
+StreamFanoutWorker::~StreamFanoutWorker()
+{
+    Stop();
+}
+
+/** \fn StreamFanoutWorker::Push(const QByteArray&)
+ *  \brief Queues a read block for this listener.
+ *
+ *  This is called by the reader with the listener lock held, so it
+ *  never waits. If the listener has fallen more than m_maxQueued bytes
+ *  behind the block is dropped instead, and counted so that slow
+ *  listeners can be identified.
+ */
+void StreamFanoutWorker::Push(const QByteArray &block)
+{
+    QMutexLocker locker(&m_lock);
+
+    if (m_stop)
+        return;
+
+    if (m_queuedBytes + block.size() > m_maxQueued && !m_queue.empty())
+    {
+        if (!m_overflowing)
+        {
+            LOG(VB_GENERAL, LOG_WARNING, LOC +
+                QString("Listener(0x%1) is %2 bytes behind, dropping data")
+                .arg((uint64_t)m_streamData,0,16).arg(m_queuedBytes));
+        }
+        m_overflowing = true;
+        m_stats.m_dropped++;
+        m_stats.m_droppedBytes += block.size();
+        return;
+    }
+
+    m_overflowing = false;
+    m_queue.enqueue(block);
+    m_queuedBytes += block.size();
+    m_stats.m_maxQueued = std::max(m_stats.m_maxQueued, m_queuedBytes);
+    m_hasData.wakeAll();
+}
+
+/** \fn StreamFanoutWorker::Stop(void)
+ *  \brief Processes any queued blocks and then stops the thread.
+ *
+ *  This also waits for anyone holding the process lock, after it
+ *  returns the stream data is no longer touched, see
+ *  StreamFanout::ForEachListener().
+ */
+void StreamFanoutWorker::Stop(void)
+{
+    {
+        QMutexLocker locker(&m_lock);
+        m_stop = true;
+        m_hasData.wakeAll();
+    }
+    wait();
+
+    QMutexLocker process_locker(&m_processLock);
+}
+
+bool StreamFanoutWorker::IsStopping(void) const
+{
+    QMutexLocker locker(&m_lock);
+    return m_stop;
+}
+
+StreamFanoutStats StreamFanoutWorker::GetStats(void) const
+{
+    QMutexLocker locker(&m_lock);
+    return m_stats;
+}
+
+QString StreamFanoutWorker::GetStatsString(void) const
+{
+    StreamFanoutStats stats = GetStats();
+    return QString("blocks %1, bytes %2, max queued %3, "
+                   "dropped %4 blocks of %5 bytes, "
+                   "slowest block %6 ms")
+        .arg(stats.m_blocks).arg(stats.m_bytes).arg(stats.m_maxQueued)
+        .arg(stats.m_dropped).arg(stats.m_droppedBytes)
+        .arg(stats.m_maxProcessTime.count() / 1000);
+}
+
+void StreamFanoutWorker::run(void)
+{
+    RunProlog();
+
+    LOG(VB_RECORD, LOG_DEBUG, LOC + QString("Worker(0x%1) -- begin")
+        .arg((uint64_t)m_streamData,0,16));
+
+    MythTimer t;
+    QMutexLocker locker(&m_lock);
+    while (true)
+    {
+        if (m_queue.empty())
+        {
+            if (m_stop)
+                break;
+            m_hasData.wait(&m_lock, 100);
+            continue;
+        }
+
+        QByteArray block = m_queue.dequeue();
+        locker.unlock();
+
+        t.start();
+        {
+            QMutexLocker process_locker(&m_processLock);
+            m_streamData->ProcessData(
+                reinterpret_cast<const unsigned char*>(block.constData()),
+                block.size());
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>
+            (t.nsecsElapsed());
+
+        locker.relock();
+        m_queuedBytes -= block.size();
+        m_stats.m_blocks++;
+        m_stats.m_bytes += block.size();
+        m_stats.m_maxProcessTime = std::max(m_stats.m_maxProcessTime, elapsed);
+    }
+    locker.unlock();
+
+    LOG(VB_RECORD, LOG_DEBUG, LOC + QString("Worker(0x%1) -- end")
+        .arg((uint64_t)m_streamData,0,16));
+
+    RunEpilog();
+}
+
+/** \fn StreamFanout::StreamFanout(int)
+ *  \brief Creates a fan-out whose listeners may each fall behind by
+ *         as much as the DeviceReadBuffer of a recorder holds.
+ */
+StreamFanout::StreamFanout(int inputid)
+    : m_inputId(inputid),
+      m_maxQueued(gCoreContext->GetNumSetting(
+          "HDRingbufferSize", static_cast<int>(50 * TSPacket::kSize)) * 1024ULL)
+{
+}
+
+StreamFanout::~StreamFanout()
+{
+    QList<WorkerPtr> workers;
+    {
+        QMutexLocker locker(&m_lock);
+        workers.swap(m_workers);
+    }
+    for (const auto & worker : qAsConst(workers))
+        worker->Stop();
+}
+
+void StreamFanout::AddListener(MPEGStreamData *data)
+{
+    WorkerPtr worker(new StreamFanoutWorker(data, m_inputId, m_maxQueued));
+    worker->start();
+
+    QMutexLocker locker(&m_lock);
+    m_workers.push_back(worker);
+}
+
+/** \fn StreamFanout::RemoveListener(MPEGStreamData*)
+ *  \brief Stops passing data to the listener.
+ *
+ *  The listener's thread may still be draining its queue, it must be
+ *  stopped with StopListener() before the stream data is deleted.
+ *  As that can take a while, do so without holding any locks the
+ *  reader needs.
+ *
+ *  \return the listener's worker, or nullptr if the listener is not known.
+ */
+StreamFanout::WorkerPtr StreamFanout::RemoveListener(MPEGStreamData *data)
+{
+    QMutexLocker locker(&m_lock);
+    auto it = std::find_if(m_workers.begin(), m_workers.end(),
+                           [data](const WorkerPtr &w)
+                               { return w->GetStreamData() == data; });
+    if (it == m_workers.end())
+        return {};
+    WorkerPtr worker = *it;
+    m_workers.erase(it);
+    return worker;
+}
+
+/// \brief Drains the listener's queue, stops its thread and logs
+///        its back-pressure statistics.
+void StreamFanout::StopListener(const WorkerPtr &worker)
+{
+    if (!worker)
+        return;
+
+    worker->Stop();
+
+    LOG(VB_RECORD, LOG_INFO, QString("SFO[%1]: Listener(0x%2): %3")
+        .arg(worker->GetInputId())
+        .arg((uint64_t)worker->GetStreamData(),0,16)
+        .arg(worker->GetStatsString()));
+}
+
+bool StreamFanout::IsEmpty(void) const
+{
+    QMutexLocker locker(&m_lock);
+    return m_workers.empty();
+}
+
+/** \fn StreamFanout::Publish(const unsigned char*,int)
+ *  \brief Queues a copy of the buffer for every listener.
+ *
+ *  The buffer should only contain whole packets, see Remainder().
+ */
+void StreamFanout::Publish(const unsigned char *buffer, int len)
+{
+    if (len <= 0)
+        return;
+
+    QList<WorkerPtr> workers;
+    {
+        QMutexLocker locker(&m_lock);
+        workers = m_workers;
+    }
+
+    QByteArray block(reinterpret_cast<const char*>(buffer), len);
+    for (const auto & worker : qAsConst(workers))
+        worker->Push(block);
+}
+
+/** \fn StreamFanout::ForEachListener(const std::function<void(MPEGStreamData*)>&) const
+ *  \brief Calls func with the stream data of every listener, while
+ *         that listener is not processing data.
+ *
+ *  Listeners that are being stopped are skipped, so this may be
+ *  called without holding the StreamHandler's listener lock.
+ */
+void StreamFanout::ForEachListener(
+    const std::function<void(MPEGStreamData*)> &func) const
+{
+    QList<WorkerPtr> workers;
+    {
+        QMutexLocker locker(&m_lock);
+        workers = m_workers;
+    }
+
+    for (const auto & worker : qAsConst(workers))
+    {
+        QMutexLocker process_locker(worker->GetProcessLock());
+        if (!worker->IsStopping())
+            func(worker->GetStreamData());
+    }
+}
+
+/** \fn StreamFanout::Remainder(const unsigned char*,int)
+ *  \brief Returns the number of bytes at the end of the buffer that
+ *         do not form a complete transport stream packet.
+ *
+ *  This follows the packet walk of MPEGStreamData::ProcessData(), so
+ *  the reader can keep the remainder without waiting for listeners.
+ */
+int StreamFanout::Remainder(const unsigned char *buffer, int len)
+{
+    int pos = 0;
+    while (pos + int(TSPacket::kSize) <= len)
+    {
+        if (buffer[pos] != SYNC_BYTE)
+        {
+            int newpos = TSSync::FindSync(buffer, pos + 1, len);
+            if (newpos == -1)
+                return len - pos;
+            if (newpos == -2)
+                return TSPacket::kSize;
+            pos = newpos;
+        }
+        pos += TSPacket::kSize;
+    }
+    return len - pos;
+}
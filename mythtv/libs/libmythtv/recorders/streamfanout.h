@@ -0,0 +1,113 @@
+// -*- Mode: c++ -*-
+
+#ifndef STREAM_FANOUT_H
+#define STREAM_FANOUT_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+// Qt headers
+#include <QByteArray>
+#include <QMutex>
+#include <QQueue>
+#include <QSharedPointer>
+#include <QString>
+#include <QWaitCondition>
+
+// MythTV headers
+#include "mthread.h"
+
+class MPEGStreamData;
+
+/// Back-pressure statistics for a single fan-out listener
+class StreamFanoutStats
+{
+  public:
+    uint64_t m_blocks        {0}; ///< Read blocks processed
+    uint64_t m_bytes         {0}; ///< Bytes processed
+    uint64_t m_maxQueued     {0}; ///< High water mark of queued bytes
+    uint64_t m_dropped       {0}; ///< Read blocks dropped on a full queue
+    uint64_t m_droppedBytes  {0}; ///< Bytes dropped on a full queue
+    std::chrono::microseconds m_maxProcessTime {0}; ///< Slowest ProcessData()
+};
+
+/** \class StreamFanoutWorker
+ *  \brief Services the read block queue of a single MPEGStreamData
+ *         listener on its own thread.
+ */
+class StreamFanoutWorker : public MThread
+{
+  public:
+    StreamFanoutWorker(MPEGStreamData *data, int inputid, uint64_t max_queued);
+    ~StreamFanoutWorker() override;
+
+    void Push(const QByteArray &block);
+    void Stop(void);
+
+    MPEGStreamData *GetStreamData(void) const { return m_streamData; }
+    int GetInputId(void) const { return m_inputId; }
+    bool IsStopping(void) const;
+    /// Held while ProcessData() runs, lock it to touch the stream data
+    /// from another thread.
+    QMutex *GetProcessLock(void) { return &m_processLock; }
+    StreamFanoutStats GetStats(void) const;
+    QString GetStatsString(void) const;
+
+  protected:
+    void run(void) override; // MThread
+
+  private:
+    MPEGStreamData        *m_streamData  {nullptr};
+    int                    m_inputId     {-1};
+    /// Maximum bytes queued for the listener before blocks are dropped
+    uint64_t               m_maxQueued   {0};
+
+    mutable QMutex         m_lock;
+    QWaitCondition         m_hasData;
+    QQueue<QByteArray>     m_queue;         // protected by m_lock
+    uint64_t               m_queuedBytes {0}; // protected by m_lock
+    bool                   m_stop        {false}; // protected by m_lock
+    bool                   m_overflowing {false}; // protected by m_lock
+    StreamFanoutStats      m_stats;         // protected by m_lock
+
+    QMutex                 m_processLock;
+};
+
+/** \class StreamFanout
+ *  \brief Distributes transport stream read blocks to each listener of
+ *         a StreamHandler through per-listener queues and threads.
+ *
+ *  Each read block is copied once into a reference counted QByteArray
+ *  which is then shared by every listener queue, so a slow listener
+ *  only delays itself. The reader never waits for a listener, once a
+ *  listener has fallen as far behind as the device ring buffer holds,
+ *  see the HDRingbufferSize setting, its read blocks are dropped.
+ */
+class StreamFanout
+{
+  public:
+    using WorkerPtr = QSharedPointer<StreamFanoutWorker>;
+
+    explicit StreamFanout(int inputid);
+    ~StreamFanout();
+
+    void AddListener(MPEGStreamData *data);
+    WorkerPtr RemoveListener(MPEGStreamData *data);
+    static void StopListener(const WorkerPtr &worker);
+    bool IsEmpty(void) const;
+
+    void Publish(const unsigned char *buffer, int len);
+    void ForEachListener(
+        const std::function<void(MPEGStreamData*)> &func) const;
+
+    static int Remainder(const unsigned char *buffer, int len);
+
+  private:
+    int                    m_inputId   {-1};
+    uint64_t               m_maxQueued {0};
+    mutable QMutex         m_lock;
+    QList<WorkerPtr>       m_workers;   // protected by m_lock
+};
+
+#endif // STREAM_FANOUT_H
@@ -2,8 +2,10 @@
 
 // MythTV headers
 #include "streamhandler.h"
+#include "streamfanout.h"
 
 #include "threadedfilewriter.h"
+#include "mythcorecontext.h"
 #include <utility>
 
 #ifndef O_LARGEFILE
@@ -57,6 +59,13 @@ void StreamHandler::AddListener(MPEGStreamData *data,
         QMutexLocker locker2(&m_startStopLock);
         m_allowSectionReader = allow_section_reader;
         m_needsBuffering     = needs_buffering;
+
+        if (m_fanoutCapable && !m_fanout &&
+            gCoreContext->GetBoolSetting("StreamHandlerFanout", false))
+        {
+            LOG(VB_RECORD, LOG_INFO, LOC + "Using per-listener fan-out");
+            m_fanout.reset(new StreamFanout(m_inputId));
+        }
     }
     else
     {
@@ -67,6 +76,9 @@ void StreamHandler::AddListener(MPEGStreamData *data,
 
     m_streamDataList[data] = output_file;
 
+    if (m_fanout)
+        m_fanout->AddListener(data);
+
     m_listenerLock.unlock();
 
     Start();
@@ -103,8 +115,19 @@ void StreamHandler::RemoveListener(MPEGStreamData *data)
         m_streamDataList.erase(it);
     }
 
+    StreamFanout::WorkerPtr worker;
+    if (m_fanout)
+    {
+        worker = m_fanout->RemoveListener(data);
+        if (m_fanout->IsEmpty())
+            m_fanout.reset();
+    }
+
     m_listenerLock.unlock();
 
+    // Let the listener drain its queue without holding up the reader
+    StreamFanout::StopListener(worker);
+
     if (m_streamDataList.empty())
         Stop();
 
@@ -256,14 +279,11 @@ bool StreamHandler::RemoveAllPIDFilters(void)
 
 void StreamHandler::UpdateListeningForEIT(void)
 {
-    QMutexLocker read_locker(&m_listenerLock);
-
-    for (auto it1 = m_streamDataList.cbegin(); it1 != m_streamDataList.cend(); ++it1)
+    ForEachListener([this](MPEGStreamData *sd)
     {
         std::vector<uint> add_eit;
         std::vector<uint> del_eit;
 
-        MPEGStreamData *sd = it1.key();
         if (sd->HasEITPIDChanges(m_eitPids) &&
             sd->GetEITPIDChanges(m_eitPids, add_eit, del_eit))
         {
@@ -282,7 +302,7 @@ void StreamHandler::UpdateListeningForEIT(void)
                 sd->AddListeningPID(eit);
             }
         }
-    }
+    });
 }
 
 bool StreamHandler::UpdateFiltersFromStreamData(void)
@@ -290,12 +310,7 @@ bool StreamHandler::UpdateFiltersFromStreamData(void)
     UpdateListeningForEIT();
 
     pid_map_t pids;
-
-    {
-        QMutexLocker read_locker(&m_listenerLock);
-        for (auto it = m_streamDataList.cbegin(); it != m_streamDataList.cend(); ++it)
-            it.key()->GetPIDs(pids);
-    }
+    ForEachListener([&pids](MPEGStreamData *sd) { sd->GetPIDs(pids); });
 
     QMap<uint, PIDInfo*> add_pids;
     std::vector<uint>    del_pids;
@@ -340,16 +355,67 @@ bool StreamHandler::UpdateFiltersFromStreamData(void)
 
 PIDPriority StreamHandler::GetPIDPriority(uint pid) const
 {
-    QMutexLocker reading_locker(&m_listenerLock);
-
     PIDPriority tmp = kPIDPriorityNone;
 
-    for (auto it = m_streamDataList.cbegin(); it != m_streamDataList.cend(); ++it)
-        tmp = std::max(tmp, it.key()->GetPIDPriority(pid));
+    ForEachListener([pid, &tmp](MPEGStreamData *sd)
+        { tmp = std::max(tmp, sd->GetPIDPriority(pid)); });
 
     return tmp;
 }
 
+/** \fn StreamHandler::DistributeData(const unsigned char*,int)
+ *  \brief Passes a read block to every listener.
+ *
+ *  Normally each listener's ProcessData() is called in turn on the
+ *  reader thread. When the "StreamHandlerFanout" setting is enabled
+ *  the whole packets in the block are instead queued for the
+ *  per-listener worker threads, so that one slow listener does not
+ *  hold up the others or the device reads.
+ *
+ *  \return number of bytes at the end of the buffer that were not
+ *          processed and should be passed in again with the next read.
+ */
+int StreamHandler::DistributeData(const unsigned char *buffer, int len)
+{
+    if (m_fanout)
+    {
+        int remainder = StreamFanout::Remainder(buffer, len);
+        m_fanout->Publish(buffer, len - remainder);
+        return remainder;
+    }
+
+    int remainder = 0;
+    for (auto sit = m_streamDataList.cbegin(); sit != m_streamDataList.cend(); ++sit)
+        remainder = sit.key()->ProcessData(buffer, len);
+    return remainder;
+}
+
+/** \fn StreamHandler::ForEachListener(const std::function<void(MPEGStreamData*)>&) const
+ *  \brief Calls func with every listener's stream data.
+ *
+ *  Without the fan-out this holds the listener lock, like the reader
+ *  does while it processes data. With the fan-out each listener is
+ *  locked in turn after the listener lock is released, so that the
+ *  reader is never held up by a listener's worker thread.
+ */
+void StreamHandler::ForEachListener(
+    const std::function<void(MPEGStreamData*)> &func) const
+{
+    QSharedPointer<StreamFanout> fanout;
+    {
+        QMutexLocker read_locker(&m_listenerLock);
+        if (!m_fanout)
+        {
+            for (auto it = m_streamDataList.cbegin(); it != m_streamDataList.cend(); ++it)
+                func(it.key());
+            return;
+        }
+        fanout = m_fanout;
+    }
+
+    fanout->ForEachListener(func);
+}
+
 void StreamHandler::WriteMPTS(const unsigned char * buffer, uint len)
 {
     if (m_mptsTfw == nullptr)
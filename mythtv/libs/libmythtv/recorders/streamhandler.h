@@ -3,6 +3,7 @@
 #ifndef STREAM_HANDLER_H
 #define STREAM_HANDLER_H
 
+#include <functional>
 #include <utility>
 #include <vector>
 
@@ -14,6 +15,7 @@
 #if QT_VERSION >= QT_VERSION_CHECK(5,14,0)
 #include <QRecursiveMutex>
 #endif
+#include <QSharedPointer>
 
 // MythTV headers
 #include "DeviceReadBuffer.h" // for ReaderPausedCB
@@ -22,6 +24,7 @@
 #include "mythdate.h"
 
 class ThreadedFileWriter;
+class StreamFanout;
 
 //#define DEBUG_PID_FILTERS
 
@@ -101,6 +104,13 @@ class StreamHandler : protected MThread, public DeviceReaderCB
         { return new PIDInfo(pid, stream_type, pes_type); }
 
   protected:
+    /// Pass a read block to every listener, returns the number of
+    /// unprocessed bytes at the end of the buffer.
+    /// \note: The _listener_lock must be held when this is called.
+    int DistributeData(const unsigned char *buffer, int len);
+    /// Call func for every listener while it is not processing data
+    void ForEachListener(
+        const std::function<void(MPEGStreamData*)> &func) const;
     /// Write out a copy of the raw MPTS
     void WriteMPTS(const unsigned char * buffer, uint len);
     /// At minimum this sets _running_desired, this may also send
@@ -152,6 +162,10 @@ class StreamHandler : protected MThread, public DeviceReaderCB
     mutable QRecursiveMutex m_listenerLock;
 #endif
     StreamDataList      m_streamDataList;
+    /// Set by handlers that pass all their data through DistributeData()
+    bool                m_fanoutCapable        {false};
+    /// Per-listener worker threads, when "StreamHandlerFanout" is enabled
+    QSharedPointer<StreamFanout> m_fanout;
 };
 
 #endif // STREAM_HANDLER_H
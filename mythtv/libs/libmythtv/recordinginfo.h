@@ -63,6 +63,10 @@ class MTV_PUBLIC RecordingInfo : public ProgramInfo
         ProgramInfo(it, end),
         m_desiredRecStartTs(m_startTs),
         m_desiredRecEndTs(m_endTs)  { LoadRecordingFile(); }
+    explicit RecordingInfo(QDataStream &stream) :
+        ProgramInfo(stream),
+        m_desiredRecStartTs(m_startTs),
+        m_desiredRecEndTs(m_endTs)  { LoadRecordingFile(); }
     /// Create RecordingInfo from 'program'+'record'+'channel' tables,
     /// used in scheduler.cpp @ ~ 3296
     RecordingInfo(
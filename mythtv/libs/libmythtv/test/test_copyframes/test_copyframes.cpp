@@ -1,12 +1,25 @@
 #include "test_copyframes.h"
 
+#include <array>
 #include <climits>
+#include <cstring>
+#include <vector>
 
+#include <QElapsedTimer>
+
+#include "mythconfig.h"
 #include "mythcorecontext.h"
 
+#include "mythavutil.h"
 #include "mythframe.h"
 #include "mythrandom.h"
 
+extern "C" {
+#include "libavutil/imgutils.h"
+#include "libavutil/pixdesc.h"
+#include "libswscale/swscale.h"
+}
+
 void TestCopyFrames::initTestCase(void)
 {
 }
@@ -258,4 +271,286 @@ void TestCopyFrames::TestCopy()
     }
 }
 
+void TestCopyFrames::TestSplitMerge_data()
+{
+    QTest::addColumn<int>("Depth");
+    QTest::newRow("8bit")  << 8;
+    QTest::newRow("10bit") << 10;
+    QTest::newRow("16bit") << 16;
+}
+
+void TestCopyFrames::TestSplitMerge()
+{
+    QFETCH(int, Depth);
+    int bytes = Depth > 8 ? 2 : 1;
+    int max   = (1 << Depth) - 1;
+    int shift = Depth > 8 ? 16 - Depth : 0;
+
+    qInfo() << QString("SIMD: %1").arg(MythVideoFrame::HaveSIMD());
+
+    // Widths around the SIMD block sizes, with odd pitches
+    for (int width = 1; width < 70; ++width)
+    {
+        const int height  = 3;
+        const int uvpitch = (width * 2 * bytes) + 6;
+        const int pitch   = (width * bytes) + 2;
+        std::vector<uint8_t> uv(static_cast<size_t>(uvpitch * height), 0);
+        std::vector<uint8_t> u(static_cast<size_t>(pitch * height), 0);
+        std::vector<uint8_t> v(static_cast<size_t>(pitch * height), 0);
+        std::vector<uint8_t> merged(uv.size(), 0);
+
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width * 2; ++x)
+            {
+                int value = MythRandom(0, max) << shift;
+                if (bytes == 1)
+                    uv[static_cast<size_t>((y * uvpitch) + x)] = static_cast<uint8_t>(value);
+                else
+                    reinterpret_cast<uint16_t*>(&uv[static_cast<size_t>(y * uvpitch)])[x] = static_cast<uint16_t>(value);
+            }
+        }
+
+        MythVideoFrame::SplitPlane(u.data(), pitch, v.data(), pitch, uv.data(), uvpitch,
+                                   width, height, Depth);
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                int inu = 0;
+                int inv = 0;
+                int outu = 0;
+                int outv = 0;
+                if (bytes == 1)
+                {
+                    inu  = uv[static_cast<size_t>((y * uvpitch) + (2 * x))];
+                    inv  = uv[static_cast<size_t>((y * uvpitch) + (2 * x) + 1)];
+                    outu = u[static_cast<size_t>((y * pitch) + x)];
+                    outv = v[static_cast<size_t>((y * pitch) + x)];
+                }
+                else
+                {
+                    const auto* row = reinterpret_cast<const uint16_t*>(&uv[static_cast<size_t>(y * uvpitch)]);
+                    inu  = row[2 * x] >> shift;
+                    inv  = row[(2 * x) + 1] >> shift;
+                    outu = reinterpret_cast<const uint16_t*>(&u[static_cast<size_t>(y * pitch)])[x];
+                    outv = reinterpret_cast<const uint16_t*>(&v[static_cast<size_t>(y * pitch)])[x];
+                }
+                QCOMPARE(outu, inu);
+                QCOMPARE(outv, inv);
+            }
+        }
+
+        MythVideoFrame::MergePlanes(merged.data(), uvpitch, u.data(), pitch, v.data(), pitch,
+                                    width, height, Depth);
+        QVERIFY(merged == uv);
+    }
+}
+
+void TestCopyFrames::TestShiftPlane()
+{
+    for (int width = 1; width < 40; ++width)
+    {
+        std::vector<uint16_t> in(static_cast<size_t>(width));
+        std::vector<uint16_t> out(in.size());
+        std::vector<uint16_t> back(in.size());
+        for (auto & sample : in)
+            sample = static_cast<uint16_t>(MythRandom(0, 1023));
+
+        // YUV420P10 to P010 and back
+        int pitch = width * 2;
+        MythVideoFrame::ShiftPlane(reinterpret_cast<uint8_t*>(out.data()), pitch,
+                                   reinterpret_cast<const uint8_t*>(in.data()), pitch, width, 1, 6);
+        for (int x = 0; x < width; ++x)
+            QCOMPARE(out[static_cast<size_t>(x)], static_cast<uint16_t>(in[static_cast<size_t>(x)] << 6));
+        MythVideoFrame::ShiftPlane(reinterpret_cast<uint8_t*>(back.data()), pitch,
+                                   reinterpret_cast<const uint8_t*>(out.data()), pitch, width, 1, -6);
+        QVERIFY(back == in);
+    }
+}
+
+/// Converts From into To with swscale, the way MythAVCopy did for all formats
+static void SwsCopy(SwsContext*& Context, AVFrame* To, AVPixelFormat ToFmt, const MythVideoFrame* From)
+{
+    AVFrame frame;
+    AVPixelFormat fromfmt = MythAVUtil::FrameTypeToPixelFormat(From->m_type);
+    MythAVUtil::FillAVFrame(&frame, From, fromfmt);
+    Context = sws_getCachedContext(Context, From->m_width, From->m_height, fromfmt,
+                                   From->m_width, From->m_height, ToFmt, SWS_FAST_BILINEAR,
+                                   nullptr, nullptr, nullptr);
+    sws_scale(Context, frame.data, frame.linesize, 0, From->m_height, To->data, To->linesize);
+}
+
+static MythVideoFrame* CreateFrame(VideoFrameType Type, int Width, int Height)
+{
+    size_t size = MythVideoFrame::GetBufferSize(Type, Width, Height);
+    return new MythVideoFrame(Type, MythVideoFrame::GetAlignedBuffer(size), size, Width, Height);
+}
+
+void TestCopyFrames::TestAVCopy_data()
+{
+    QTest::addColumn<int>("FromType");
+    QTest::addColumn<int>("ToFormat");
+    QTest::addColumn<QSize>("Size");
+
+    static const std::array<QSize,7> s_sizes { QSize(9, 3), QSize(17, 9), QSize(33, 18),
+                                               QSize(66, 31), QSize(719, 575), QSize(720, 576),
+                                               QSize(1921, 1081) };
+    for (const auto & size : s_sizes)
+    {
+        auto name = [&size](const char* Test)
+        {
+            return QString("%1 %2x%3").arg(Test).arg(size.width()).arg(size.height()).toLocal8Bit();
+        };
+        QTest::newRow(name("NV12 to YUV420P").constData())   << int(FMT_NV12) << int(AV_PIX_FMT_YUV420P)   << size;
+        QTest::newRow(name("P010 to YUV420P10").constData()) << int(FMT_P010) << int(AV_PIX_FMT_YUV420P10) << size;
+        QTest::newRow(name("YV12 to NV12").constData())      << int(FMT_YV12) << int(AV_PIX_FMT_NV12)      << size;
+    }
+}
+
+/*! \brief Checks the conversions MythAVCopy does itself against swscale.
+ *
+ * The whole source frame is random, so that anything read from outside the
+ * image, or written to the wrong place, shows up as a difference.
+*/
+void TestCopyFrames::TestAVCopy()
+{
+    QFETCH(int, FromType);
+    QFETCH(int, ToFormat);
+    QFETCH(QSize, Size);
+
+    auto type  = static_cast<VideoFrameType>(FromType);
+    auto tofmt = static_cast<AVPixelFormat>(ToFormat);
+    int width  = Size.width();
+    int height = Size.height();
+
+    MythVideoFrame* from = CreateFrame(type, width, height);
+    for (size_t i = 0; i < from->m_bufferSize; ++i)
+        from->m_buffer[i] = static_cast<uint8_t>(MythRandom(0, UCHAR_MAX));
+    // P010 keeps its 10 bits in the top of each sample, clear the bottom 6
+    if (type == FMT_P010)
+    {
+        for (size_t i = 0; i < from->m_bufferSize; i += 2)
+            from->m_buffer[i] &= 0xC0;
+    }
+
+    int size = av_image_get_buffer_size(tofmt, width, height, IMAGE_ALIGN);
+    std::vector<uint8_t> mine(static_cast<size_t>(size), 0);
+    std::vector<uint8_t> theirs(static_cast<size_t>(size), 0xFF);
+
+    AVFrame to;
+    MythAVCopy copy;
+    QCOMPARE(copy.Copy(&to, from, mine.data(), tofmt), size);
+
+    AVFrame reference;
+    SwsContext* context = nullptr;
+    av_image_fill_arrays(reference.data, reference.linesize, theirs.data(), tofmt, width, height, IMAGE_ALIGN);
+    SwsCopy(context, &reference, tofmt, from);
+    sws_freeContext(context);
+
+    const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(tofmt);
+    for (int plane = 0; plane < av_pix_fmt_count_planes(tofmt); ++plane)
+    {
+        int bytes = av_image_get_linesize(tofmt, width, plane);
+        int rows  = plane ? -((-height) >> desc->log2_chroma_h) : height;
+        QCOMPARE(to.linesize[plane], reference.linesize[plane]);
+        for (int y = 0; y < rows; ++y)
+        {
+            const uint8_t* row  = to.data[plane] + (y * to.linesize[plane]);
+            const uint8_t* ref  = reference.data[plane] + (y * reference.linesize[plane]);
+            if (memcmp(row, ref, static_cast<size_t>(bytes)) != 0)
+            {
+                QFAIL(QString("Plane %1 row %2 differs from swscale").arg(plane).arg(y)
+                      .toLocal8Bit().constData());
+            }
+        }
+    }
+    delete from;
+}
+
+void TestCopyFrames::Benchmark_data()
+{
+    QTest::addColumn<int>("FromType");
+    QTest::addColumn<int>("ToFormat");
+    QTest::addColumn<QSize>("Size");
+    QTest::addColumn<bool>("Swscale");
+
+    static const std::array<QSize,3> s_sizes { QSize(720, 576), QSize(1920, 1080), QSize(3840, 2160) };
+    for (const auto & size : s_sizes)
+    {
+        auto name = [&size](const char* Test)
+        {
+            return QString("%1 %2x%3").arg(Test).arg(size.width()).arg(size.height()).toLocal8Bit();
+        };
+        // AV_PIX_FMT_NONE copies into a frame of the same type with CopyFrame()
+        QTest::newRow(name("Copy YV12").constData()) << int(FMT_YV12) << int(AV_PIX_FMT_NONE) << size << false;
+        QTest::newRow(name("Copy NV12").constData()) << int(FMT_NV12) << int(AV_PIX_FMT_NONE) << size << false;
+        QTest::newRow(name("Copy P010").constData()) << int(FMT_P010) << int(AV_PIX_FMT_NONE) << size << false;
+        QTest::newRow(name("MythAVCopy NV12 to YUV420P").constData())   << int(FMT_NV12) << int(AV_PIX_FMT_YUV420P)   << size << false;
+        QTest::newRow(name("swscale NV12 to YUV420P").constData())      << int(FMT_NV12) << int(AV_PIX_FMT_YUV420P)   << size << true;
+        QTest::newRow(name("MythAVCopy P010 to YUV420P10").constData()) << int(FMT_P010) << int(AV_PIX_FMT_YUV420P10) << size << false;
+        QTest::newRow(name("swscale P010 to YUV420P10").constData())    << int(FMT_P010) << int(AV_PIX_FMT_YUV420P10) << size << true;
+        QTest::newRow(name("MythAVCopy YV12 to NV12").constData())      << int(FMT_YV12) << int(AV_PIX_FMT_NV12)      << size << false;
+        QTest::newRow(name("swscale YV12 to NV12").constData())         << int(FMT_YV12) << int(AV_PIX_FMT_NV12)      << size << true;
+    }
+}
+
+/*! \brief Reports the throughput of frame copies and of MythAVCopy against swscale.
+ *
+ * The result is the bytes of the source frame, read once and written once,
+ * per second.
+*/
+void TestCopyFrames::Benchmark()
+{
+    QFETCH(int, FromType);
+    QFETCH(int, ToFormat);
+    QFETCH(QSize, Size);
+    QFETCH(bool, Swscale);
+
+    auto type  = static_cast<VideoFrameType>(FromType);
+    auto tofmt = static_cast<AVPixelFormat>(ToFormat);
+    MythVideoFrame* from = CreateFrame(type, Size.width(), Size.height());
+    FillRandom(from);
+
+    MythVideoFrame* to = nullptr;
+    std::vector<uint8_t> buffer;
+    AVFrame avto;
+    MythAVCopy copy;
+    SwsContext* context = nullptr;
+    if (tofmt == AV_PIX_FMT_NONE)
+    {
+        to = CreateFrame(type, Size.width(), Size.height());
+    }
+    else
+    {
+        buffer.resize(static_cast<size_t>(av_image_get_buffer_size(tofmt, Size.width(), Size.height(), IMAGE_ALIGN)));
+        av_image_fill_arrays(avto.data, avto.linesize, buffer.data(), tofmt,
+                             Size.width(), Size.height(), IMAGE_ALIGN);
+    }
+    auto run = [&]()
+    {
+        if (to)
+            to->CopyFrame(from);
+        else if (Swscale)
+            SwsCopy(context, &avto, tofmt, from);
+        else
+            copy.Copy(&avto, from, buffer.data(), tofmt);
+    };
+
+    size_t bytes = MythVideoFrame::GetBufferSize(from->m_type, Size.width(), Size.height(), 0);
+    int iterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK
+    {
+        run();
+        iterations++;
+    }
+    double seconds = static_cast<double>(timer.nsecsElapsed()) / 1e9;
+    QTest::setBenchmarkResult(static_cast<double>(bytes) * iterations / seconds, QTest::BytesPerSecond);
+    sws_freeContext(context);
+    delete from;
+    delete to;
+}
+
 QTEST_APPLESS_MAIN(TestCopyFrames)
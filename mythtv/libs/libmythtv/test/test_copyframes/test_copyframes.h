@@ -31,4 +31,11 @@ class TestCopyFrames : public QObject
     static void TestInvalidSizes();
     static void TestInvalidBuffers();
     static void TestCopy();
+    static void TestSplitMerge_data();
+    static void TestSplitMerge();
+    static void TestShiftPlane();
+    static void TestAVCopy_data();
+    static void TestAVCopy();
+    static void Benchmark_data();
+    static void Benchmark();
 };
@@ -0,0 +1,252 @@
+/*
+ *  Class TestDeviceReadBuffer
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include "test_devicereadbuffer.h"
+
+#include <array>
+#include <atomic>
+#include <csignal>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "DeviceReadBuffer.h"
+#include "mythcorecontext.h"
+#include "tspacket.h"
+
+class TestReaderCB : public DeviceReaderCB
+{
+  public:
+    void ReaderPaused(int /*fd*/) override {}
+    void PriorityEvent(int /*fd*/) override {}
+};
+
+// Writes numbered packets in bursts, like a tuner delivering a few
+// driver buffers at a time.
+static void write_packets(int fd, uint packets, uint burst,
+                          std::chrono::microseconds pause)
+{
+    std::vector<unsigned char> buf(burst * TSPacket::kSize, 0xff);
+    uint seq = 0;
+    while (seq < packets)
+    {
+        uint count = std::min(burst, packets - seq);
+        for (uint i = 0; i < count; i++, seq++)
+        {
+            unsigned char *pkt = &buf[i * TSPacket::kSize];
+            pkt[0] = SYNC_BYTE;
+            memcpy(pkt + 4, &seq, sizeof(seq));
+        }
+
+        const unsigned char *data = buf.data();
+        size_t len = count * TSPacket::kSize;
+        while (len > 0)
+        {
+            ssize_t ret = write(fd, data, len);
+            if (ret < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                return; // the reader has gone
+            }
+            data += ret;
+            len  -= ret;
+        }
+
+        if (pause > 0us)
+            std::this_thread::sleep_for(pause);
+    }
+}
+
+static bool check_packets(const unsigned char *data, uint len, uint &next)
+{
+    for (uint i = 0; i + TSPacket::kSize <= len; i += TSPacket::kSize)
+    {
+        uint seq = 0;
+        memcpy(&seq, data + i + 4, sizeof(seq));
+        if (data[i] != SYNC_BYTE || seq != next)
+            return false;
+        next++;
+    }
+    return true;
+}
+
+/// Returns the number of packets received in order.
+static uint run_ring(uint packets, uint burst, std::chrono::microseconds pause,
+                     bool peek, uint slow_every)
+{
+    std::array<int,2> fds {-1, -1};
+    if (pipe(fds.data()) < 0)
+        return 0;
+
+    TestReaderCB cb;
+    DeviceReadBuffer drb(&cb, true, false);
+    if (!drb.Setup("test", fds[0]))
+    {
+        close(fds[0]);
+        close(fds[1]);
+        return 0;
+    }
+    drb.Start();
+
+    std::thread writer(write_packets, fds[1], packets, burst, pause);
+
+    std::vector<unsigned char> buf(TSPacket::kSize * 1000);
+    uint remainder = 0;
+    uint next = 0;
+    uint reads = 0;
+    QElapsedTimer timer;
+    timer.start();
+    while (next < packets && timer.elapsed() < 60000)
+    {
+        bool slow = slow_every && ((++reads % slow_every) == 0);
+        if (peek)
+        {
+            uint len = 0;
+            const unsigned char *data = drb.Peek(len);
+            uint whole = len - (len % TSPacket::kSize);
+            // A slow reader sometimes only takes part of the data
+            if (slow)
+                whole = (whole / 2) - ((whole / 2) % TSPacket::kSize);
+            if (!check_packets(data, whole, next))
+                break;
+            drb.Consume(whole);
+        }
+        else
+        {
+            uint len = drb.Read(buf.data() + remainder, buf.size() - remainder);
+            len += remainder;
+            uint whole = len - (len % TSPacket::kSize);
+            if (!check_packets(buf.data(), whole, next))
+                break;
+            remainder = len - whole;
+            memmove(buf.data(), buf.data() + whole, remainder);
+        }
+        if (slow)
+            std::this_thread::sleep_for(2ms);
+    }
+
+    drb.Stop();
+    close(fds[0]);
+    writer.join();
+    close(fds[1]);
+
+    return next;
+}
+
+void TestDeviceReadBuffer::initTestCase(void)
+{
+    gCoreContext = new MythCoreContext("bin_version", nullptr);
+    // A small ring so that it wraps often, 188 KB is 1024 packets
+    gCoreContext->OverrideSettingForSession("HDRingbufferSize", "188");
+    signal(SIGPIPE, SIG_IGN);
+}
+
+void TestDeviceReadBuffer::peek_stress_test(void)
+{
+    QCOMPARE(run_ring(100000, 700, 1ms, true, 4), 100000U);
+    QCOMPARE(run_ring(100000, 7, 0us, true, 64), 100000U);
+}
+
+void TestDeviceReadBuffer::read_stress_test(void)
+{
+    QCOMPARE(run_ring(100000, 700, 1ms, false, 4), 100000U);
+    QCOMPARE(run_ring(100000, 7, 0us, false, 64), 100000U);
+}
+
+void TestDeviceReadBuffer::reset_test(void)
+{
+    static constexpr uint kPackets { 200000 };
+    static constexpr uint kRingSize { 188 * 1024 };
+
+    std::array<int,2> fds {-1, -1};
+    QVERIFY(pipe(fds.data()) == 0);
+
+    TestReaderCB cb;
+    DeviceReadBuffer drb(&cb, true, false);
+    QVERIFY(drb.Setup("test", fds[0]));
+    drb.Start();
+
+    std::thread writer(write_packets, fds[1], kPackets, 7, 0us);
+    // Reset only while the first half is read, so the end gets through
+    std::atomic<int> last {-1};
+    std::thread resetter([&drb, &last, fd = fds[0]]()
+    {
+        while (last < int(kPackets / 2))
+        {
+            drb.Reset("test", fd);
+            std::this_thread::sleep_for(100us);
+        }
+    });
+
+    bool ok = true;
+    QElapsedTimer timer;
+    timer.start();
+    while (ok && last + 1 < int(kPackets) && timer.elapsed() < 60000)
+    {
+        ok = drb.GetUsed() <= kRingSize;
+        uint len = 0;
+        const unsigned char *data = drb.Peek(len);
+        uint whole = len - (len % TSPacket::kSize);
+        for (uint i = 0; ok && i < whole; i += TSPacket::kSize)
+        {
+            uint seq = 0;
+            memcpy(&seq, data + i + 4, sizeof(seq));
+            ok = (data[i] == SYNC_BYTE) && (int(seq) > last);
+            last = int(seq);
+        }
+        drb.Consume(whole);
+    }
+
+    // Stop the resetter, if the reader gave up early
+    bool received_all = (last == int(kPackets) - 1);
+    last = int(kPackets);
+    resetter.join();
+    drb.Stop();
+    close(fds[0]);
+    writer.join();
+    close(fds[1]);
+
+    QVERIFY(ok);
+    QVERIFY(received_all);
+}
+
+void TestDeviceReadBuffer::ring_benchmark_data(void)
+{
+    QTest::addColumn<uint>("burst");
+    QTest::addColumn<bool>("peek");
+    QTest::newRow("IPTV sized bursts, Peek") << 7U   << true;
+    QTest::newRow("IPTV sized bursts, Read") << 7U   << false;
+    QTest::newRow("DVB sized bursts, Peek")  << 348U << true;
+    QTest::newRow("DVB sized bursts, Read")  << 348U << false;
+}
+
+void TestDeviceReadBuffer::ring_benchmark(void)
+{
+    QFETCH(uint, burst);
+    QFETCH(bool, peek);
+
+    uint received = 0;
+    QBENCHMARK
+    {
+        received = run_ring(200000, burst, 0us, peek, 0);
+    }
+    QCOMPARE(received, 200000U);
+}
+
+QTEST_APPLESS_MAIN(TestDeviceReadBuffer)
@@ -0,0 +1,46 @@
+/*
+ *  Class TestDeviceReadBuffer
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <QtTest/QtTest>
+
+class TestDeviceReadBuffer: public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    static void initTestCase(void);
+
+    /** bursty device writes and a slow reader using Peek()/Consume(),
+     *  no packet may be lost, duplicated or reordered across the wrap
+     */
+    static void peek_stress_test(void);
+
+    /** the same with the copying Read() interface
+     */
+    static void read_stress_test(void);
+
+    /** Reset() from another thread while the reader is consuming,
+     *  packets may be skipped but never be damaged or go backwards
+     */
+    static void reset_test(void);
+
+    /** move packets through the ring as fast as possible
+     */
+    static void ring_benchmark_data(void);
+    static void ring_benchmark(void);
+};
@@ -0,0 +1,149 @@
+/*
+ *  Class TestEITCache
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include "test_eitcache.h"
+
+#include <map>
+#include <random>
+
+#include "eitcache.h"
+#include "mythdate.h"
+
+// Same layout as construct_sig() in eitcache.cpp, unmodified
+static uint64_t make_sig(uint tableid, uint version, uint endtime)
+{
+    return (static_cast<uint64_t>(tableid) << 40) |
+           (static_cast<uint64_t>(version) << 32) | endtime;
+}
+
+void TestEITCache::table_test(void)
+{
+    EITCacheTable table;
+    std::map<uint64_t, uint64_t> reference;
+    std::mt19937 rng(42);
+
+    for (uint i = 0; i < 300000; i++)
+    {
+        uint chanid  = 1000 + (rng() % 50);
+        uint eventid = rng() % 10000;
+        uint64_t sig = rng();
+        table.Insert(chanid, eventid, sig);
+        reference[(static_cast<uint64_t>(chanid) << 32) | eventid] = sig;
+    }
+    QCOMPARE(table.size(), reference.size());
+
+    // drop the odd channels
+    size_t removed = table.RemoveIf(
+        [](uint chanid, uint64_t /*sig*/) { return (chanid & 1) != 0; });
+    size_t expected = 0;
+    for (auto it = reference.begin(); it != reference.end(); )
+    {
+        if ((it->first >> 32) & 1)
+        {
+            it = reference.erase(it);
+            expected++;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    QCOMPARE(removed, expected);
+    QCOMPARE(table.size(), reference.size());
+
+    for (uint chanid = 1000; chanid < 1050; chanid++)
+    {
+        for (uint eventid = 0; eventid < 10000; eventid++)
+        {
+            auto it = reference.find((static_cast<uint64_t>(chanid) << 32) | eventid);
+            uint64_t *sig = table.Find(chanid, eventid);
+            if (it == reference.end())
+            {
+                QVERIFY(sig == nullptr);
+            }
+            else
+            {
+                QVERIFY(sig != nullptr);
+                QCOMPARE(*sig, it->second);
+            }
+        }
+    }
+}
+
+void TestEITCache::isneweit_test(void)
+{
+    EITCache cache;
+    uint endtime = MythDate::current().toSecsSinceEpoch() + 3600;
+
+    // pretend channel 1001 was loaded from the database and is empty
+    cache.m_channels[1001] = true;
+    cache.m_events.Insert(1001, 7, make_sig(0x50, 3, endtime));
+
+    QVERIFY(!cache.IsNewEIT(1001, 0x50, 3, 7, endtime));      // seen
+    QVERIFY(cache.IsNewEIT(1001, 0x50, 4, 7, endtime));       // version
+    QVERIFY(!cache.IsNewEIT(1001, 0x50, 4, 7, endtime));      // seen again
+    QVERIFY(cache.IsNewEIT(1001, 0x50, 4, 8, endtime));       // new event
+    QVERIFY(cache.IsNewEIT(1001, 0x50, 4, 8, endtime + 60));  // endtime
+    QVERIFY(cache.IsNewEIT(1001, 0x4e, 4, 8, endtime + 60));  // table
+    QVERIFY(!cache.IsNewEIT(1001, 0x50, 4, 8, endtime + 60)); // worse table
+    QVERIFY(!cache.IsNewEIT(1001, 0x50, 4, 9, endtime - 2 * 86400)); // pruned
+
+    // each modified event is written once
+    QCOMPARE(cache.m_dirty.size(), static_cast<size_t>(2));
+    QCOMPARE(cache.m_events.size(), static_cast<size_t>(2));
+
+    // nothing should reach the database when the cache is destroyed
+    cache.m_dirty.clear();
+}
+
+void TestEITCache::isneweit_benchmark(void)
+{
+    static constexpr uint kChannels = 400;
+    static constexpr uint kEvents   = 2000;
+
+    EITCache cache;
+    uint endtime = MythDate::current().toSecsSinceEpoch() + 3600;
+    for (uint chanid = 1; chanid <= kChannels; chanid++)
+    {
+        cache.m_channels[chanid] = true;
+        for (uint eventid = 0; eventid < kEvents; eventid++)
+            cache.m_events.Insert(chanid, eventid,
+                                  make_sig(0x50, 1, endtime + eventid));
+    }
+
+    // the tables of each channel are repeated in turn
+    std::vector<std::pair<uint,uint>> order;
+    order.reserve(kChannels * kEvents);
+    for (uint chanid = 1; chanid <= kChannels; chanid++)
+        for (uint eventid = 0; eventid < kEvents; eventid++)
+            order.emplace_back(chanid, eventid);
+
+    uint fresh = 0;
+    QBENCHMARK
+    {
+        for (const auto & [chanid, eventid] : order)
+            fresh += cache.IsNewEIT(chanid, 0x50, 1, eventid, endtime + eventid) ? 1 : 0;
+    }
+    QCOMPARE(fresh, 0U);
+
+    // the table keeps at most four slots for each event
+    QCOMPARE(cache.m_events.size(), static_cast<size_t>(kChannels) * kEvents);
+    QVERIFY(cache.m_events.capacity() <= cache.m_events.size() * 4);
+}
+
+QTEST_APPLESS_MAIN(TestEITCache)
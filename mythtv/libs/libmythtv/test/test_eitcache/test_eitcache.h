@@ -0,0 +1,40 @@
+/*
+ *  Class TestEITCache
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <QtTest/QtTest>
+
+class TestEITCache: public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    /** random inserts, updates and removals compared with a std::map
+     */
+    static void table_test(void);
+
+    /** new, changed and repeated events, and only changed events
+     *  are marked for writing
+     */
+    static void isneweit_test(void);
+
+    /** repeated events from 400 channels with 2000 events each, like
+     *  EIT other on a large satellite, times looking all of them up and
+     *  checks the table keeps at most four slots per cached event
+     */
+    static void isneweit_benchmark(void);
+};
@@ -3682,4 +3682,59 @@ void TestEITFixups::testGreekCategories()
 }
 
 
+void TestEITFixups::benchmarkFix_data()
+{
+    QTest::addColumn<qulonglong>("fixup");
+    // title and description of each event
+    QTest::addColumn<QStringList>("events");
+
+    // Like a full scan, most events have little or nothing to fix up
+    QTest::newRow("UK") << qulonglong(EITFixUp::kFixUK) << QStringList {
+        "New: The Title",
+        "'Subtitle.' Brand new series: Series 2, Episode 3/13. Starring John Smith and Jane Doe. [AD,S]",
+        "Title..", "..continued. The description of the episode, part 1 of 2. (2009)",
+        "The News", "The latest national and international news stories.",
+        "Weather", "The latest weather forecast.",
+        "Film Title", "A plain description of the film, with nothing more to it.",
+        "Quiz Show", "Contestants answer questions on a range of subjects.",
+    };
+    QTest::newRow("NL") << qulonglong(EITFixUp::kFixNL) << QStringList {
+        "Titel (NPO/KRO)",
+        "Afl.: De aflevering. Met: Jan Smit en Piet Hein e.a. Presentatie: Linda de Mol. breedbeeld txt herh. uit 1999",
+        "Titel HD", "Documentaire. Een film van Jan Smit. (USA/1989)",
+        "Journaal", "Het laatste nieuws uit binnen- en buitenland.",
+        "Weerbericht", "De weersverwachting voor morgen.",
+        "Film", "Een beschrijving van de film, zonder meer.",
+        "Quiz", "Kandidaten beantwoorden vragen over allerlei onderwerpen.",
+    };
+    QTest::newRow("DK") << qulonglong(EITFixUp::kFixDK) << QStringList {
+        "Titel (3:6)",
+        "Sæson 2. Instr.: Lars von Trier. Medv.: Anna Hansen, Bo Jensen og Carl Nielsen. Film fra 1999. Features: 16:9 HD 5:1 TTV",
+        "Titel: Undertitel", "Beskrivelse af programmet.",
+        "Nyheder", "De seneste nyheder fra ind- og udland.",
+        "Vejret", "Vejrudsigten for i morgen.",
+        "Film", "En beskrivelse af filmen, uden mere.",
+        "Quiz", "Deltagerne svarer på spørgsmål om mange emner.",
+    };
+}
+
+void TestEITFixups::benchmarkFix()
+{
+    QFETCH(qulonglong, fixup);
+    QFETCH(QStringList, events);
+
+    const QDateTime start = QDateTime::fromString("2020-02-28T23:55:00Z", Qt::ISODate);
+    const QDateTime end   = QDateTime::fromString("2020-03-01T02:00:00Z", Qt::ISODate);
+
+    QBENCHMARK
+    {
+        for (int i = 0; i + 1 < events.size(); i += 2)
+        {
+            DBEventEIT event(7302, events[i], events[i + 1], start, end,
+                             fixup, SUB_UNKNOWN, AUD_STEREO, VID_UNKNOWN);
+            EITFixUp::Fix(event);
+        }
+    }
+}
+
 QTEST_APPLESS_MAIN(TestEITFixups)
@@ -129,6 +129,8 @@ class TestEITFixups : public QObject
     static void testGreek3();
     static void testGreekCategories_data();
     static void testGreekCategories();
+    static void benchmarkFix_data();
+    static void benchmarkFix();
     static void cleanupTestCase();
 
   private:
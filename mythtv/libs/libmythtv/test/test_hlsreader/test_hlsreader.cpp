@@ -0,0 +1,211 @@
+/*
+ *  Class TestHLSReader
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include "test_hlsreader.h"
+
+#include <array>
+#include <atomic>
+
+#include <QDeadlineTimer>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+#include "HLSReader.h"
+#include "tspacket.h"
+
+static constexpr int kPacketsPerSegment { 70 };
+
+/// A minimal HTTP/1.1 server with keep-alive, serving a VOD playlist
+/// and its segments from its own thread, so that it keeps answering
+/// while the test waits for the reader.
+class SegmentServer
+{
+  public:
+    SegmentServer(int segments, std::chrono::milliseconds delay) :
+        m_segments(segments), m_delay(delay)
+    {
+        m_context.moveToThread(&m_thread);
+        m_thread.start();
+    }
+
+    ~SegmentServer()
+    {
+        QMetaObject::invokeMethod(&m_context, [this]() { delete m_server; },
+                                  Qt::BlockingQueuedConnection);
+        m_thread.quit();
+        m_thread.wait();
+    }
+
+    bool Listen(void)
+    {
+        bool ok = false;
+        QMetaObject::invokeMethod(&m_context, [this, &ok]()
+        {
+            m_server = new QTcpServer;
+            QObject::connect(m_server, &QTcpServer::newConnection,
+                             [this]() { NewConnection(); });
+            ok = m_server->listen(QHostAddress::LocalHost);
+            m_port = m_server->serverPort();
+        }, Qt::BlockingQueuedConnection);
+        return ok;
+    }
+
+    QString PlaylistURL(void) const
+    {
+        return QString("http://127.0.0.1:%1/index.m3u8").arg(m_port);
+    }
+
+    int Connections(void) const   { return m_connections; }
+    int MaxConcurrent(void) const { return m_maxConcurrent; }
+
+    static QByteArray Segment(int num)
+    {
+        QByteArray data(kPacketsPerSegment * TSPacket::kSize, '\xff');
+        for (int i = 0; i < kPacketsPerSegment; i++)
+        {
+            char *pkt = data.data() + (i * TSPacket::kSize);
+            pkt[0] = SYNC_BYTE;
+            memcpy(pkt + 4, &num, sizeof(num));
+            memcpy(pkt + 8, &i, sizeof(i));
+        }
+        return data;
+    }
+
+  private:
+    void NewConnection(void)
+    {
+        while (QTcpSocket *socket = m_server->nextPendingConnection())
+        {
+            ++m_connections;
+            QObject::connect(socket, &QTcpSocket::readyRead,
+                             [this, socket]() { Requests(socket); });
+            QObject::connect(socket, &QTcpSocket::disconnected,
+                             socket, &QObject::deleteLater);
+        }
+    }
+
+    void Requests(QTcpSocket *socket)
+    {
+        QByteArray &pending = m_pending[socket];
+        pending += socket->readAll();
+        int end = 0;
+        while ((end = pending.indexOf("\r\n\r\n")) >= 0)
+        {
+            QList<QByteArray> request = pending.left(end).split(' ');
+            pending.remove(0, end + 4);
+            QString path = request.size() > 1 ? request[1] : QString();
+
+            if (!path.endsWith(".ts"))
+            {
+                Respond(socket, Playlist());
+                continue;
+            }
+
+            // Answer segment requests late, like a distant server
+            int num = path.mid(4, path.size() - 7).toInt();
+            m_maxConcurrent = std::max(m_maxConcurrent.load(), ++m_concurrent);
+            QTimer::singleShot(m_delay, socket, [this, socket, num]()
+            {
+                --m_concurrent;
+                Respond(socket, Segment(num));
+            });
+        }
+    }
+
+    QByteArray Playlist(void) const
+    {
+        QByteArray playlist("#EXTM3U\n"
+                            "#EXT-X-VERSION:3\n"
+                            "#EXT-X-TARGETDURATION:1\n"
+                            "#EXT-X-MEDIA-SEQUENCE:0\n");
+        for (int i = 0; i < m_segments; i++)
+            playlist += QString("#EXTINF:1,\n/seg%1.ts\n").arg(i).toLatin1();
+        playlist += "#EXT-X-ENDLIST\n";
+        return playlist;
+    }
+
+    static void Respond(QTcpSocket *socket, const QByteArray &body)
+    {
+        socket->write(QString("HTTP/1.1 200 OK\r\n"
+                              "Content-Length: %1\r\n"
+                              "Connection: keep-alive\r\n\r\n")
+                      .arg(body.size()).toLatin1());
+        socket->write(body);
+    }
+
+    QThread                        m_thread;
+    QObject                        m_context;
+    QTcpServer                    *m_server        {nullptr};
+    quint16                        m_port          {0};
+    int                            m_segments;
+    std::chrono::milliseconds      m_delay;
+    QMap<QTcpSocket*, QByteArray>  m_pending;
+    std::atomic<int>               m_connections   {0};
+    int                            m_concurrent    {0};
+    std::atomic<int>               m_maxConcurrent {0};
+};
+
+void TestHLSReader::prefetch_test_data(void)
+{
+    QTest::addColumn<uint>("prefetch");
+    QTest::newRow("one at a time") << 0U;
+    QTest::newRow("three ahead")   << 3U;
+}
+
+void TestHLSReader::prefetch_test(void)
+{
+    QFETCH(uint, prefetch);
+
+    static constexpr int kSegments = 20;
+    static constexpr int kTotal = kSegments * kPacketsPerSegment * TSPacket::kSize;
+    SegmentServer server(kSegments, 100ms);
+    QVERIFY(server.Listen());
+
+    HLSReader reader;
+    reader.SetPrefetch(prefetch);
+    reader.Throttle(false);
+    QVERIFY(reader.Open(server.PlaylistURL()));
+
+    QByteArray received;
+    std::array<uint8_t, 64 * 1024> buffer {};
+    QDeadlineTimer deadline(30s);
+    while (received.size() < kTotal && !deadline.hasExpired())
+    {
+        int len = reader.Read(buffer.data(), buffer.size());
+        received.append(reinterpret_cast<char*>(buffer.data()), len);
+        if (len == 0)
+            QTest::qWait(10);
+    }
+    reader.Close();
+
+    QByteArray expected;
+    for (int i = 0; i < kSegments; i++)
+        expected += SegmentServer::Segment(i);
+    QCOMPARE(received.size(), expected.size());
+    QVERIFY(received == expected);
+
+    if (prefetch > 0)
+        QVERIFY(server.MaxConcurrent() > 1);
+    else
+        QCOMPARE(server.MaxConcurrent(), 1);
+
+    // Each downloader keeps its connection for all its segments
+    QVERIFY(server.Connections() <= static_cast<int>(prefetch) + 3);
+}
+
+QTEST_GUILESS_MAIN(TestHLSReader)
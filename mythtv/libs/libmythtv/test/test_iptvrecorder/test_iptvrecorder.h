@@ -23,6 +23,7 @@
 #include "iptvtuningdata.h"
 #include "channelscan/iptvchannelfetcher.h"
 #include "recorders/rtp/rtpdatapacket.h"
+#include "recorders/rtp/rtppacketbuffer.h"
 #include "recorders/rtp/rtptsdatapacket.h"
 
 class TestIPTVRecorder: public QObject
@@ -486,4 +487,98 @@ class TestIPTVRecorder: public QObject
         QCOMPARE (ts_packet2.GetTSData()[0], (uint8_t)0x47);
         QCOMPARE (ts_packet2.GetTSDataSize(), (unsigned int)7 * 188);
     }
+
+    /**
+     * Test SMPTE 2022-1 recovery of a lost packet from an FEC packet
+     */
+    static void RecoverFEC(void)
+    {
+        static constexpr uint kFirst = 65530; // wraps the sequence number
+        static constexpr uint kCount = 10;
+        static constexpr uint kLost  = 4;
+
+        /* build RTP packets with 7 TS packets each, the last one shorter */
+        QVector<QByteArray> packets;
+        for (uint i = 0; i < kCount; i++)
+        {
+            uint size = 12 + (i == kCount - 1 ? 3 : 7) * 188;
+            QByteArray data(size, '\0');
+            uint16_t seq = kFirst + i;
+            uint32_t ts  = 1000 * i;
+            data[0] = static_cast<char>(0x80);
+            data[1] = 33;
+            data[2] = static_cast<char>(seq >> 8);
+            data[3] = static_cast<char>(seq & 0xff);
+            for (uint j = 0; j < 4; j++)
+                data[4 + j] = static_cast<char>(ts >> (24 - 8 * j));
+            data[11] = 0x42;
+            for (uint j = 12; j < size; j++)
+                data[j] = static_cast<char>((i * 31) + j);
+            packets.push_back(data);
+        }
+
+        /* build a row FEC packet over all of them */
+        QByteArray fec(12 + 16 + 7 * 188, '\0');
+        fec[0] = static_cast<char>(0x80);
+        fec[1] = 96;
+        uint length = 0;
+        uint pt     = 0;
+        uint32_t ts = 0;
+        for (uint i = 0; i < kCount; i++)
+        {
+            const QByteArray &data = packets[i];
+            length ^= data.size() - 12;
+            pt     ^= data[1] & 0x7f;
+            ts     ^= 1000 * i;
+            for (int j = 12; j < data.size(); j++)
+                fec[16 + j] = fec[16 + j] ^ data[j];
+        }
+        fec[12] = static_cast<char>(kFirst >> 8);
+        fec[13] = static_cast<char>(kFirst & 0xff);
+        fec[14] = static_cast<char>(length >> 8);
+        fec[15] = static_cast<char>(length & 0xff);
+        fec[16] = static_cast<char>(pt);
+        for (uint j = 0; j < 4; j++)
+            fec[20 + j] = static_cast<char>(ts >> (24 - 8 * j));
+        fec[24] = 0x40; // row
+        fec[25] = 1;    // offset
+        fec[26] = kCount;
+
+        RTPPacketBuffer buffer(0);
+        for (uint i = 0; i < kCount; i++)
+        {
+            if (i == kLost)
+                continue;
+            UDPPacket packet(buffer.GetEmptyPacket());
+            packet.GetDataReference() = packets[i];
+            buffer.PushDataPacket(packet);
+        }
+        UDPPacket fec_packet(buffer.GetEmptyPacket());
+        fec_packet.GetDataReference() = fec;
+        buffer.PushFECPacket(fec_packet, 0);
+
+        QVERIFY (buffer.HasFEC());
+        QCOMPARE (buffer.GetFECRecovered(), (uint64_t)1);
+
+        /* push enough packets to flush the reorder window */
+        for (uint i = kCount; i < kCount + 1000; i++)
+        {
+            UDPPacket packet(buffer.GetEmptyPacket());
+            QByteArray &data = packet.GetDataReference();
+            data = packets[0];
+            uint16_t seq = kFirst + i;
+            data[2] = static_cast<char>(seq >> 8);
+            data[3] = static_cast<char>(seq & 0xff);
+            buffer.PushDataPacket(packet);
+        }
+
+        for (uint i = 0; i < kCount; i++)
+        {
+            QVERIFY (buffer.HasAvailablePacket());
+            UDPPacket packet = buffer.PopDataPacket();
+            QCOMPARE (packet.GetData(), packets[i]);
+            buffer.FreePacket(packet);
+        }
+        QCOMPARE (buffer.GetFECUnrecoverable(), (uint64_t)0);
+    }
 };
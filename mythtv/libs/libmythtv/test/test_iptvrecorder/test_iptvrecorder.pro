@@ -13,6 +13,8 @@ INCLUDEPATH += ../../../libmythservicecontracts
 LIBS += ../../$(OBJECTS_DIR)iptvchannelfetcher.o
 LIBS += ../../$(OBJECTS_DIR)scanmonitor.o
 LIBS += ../../$(OBJECTS_DIR)moc_scanmonitor.o
+LIBS += ../../$(OBJECTS_DIR)packetbuffer.o
+LIBS += ../../$(OBJECTS_DIR)rtppacketbuffer.o
 LIBS += -L../../../libmythbase -lmythbase-$$LIBVERSION
 LIBS += -L../../../libmythui -lmythui-$$LIBVERSION
 LIBS += -L../../../libmythupnp -lmythupnp-$$LIBVERSION
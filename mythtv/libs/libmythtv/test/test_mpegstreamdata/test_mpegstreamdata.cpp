@@ -0,0 +1,438 @@
+/*
+ *  Class TestMPEGStreamData
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include "test_mpegstreamdata.h"
+
+#include <random>
+#include <vector>
+
+#include "mpegstreamdata.h"
+#include "tssync.h"
+
+// A service with video, two audio and a teletext PID plus the
+// typical DVB SI, padding and PIDs that nobody listens to.
+static const std::vector<uint> kMuxPIDs {
+    0x0000, 0x0010, 0x0011, 0x0012, 0x0014, 0x0100, 0x0101, 0x0101,
+    0x0101, 0x0101, 0x0101, 0x0101, 0x0101, 0x0101, 0x0102, 0x0103,
+    0x0104, 0x0200, 0x0201, 0x0201, 0x0201, 0x0201, 0x0202, 0x0300,
+    0x0301, 0x0301, 0x0301, 0x0302, 0x1fff, 0x1fff,
+};
+
+static QByteArray make_multiplex(uint packets)
+{
+    QByteArray mux;
+
+    QString fname = qEnvironmentVariable("MYTHTV_TEST_TS");
+    if (!fname.isEmpty())
+    {
+        QFile file(fname);
+        if (file.open(QIODevice::ReadOnly))
+            mux = file.read(packets * TSPacket::kSize);
+        if (!mux.isEmpty())
+            return mux;
+        qWarning() << "Could not read" << fname << "using generated multiplex";
+    }
+
+    mux.fill('\xff', packets * TSPacket::kSize);
+    for (uint i = 0; i < packets; i++)
+    {
+        uint pid = kMuxPIDs[i % kMuxPIDs.size()];
+        char *pkt = mux.data() + (i * TSPacket::kSize);
+        pkt[0] = SYNC_BYTE;
+        pkt[1] = static_cast<char>((pid >> 8) & 0x1f);
+        pkt[2] = static_cast<char>(pid & 0xff);
+        pkt[3] = static_cast<char>(0x10 | (i & 0xf));
+    }
+    return mux;
+}
+
+// Damages a multiplex the way lossy IPTV and marginal DVB-T inputs
+// do: flipped bytes, lost bytes and runs of junk.
+static QByteArray corrupt_multiplex(const QByteArray &mux, uint seed)
+{
+    std::mt19937 rng(seed);
+    QByteArray out;
+    out.reserve(mux.size() + 4096);
+    for (int i = 0; i < mux.size(); i++)
+    {
+        uint r = rng() % 2000;
+        if (r == 0)
+            continue; // lost byte
+        if (r == 1)
+        {
+            int junk = static_cast<int>(rng() % 400);
+            for (int j = 0; j < junk; j++)
+                out.append(static_cast<char>((rng() % 8 == 0) ? SYNC_BYTE : rng()));
+        }
+        if (r == 2)
+        {
+            out.append(static_cast<char>(rng())); // flipped byte
+            continue;
+        }
+        out.append(mux[i]);
+    }
+    return out;
+}
+
+class RecordingStreamData : public MPEGStreamData
+{
+  public:
+    explicit RecordingStreamData(const unsigned char *base)
+        : MPEGStreamData(-1, -1, false), m_base(base) {}
+    bool ProcessTSPacket(const TSPacket& tspacket) override
+    {
+        m_offsets.push_back(reinterpret_cast<const unsigned char*>(&tspacket) - m_base);
+        return MPEGStreamData::ProcessTSPacket(tspacket);
+    }
+
+    const unsigned char *m_base {nullptr};
+    std::vector<long> m_offsets;
+};
+
+// ProcessTSPacket() as it was before the PID dispatch table, one
+// map lookup for every role of the PID
+class MapStreamData : public MPEGStreamData
+{
+  public:
+    MapStreamData() : MPEGStreamData(1, -1, false) {}
+    bool ProcessTSPacket(const TSPacket& tspacket) override
+    {
+        bool ok = !tspacket.TransportError();
+
+        bool encryption_test = false;
+        {
+            QMutexLocker locker(&m_encryptionLock);
+            encryption_test = m_encryptionPidToInfo.contains(tspacket.PID());
+        }
+        if (encryption_test)
+            ProcessEncryptedPacket(tspacket);
+
+        if (!ok)
+            return false;
+
+        if (tspacket.Scrambled())
+            return true;
+
+        if (IsVideoPID(tspacket.PID()))
+        {
+            for (auto & listener : m_tsAvListeners)
+                listener->ProcessVideoTSPacket(tspacket);
+            return true;
+        }
+
+        if (m_pidsAudio.contains(tspacket.PID()))
+        {
+            for (auto & listener : m_tsAvListeners)
+                listener->ProcessAudioTSPacket(tspacket);
+            return true;
+        }
+
+        if (m_pidsWriting.contains(tspacket.PID()))
+        {
+            for (auto & listener : m_tsWritingListeners)
+                listener->ProcessTSPacket(tspacket);
+        }
+
+        if (tspacket.HasPayload() && !m_listeningDisabled &&
+            !m_pidsNotListening.contains(tspacket.PID()) &&
+            m_pidsListening.contains(tspacket.PID()) &&
+            !m_pidsConditionalAccess.contains(tspacket.PID()))
+        {
+            HandleTSTables(&tspacket);
+        }
+
+        return true;
+    }
+};
+
+// ProcessData() with the scalar sync search it used before
+static int reference_process_data(RecordingStreamData &sd,
+                                  const unsigned char *buffer, int len)
+{
+    int pos = 0;
+    bool resync = false;
+    while (pos + int(TSPacket::kSize) <= len)
+    {
+        if (buffer[pos] != SYNC_BYTE || resync)
+        {
+            int newpos = TSSync::FindSyncScalar(buffer, pos+1, len);
+            if (newpos == -1)
+                return len - pos;
+            if (newpos == -2)
+                return TSPacket::kSize;
+            pos = newpos;
+        }
+
+        const auto *pkt = reinterpret_cast<const TSPacket*>(&buffer[pos]);
+        pos += TSPacket::kSize;
+        resync = false;
+        if (!sd.ProcessTSPacket(*pkt))
+        {
+            if (pos + int(TSPacket::kSize) > len)
+                continue;
+            if (buffer[pos] != SYNC_BYTE)
+            {
+                pos -= TSPacket::kSize;
+                resync = true;
+            }
+        }
+    }
+    return len - pos;
+}
+
+void TestMPEGStreamData::find_sync_test(void)
+{
+    QByteArray mux = make_multiplex(2000);
+    for (uint seed = 1; seed <= 8; seed++)
+    {
+        QByteArray bad = corrupt_multiplex(mux, seed);
+        const auto *buffer = reinterpret_cast<const unsigned char*>(bad.constData());
+        for (int pos = 0; pos < bad.size(); pos += 7)
+        {
+            QCOMPARE(TSSync::FindSync(buffer, pos, bad.size()),
+                     TSSync::FindSyncScalar(buffer, pos, bad.size()));
+        }
+    }
+
+    // No sync at all, and too short to search
+    QByteArray junk(4096, '\x00');
+    const auto *buffer = reinterpret_cast<const unsigned char*>(junk.constData());
+    QCOMPARE(TSSync::FindSync(buffer, 0, junk.size()), -2);
+    QCOMPARE(TSSync::FindSync(buffer, 0, TSPacket::kSize), -1);
+}
+
+void TestMPEGStreamData::process_data_corrupted_test(void)
+{
+    QByteArray mux = make_multiplex(3000);
+    for (uint seed = 1; seed <= 8; seed++)
+    {
+        QByteArray bad = corrupt_multiplex(mux, seed);
+        const auto *buffer = reinterpret_cast<const unsigned char*>(bad.constData());
+
+        RecordingStreamData simd(buffer);
+        RecordingStreamData reference(buffer);
+
+        // Feed it in uneven blocks, as a device read would
+        int offset = 0;
+        while (offset < bad.size())
+        {
+            int len = std::min(bad.size() - offset, 7 * 1316 + 99);
+            int remainder = simd.ProcessData(buffer + offset, len);
+            int ref_remainder = reference_process_data(
+                reference, buffer + offset, len);
+            QCOMPARE(remainder, ref_remainder);
+            if (len == remainder)
+                break;
+            offset += len - remainder;
+        }
+        QCOMPARE(simd.m_offsets, reference.m_offsets);
+    }
+}
+
+void TestMPEGStreamData::find_sync_benchmark_data(void)
+{
+    QTest::addColumn<bool>("simd");
+
+    QTest::newRow("scalar") << false;
+    QTest::newRow("simd")   << true;
+}
+
+void TestMPEGStreamData::find_sync_benchmark(void)
+{
+    QFETCH(bool, simd);
+
+    // Mostly junk, as seen while a marginal input loses sync
+    QByteArray junk(1024 * 1024, '\x00');
+    std::mt19937 rng(7);
+    for (auto & c : junk)
+        c = static_cast<char>((rng() % 64 == 0) ? SYNC_BYTE : (rng() & 0x3f));
+    const auto *buffer = reinterpret_cast<const unsigned char*>(junk.constData());
+
+    int found = 0;
+    QBENCHMARK
+    {
+        int pos = 0;
+        while (pos >= 0)
+        {
+            pos = simd ? TSSync::FindSync(buffer, pos, junk.size())
+                       : TSSync::FindSyncScalar(buffer, pos, junk.size());
+            if (pos >= 0)
+            {
+                found++;
+                pos++;
+            }
+        }
+    }
+    QVERIFY(found > 0);
+}
+
+void TestMPEGStreamData::pid_roles_test(void)
+{
+    MPEGStreamData sd(-1, -1, false);
+
+    // PAT and CAT are added by the constructor
+    QVERIFY(sd.IsListeningPID(PID::MPEG_PAT_PID));
+    QVERIFY(sd.IsListeningPID(PID::MPEG_CAT_PID));
+    QCOMPARE(sd.GetPIDRoles(PID::MPEG_PAT_PID), uint(kPIDRoleListening));
+
+    sd.AddListeningPID(0x100);
+    sd.AddAudioPID(0x101);
+    sd.AddWritingPID(0x102);
+    sd.AddConditionalAccessPID(0x103);
+    QVERIFY(sd.IsListeningPID(0x100));
+    QVERIFY(sd.IsAudioPID(0x101));
+    QVERIFY(!sd.IsAudioPID(0x100));
+    QVERIFY(sd.IsWritingPID(0x102));
+    QVERIFY(sd.IsConditionalAccessPID(0x103));
+    QCOMPARE(sd.GetPIDRoles(0x101), uint(kPIDRoleAudio));
+
+    sd.AddNotListeningPID(0x100);
+    QVERIFY(!sd.IsListeningPID(0x100));
+    QCOMPARE(sd.GetPIDRoles(0x100),
+             uint(kPIDRoleListening | kPIDRoleNotListening));
+    sd.RemoveNotListeningPID(0x100);
+    QVERIFY(sd.IsListeningPID(0x100));
+
+    sd.SetListeningDisabled(true);
+    QVERIFY(!sd.IsListeningPID(0x100));
+    sd.SetListeningDisabled(false);
+
+    sd.RemoveListeningPID(0x100);
+    sd.RemoveAudioPID(0x101);
+    sd.RemoveWritingPID(0x102);
+    QVERIFY(!sd.IsListeningPID(0x100));
+    QVERIFY(!sd.IsAudioPID(0x101));
+    QVERIFY(!sd.IsWritingPID(0x102));
+    QCOMPARE(sd.GetPIDRoles(0x100), uint(kPIDRoleNone));
+
+    sd.AddEncryptionTestPID(1, 0x104, true);
+    QVERIFY(sd.IsEncryptionTestPID(0x104));
+    QVERIFY(sd.IsListeningPID(0x104));
+    sd.RemoveEncryptionTestPIDs(1);
+    QVERIFY(!sd.IsEncryptionTestPID(0x104));
+    QVERIFY(!sd.IsListeningPID(0x104));
+
+    sd.Reset(-1);
+    for (uint pid = 0; pid < 0x2000; pid++)
+    {
+        QCOMPARE(sd.IsListeningPID(pid), sd.ListeningPIDs().contains(pid));
+        QCOMPARE(sd.IsAudioPID(pid), sd.AudioPIDs().contains(pid));
+        QCOMPARE(sd.IsWritingPID(pid), sd.WritingPIDs().contains(pid));
+        QVERIFY(!sd.IsConditionalAccessPID(pid));
+    }
+}
+
+void TestMPEGStreamData::pid_roles_large_pid_test(void)
+{
+    MPEGStreamData sd(-1, -1, false);
+
+    sd.AddListeningPID(0x2000);
+    QVERIFY(sd.IsListeningPID(0x2000));
+    QCOMPARE(sd.GetPIDRoles(0x2000), uint(kPIDRoleNone));
+
+    pid_map_t pids;
+    sd.GetPIDs(pids);
+    QVERIFY(pids.contains(0x2000));
+
+    sd.RemoveListeningPID(0x2000);
+    QVERIFY(!sd.IsListeningPID(0x2000));
+}
+
+void TestMPEGStreamData::pid_lookup_benchmark_data(void)
+{
+    QTest::addColumn<bool>("table");
+
+    QTest::newRow("pid_map_t") << false;
+    QTest::newRow("table")     << true;
+}
+
+void TestMPEGStreamData::pid_lookup_benchmark(void)
+{
+    QFETCH(bool, table);
+
+    MPEGStreamData sd(-1, -1, false);
+    pid_map_t listening;
+    pid_map_t audio;
+    for (uint pid : {0x10U, 0x11U, 0x12U, 0x14U, 0x100U})
+    {
+        sd.AddListeningPID(pid);
+        listening[pid] = kPIDPriorityNormal;
+    }
+    for (uint pid : {0x101U, 0x102U, 0x201U, 0x202U})
+    {
+        sd.AddAudioPID(pid);
+        audio[pid] = kPIDPriorityHigh;
+    }
+
+    uint hits = 0;
+    QBENCHMARK
+    {
+        for (uint i = 0; i < 100000; i++)
+        {
+            uint pid = kMuxPIDs[i % kMuxPIDs.size()];
+            if (table)
+            {
+                uint roles = sd.GetPIDRoles(pid);
+                hits += ((roles & kPIDRoleAudio) != 0U) ? 1 : 0;
+                hits += ((roles & kPIDRoleListening) != 0U) ? 1 : 0;
+            }
+            else
+            {
+                hits += audio.contains(pid) ? 1 : 0;
+                hits += listening.contains(pid) ? 1 : 0;
+            }
+        }
+    }
+    QVERIFY(hits > 0);
+}
+
+void TestMPEGStreamData::process_data_benchmark_data(void)
+{
+    QTest::addColumn<bool>("table");
+
+    QTest::newRow("pid_map_t") << false;
+    QTest::newRow("table")     << true;
+}
+
+// Each iteration processes kPackets packets, or all of MYTHTV_TEST_TS
+void TestMPEGStreamData::process_data_benchmark(void)
+{
+    QFETCH(bool, table);
+
+    static constexpr uint kPackets { 50000 };
+    QByteArray mux = make_multiplex(kPackets);
+    const auto *buffer = reinterpret_cast<const unsigned char*>(mux.constData());
+
+    MapStreamData map_sd;
+    MPEGStreamData table_sd(1, -1, false);
+    MPEGStreamData &sd = table ? table_sd : map_sd;
+    sd.AddListeningPID(0x0010);
+    sd.AddListeningPID(0x0011);
+    sd.AddListeningPID(0x0012);
+    sd.AddListeningPID(0x0014);
+    sd.AddAudioPID(0x0102);
+    sd.AddWritingPID(0x0104);
+
+    QBENCHMARK
+    {
+        int remainder = sd.ProcessData(buffer, mux.size());
+        QCOMPARE(remainder, mux.size() % int(TSPacket::kSize));
+    }
+}
+
+QTEST_APPLESS_MAIN(TestMPEGStreamData)
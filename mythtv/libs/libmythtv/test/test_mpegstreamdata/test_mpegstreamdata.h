@@ -0,0 +1,60 @@
+/*
+ *  Class TestMPEGStreamData
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <QtTest/QtTest>
+
+class TestMPEGStreamData: public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    /** test that the PID dispatch table follows the PID maps
+     */
+    static void pid_roles_test(void);
+
+    /** test PIDs outside the 13 bit range, e.g. 0x2000 for "all PIDs"
+     */
+    static void pid_roles_large_pid_test(void);
+
+    /** compare a pid_map_t lookup with a dispatch table lookup
+     */
+    static void pid_lookup_benchmark_data(void);
+    static void pid_lookup_benchmark(void);
+
+    /** compare the SIMD sync search with the scalar one on damaged data
+     */
+    static void find_sync_test(void);
+
+    /** compare ProcessData() with the scalar sync search it used
+     *  before, on damaged data
+     */
+    static void process_data_corrupted_test(void);
+
+    /** compare the SIMD and scalar sync search speed
+     */
+    static void find_sync_benchmark_data(void);
+    static void find_sync_benchmark(void);
+
+    /** run ProcessData() over a multiplex with the PID map lookups
+     *  ProcessTSPacket() used before and with the dispatch table,
+     *  set MYTHTV_TEST_TS to the name of a recorded multiplex to use
+     *  it instead of the generated one.
+     */
+    static void process_data_benchmark_data(void);
+    static void process_data_benchmark(void);
+};
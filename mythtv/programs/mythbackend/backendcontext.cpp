@@ -9,6 +9,7 @@ AutoExpire  *gExpirer      = nullptr;
 JobQueue    *gJobQueue     = nullptr;
 HouseKeeper *gHousekeeping = nullptr;
 MediaServer *g_pUPnp       = nullptr;
+RecordingChanges *gRecordingChanges = nullptr;
 BackendContext *gBackendContext = nullptr;
 QString      gPidFile;
 MythSystemEventHandler *gSysEventHandler = nullptr;
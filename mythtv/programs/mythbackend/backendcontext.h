@@ -13,6 +13,7 @@ class Scheduler;
 class JobQueue;
 class HouseKeeper;
 class MediaServer;
+class RecordingChanges;
 class BackendContext;
 
 extern QMap<int, EncoderLink *> gTVList;
@@ -20,6 +21,7 @@ extern AutoExpire  *gExpirer;
 extern JobQueue    *gJobQueue;
 extern HouseKeeper *gHousekeeping;
 extern MediaServer *g_pUPnp;
+extern RecordingChanges *gRecordingChanges;
 extern BackendContext *gBackendContext;
 extern QString      gPidFile;
 extern MythSystemEventHandler *gSysEventHandler;
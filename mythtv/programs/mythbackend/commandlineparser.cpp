@@ -25,6 +25,14 @@ void MythBackendCommandLineParser::LoadArguments(void)
          << add("--testsched", "testsched", false,
                 "do some scheduler testing.", "")
 //                    ->SetDeprecated("use mythutil instead")
+         << add("--replaysched", "replaysched", false,
+                "Time the scheduler against a fixture database.",
+                "This command runs the scheduler against the database "
+                "without a running backend, as many times as requested, "
+                "and prints the time spent matching, checking and placing "
+                "in each run followed by the resulting schedule. It is "
+                "meant for a scratch database loaded from a fixture with "
+                "contrib/development/schedreplay.sh.")
          << add("--resched", "resched", false,
                 "Trigger a run of the recording scheduler on the existing "
                 "master backend.",
@@ -68,6 +76,19 @@ void MythBackendCommandLineParser::LoadArguments(void)
 //                    ->SetDeprecated("use mythutil instead");
     );
 
+    add("--replayruns", "replayruns", 3U,
+            "Number of scheduler runs to time (default 3).", "")
+            ->SetChildOf("replaysched");
+    add("--replayoutput", "replayoutput", "",
+            "Write the resulting schedule to this file instead of "
+            "standard output.", "")
+            ->SetChildOf("replaysched");
+    add("--replaychange", "replaychange", 0U,
+            "Raise the priority of this recording rule and check that "
+            "rescheduling keeps the other placements and gives the same "
+            "schedule as a full placement.", "")
+            ->SetChildOf("replaysched");
+
     add("--nosched", "nosched", false, "",
             "Intended for debugging use only, disable the scheduler "
             "on this backend if it is the master backend, preventing "
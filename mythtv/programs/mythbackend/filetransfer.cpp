@@ -1,7 +1,12 @@
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
 #include <QCoreApplication>
 #include <QDateTime>
 #include <QFileInfo>
-#include <utility>
 
 #include "filetransfer.h"
 #include "io/mythmediabuffer.h"
@@ -10,10 +15,43 @@
 #include "programinfo.h"
 #include "mythlogging.h"
 
+std::atomic<uint64_t> FileTransfer::s_bytesSent { 0 };
+std::atomic<uint64_t> FileTransfer::s_bytesCopied { 0 };
+
+/// Opens filename to be sent with sendfile(), if it is a plain local file
+static int OpenForSendFile(const QString &filename)
+{
+#ifdef __linux__
+    if (filename.contains("://"))
+        return -1;
+
+    int fd = open(filename.toLocal8Bit().constData(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return -1;
+
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+    {
+        close(fd);
+        return -1;
+    }
+
+    // The kernel's read ahead replaces that of MythMediaBuffer
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    return fd;
+#else
+    Q_UNUSED(filename);
+    return -1;
+#endif
+}
+
 FileTransfer::FileTransfer(QString &filename, MythSocket *remote,
                            bool usereadahead, std::chrono::milliseconds timeout) :
     ReferenceCounter(QString("FileTransfer:%1").arg(filename)),
-    m_rbuffer(MythMediaBuffer::Create(filename, false, usereadahead, timeout, true)),
+    m_fileFd(OpenForSendFile(filename)),
+    m_rbuffer(MythMediaBuffer::Create(filename, false,
+                                      usereadahead && m_fileFd < 0,
+                                      timeout, true)),
     m_sock(remote)
 {
     m_pginfo = new ProgramInfo(filename);
@@ -49,6 +87,18 @@ FileTransfer::~FileTransfer()
         m_rbuffer = nullptr;
     }
 
+    if (m_fileFd >= 0)
+        close(m_fileFd);
+
+    if (!m_writemode)
+    {
+        LOG(VB_FILE, LOG_INFO,
+            QString("FileTransfer: Served %1 bytes zero-copy and %2 copied, "
+                    "%3 and %4 bytes in all transfers")
+            .arg(m_bytesSent).arg(m_bytesCopied)
+            .arg(s_bytesSent.load()).arg(s_bytesCopied.load()));
+    }
+
     if (m_pginfo)
     {
         m_pginfo->MarkAsInUse(false, kFileTransferInUseID);
@@ -131,6 +181,40 @@ int FileTransfer::RequestBlock(int size)
     while (m_readsLocked)
         m_readsUnlockedCond.wait(&m_lock, 100 /*ms*/);
 
+    if (m_fileFd >= 0 && size > 0)
+    {
+        if (m_filePos < 0)
+            m_filePos = m_rbuffer->GetReadPosition();
+
+        tot = m_sock->SendFile(m_fileFd, &m_filePos, size);
+        if (tot < 0 && (errno == EINVAL || errno == ENOSYS))
+        {
+            LOG(VB_FILE, LOG_INFO, QString("FileTransfer: Can't send '%1' "
+                                           "directly, copying it instead")
+                .arg(m_rbuffer->GetFilename()));
+            close(m_fileFd);
+            m_fileFd = -1;
+            tot = 0;
+        }
+        else if (tot < 0)
+        {
+            return -1;
+        }
+
+        m_bytesSent += tot;
+        s_bytesSent += tot;
+        if (tot == size)
+        {
+            if (m_pginfo)
+                m_pginfo->UpdateInUseMark();
+            return tot;
+        }
+
+        // Hit the end of the file, wait for it to grow as before
+        m_rbuffer->Seek(m_filePos, SEEK_SET);
+        m_filePos = -1;
+    }
+
     m_requestBuffer.resize(std::max((size_t)std::max(size,0) + 128, m_requestBuffer.size()));
     char *buf = &m_requestBuffer[0];
     while (tot < size && !m_rbuffer->GetStopReads() && m_readthreadlive)
@@ -148,6 +232,8 @@ int FileTransfer::RequestBlock(int size)
             break;
         }
 
+        m_bytesCopied += ret;
+        s_bytesCopied += ret;
         tot += ret;
         if (ret < request)
             break; // we hit eof
@@ -234,6 +320,17 @@ long long FileTransfer::Seek(long long curpos, long long pos, int whence)
 
     Pause();
 
+    // m_rbuffer didn't follow what was sent with sendfile()
+    if (m_filePos >= 0)
+    {
+        if (whence == SEEK_CUR)
+        {
+            pos += curpos;
+            whence = SEEK_SET;
+        }
+        m_filePos = -1;
+    }
+
     if (whence == SEEK_CUR)
     {
         long long desired = curpos + pos;
@@ -2,6 +2,7 @@
 #define FILETRANSFER_H_
 
 // C++ headers
+#include <atomic>
 #include <cstdint>
 #include <vector>
 
@@ -53,6 +54,13 @@ class FileTransfer : public ReferenceCounter
     QWaitCondition  m_readsUnlockedCond;
 
     ProgramInfo    *m_pginfo            {nullptr};
+    /// The file sent straight from the kernel with sendfile(), or -1 when
+    /// it is read from m_rbuffer and copied.  Set before m_rbuffer, which
+    /// doesn't read ahead when the file is sent this way.
+    int             m_fileFd            {-1};
+    /// Position of the next byte sent from m_fileFd, or -1 when m_rbuffer
+    /// is at the current position.
+    long long       m_filePos           {-1};
     MythMediaBuffer* m_rbuffer          {nullptr};
     MythSocket     *m_sock              {nullptr};
     bool            m_ateof             {false};
@@ -62,6 +70,11 @@ class FileTransfer : public ReferenceCounter
     QMutex          m_lock;
 
     bool            m_writemode         {false};
+
+    uint64_t        m_bytesSent         {0};
+    uint64_t        m_bytesCopied       {0};
+    static std::atomic<uint64_t> s_bytesSent;   ///< zero-copy, all transfers
+    static std::atomic<uint64_t> s_bytesCopied; ///< all transfers
 };
 
 #endif
@@ -149,6 +149,7 @@ int main(int argc, char **argv)
     if (cmdline.toBool("event")         || cmdline.toBool("systemevent") ||
         cmdline.toBool("setverbose")    || cmdline.toBool("printsched") ||
         cmdline.toBool("testsched")     || cmdline.toBool("resched") ||
+        cmdline.toBool("replaysched")   ||
         cmdline.toBool("scanvideos")    || cmdline.toBool("clearcache") ||
         cmdline.toBool("printexpire")   || cmdline.toBool("setloglevel"))
     {
@@ -22,6 +22,7 @@
 #include <QFile>
 #include <QDir>
 #include <QMap>
+#include <QTextStream>
 
 #include "tv_rec.h"
 #include "scheduledrecording.h"
@@ -31,6 +32,7 @@
 #include "encoderlink.h"
 #include "remoteutil.h"
 #include "backendhousekeeper.h"
+#include "recordingchanges.h"
 
 #include "mythcontext.h"
 #include "mythversion.h"
@@ -39,7 +41,9 @@
 #include "exitcodes.h"
 #include "compat.h"
 #include "storagegroup.h"
+#include "storagefileindex.h"
 #include "programinfo.h"
+#include "recordingtypes.h"
 #include "dbcheck.h"
 #include "jobqueue.h"
 #include "previewgenerator.h"
@@ -278,6 +282,9 @@ void cleanup(void)
     delete gExpirer;
     gExpirer = nullptr;
 
+    delete gRecordingChanges;
+    gRecordingChanges = nullptr;
+
     delete gJobQueue;
     gJobQueue = nullptr;
 
@@ -309,6 +316,8 @@ void cleanup(void)
     delete mainServer;
     mainServer = nullptr;
 
+    StorageFileIndex::Disable();
+
      delete gBackendContext;
      gBackendContext = nullptr;
 
@@ -321,6 +330,201 @@ void cleanup(void)
     SignalHandler::Done();
 }
 
+/// One line per showing, in a form that can be diffed against the
+/// schedule of an earlier replay
+static QString replay_line(const RecordingInfo *p)
+{
+    return QString("%1 %2 %3 %4 %5 %6 %7 %8 %9\n")
+        .arg(p->GetRecordingStartTime().toString(Qt::ISODate),
+             p->GetRecordingEndTime().toString(Qt::ISODate),
+             QString::number(p->GetChanID()),
+             QString::number(p->GetInputID()),
+             QString(toQChar(p->GetRecordingRuleType())),
+             RecStatus::toString(p->GetRecordingStatus(),
+                                 p->GetInputID()),
+             QString::number(p->GetRecordingPriority()),
+             QString::number(p->GetRecordingRuleID()),
+             p->toString(ProgramInfo::kTitleSubtitle, " - ", ""));
+}
+
+static QStringList replay_lines(RecList &schedule)
+{
+    QStringList lines;
+    while (!schedule.empty())
+    {
+        lines << replay_line(schedule.front());
+        delete schedule.front();
+        schedule.pop_front();
+    }
+    return lines;
+}
+
+static bool replay_priority(uint recordid, int change)
+{
+    MSqlQuery query(MSqlQuery::ChannelCon());
+    query.prepare("UPDATE record SET recpriority = recpriority + :CHANGE "
+                  "WHERE recordid = :RECORDID");
+    query.bindValue(":CHANGE", change);
+    query.bindValue(":RECORDID", recordid);
+    if (!query.exec())
+    {
+        MythDB::DBError("replay_priority", query);
+        return false;
+    }
+    return true;
+}
+
+/// Places the schedule, raises the priority of one recording rule and
+/// reschedules with the same scheduler, so that the showings the change
+/// does not affect keep their placement.  The result is compared
+/// against a full placement by a new scheduler.
+static int replay_change(uint recordid)
+{
+    auto *sched = new Scheduler(false, &gTVList);
+    sched->FillRecordListFromDB(0);
+
+    if (!replay_priority(recordid, 1))
+    {
+        delete sched;
+        return GENERIC_EXIT_DB_ERROR;
+    }
+
+    Scheduler::PhaseTimes times;
+    RecList schedule;
+    sched->FillRecordListFromDB(0, &times);
+    sched->GetAllPending(schedule);
+    delete sched;
+    QStringList incremental = replay_lines(schedule);
+
+    sched = new Scheduler(false, &gTVList);
+    sched->FillRecordListFromDB(0);
+    sched->GetAllPending(schedule);
+    delete sched;
+    QStringList full = replay_lines(schedule);
+
+    bool restored = replay_priority(recordid, -1);
+
+    int differ = 0;
+    for (int i = 0; i < std::max(incremental.size(), full.size()); i++)
+    {
+        QString a = (i < incremental.size()) ? incremental[i] : QString();
+        QString b = (i < full.size()) ? full[i] : QString();
+        if (a == b)
+            continue;
+        if (!b.isEmpty())
+            std::cout << "full:        " << b.toLocal8Bit().constData();
+        if (!a.isEmpty())
+            std::cout << "incremental: " << a.toLocal8Bit().constData();
+        differ++;
+    }
+
+    std::cout << QString("Change to rule %1: %2 ms place, %3 of %4 showings "
+                         "placed again, %5 differ from a full placement\n")
+        .arg(recordid)
+        .arg(duration_cast<floatmsecs>(times.m_place).count(), 0, 'f', 1)
+        .arg(times.m_placed)
+        .arg(full.size())
+        .arg(differ)
+        .toLocal8Bit().constData() << std::flush;
+
+    if (!restored)
+        return GENERIC_EXIT_DB_ERROR;
+    return (differ == 0) ? GENERIC_EXIT_OK : GENERIC_EXIT_NOT_OK;
+}
+
+/// Runs the speculative scheduler against the database a number of
+/// times and reports how long each phase took, followed by the
+/// resulting schedule.  With --replaychange it also checks that an
+/// incremental reschedule matches a full placement.  Run under
+/// faketime at the time the fixture was dumped, see
+/// contrib/development/schedreplay.sh, the schedule comes out the same
+/// every time.
+static int replay_schedule(const MythBackendCommandLineParser &cmdline)
+{
+    uint runs = std::max(cmdline.toUInt("replayruns"), 1U);
+
+    QFile outfile;
+    if (cmdline.toString("replayoutput").isEmpty())
+    {
+        if (!outfile.open(stdout, QIODevice::WriteOnly))
+            return GENERIC_EXIT_NOT_OK;
+    }
+    else
+    {
+        outfile.setFileName(cmdline.toString("replayoutput"));
+        if (!outfile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC_ERR +
+                QString("Unable to open %1").arg(outfile.fileName()));
+            return GENERIC_EXIT_PERMISSIONS_ERROR;
+        }
+    }
+
+    ProgramInfo::CheckProgramIDAuthorities();
+
+    // The database server does not run under faketime, so make NOW()
+    // in its queries agree with our clock.  The speculative scheduler
+    // keeps all of its queries on the channel connection.
+    MSqlQuery clock(MSqlQuery::ChannelCon());
+    clock.prepare("SET TIMESTAMP = :NOW");
+    clock.bindValue(":NOW",
+        static_cast<qlonglong>(MythDate::current().toSecsSinceEpoch()));
+    if (!clock.exec())
+    {
+        MythDB::DBError("replay_schedule", clock);
+        return GENERIC_EXIT_DB_ERROR;
+    }
+
+    Scheduler::PhaseTimes best;
+    RecList schedule;
+    for (uint run = 1; run <= runs; run++)
+    {
+        // A new scheduler each time, so that no run can reuse the
+        // placements of the one before
+        auto *sched = new Scheduler(false, &gTVList);
+        Scheduler::PhaseTimes times;
+        sched->FillRecordListFromDB(0, &times);
+        if (run == runs)
+            sched->GetAllPending(schedule);
+        delete sched;
+
+        std::cout << QString("Run %1: %2 ms match, %3 ms check, %4 ms place\n")
+            .arg(run)
+            .arg(duration_cast<floatmsecs>(times.m_match).count(), 0, 'f', 1)
+            .arg(duration_cast<floatmsecs>(times.m_check).count(), 0, 'f', 1)
+            .arg(duration_cast<floatmsecs>(times.m_place).count(), 0, 'f', 1)
+            .toLocal8Bit().constData();
+
+        if (run == 1 || times.m_match < best.m_match)
+            best.m_match = times.m_match;
+        if (run == 1 || times.m_check < best.m_check)
+            best.m_check = times.m_check;
+        if (run == 1 || times.m_place < best.m_place)
+            best.m_place = times.m_place;
+    }
+
+    std::cout << QString("Best: %1 ms match, %2 ms check, %3 ms place\n")
+        .arg(duration_cast<floatmsecs>(best.m_match).count(), 0, 'f', 1)
+        .arg(duration_cast<floatmsecs>(best.m_check).count(), 0, 'f', 1)
+        .arg(duration_cast<floatmsecs>(best.m_place).count(), 0, 'f', 1)
+        .toLocal8Bit().constData() << std::flush;
+
+    int ret = GENERIC_EXIT_OK;
+    if (cmdline.toUInt("replaychange") > 0)
+        ret = replay_change(cmdline.toUInt("replaychange"));
+
+    clock.prepare("SET TIMESTAMP = DEFAULT");
+    if (!clock.exec())
+        MythDB::DBError("replay_schedule", clock);
+
+    QTextStream out(&outfile);
+    for (const auto & line : replay_lines(schedule))
+        out << line;
+    out.flush();
+
+    return ret;
+}
+
 int handle_command(const MythBackendCommandLineParser &cmdline)
 {
     QString eventString;
@@ -424,6 +628,9 @@ int handle_command(const MythBackendCommandLineParser &cmdline)
         return GENERIC_EXIT_OK;
     }
 
+    if (cmdline.toBool("replaysched"))
+        return replay_schedule(cmdline);
+
     if (cmdline.toBool("resched"))
     {
         bool ok = false;
@@ -649,6 +856,9 @@ int run_backend(MythBackendCommandLineParser &cmdline)
     if (fatal_error)
         return GENERIC_EXIT_SETUP_ERROR;
 
+    // Watches storage directories from the main thread's event loop
+    StorageFileIndex::Enable();
+
     Scheduler *sched = nullptr;
     if (ismaster)
     {
@@ -674,6 +884,8 @@ int run_backend(MythBackendCommandLineParser &cmdline)
                 sched->SetExpirer(gExpirer);
         }
         gCoreContext->SetScheduler(sched);
+
+        gRecordingChanges = new RecordingChanges();
     }
 
     if (!cmdline.toBool("nohousekeeper"))
@@ -63,6 +63,7 @@
 #include "jobqueue.h"
 #include "autoexpire.h"
 #include "storagegroup.h"
+#include "storagefileindex.h"
 #include "compat.h"
 #include "io/mythmediabuffer.h"
 #include "remotefile.h"
@@ -84,6 +85,7 @@
 
 // mythbackend headers
 #include "backendcontext.h"
+#include "recordingchanges.h"
 
 /** Milliseconds to wait for an existing thread from
  *  process request thread pool.
@@ -98,6 +100,13 @@ static constexpr std::chrono::milliseconds PRT_TIMEOUT { 10ms };
 
 namespace {
 
+/// True if the client asks for the programs of its reply to be packed,
+/// see ProgramListPacker.
+bool is_packed_request(const QStringList &listline)
+{
+    return listline.size() > 1 && listline.last() == ProgramListPacker::kTag;
+}
+
 bool delete_file_immediately(const QString &filename,
                             bool followLinks, bool checkexists)
 {
@@ -542,7 +551,11 @@ void MainServer::ProcessRequestWork(MythSocket *sock)
         if (tokens.size() != 2)
             SendErrorResponse(pbs, "Bad QUERY_RECORDINGS query");
         else
-            HandleQueryRecordings(tokens[1], pbs);
+            HandleQueryRecordings(tokens[1], pbs, is_packed_request(listline));
+    }
+    else if (command == "QUERY_RECORDING_CHANGES")
+    {
+        HandleQueryRecordingChanges(tokens, pbs);
     }
     else if (command == "QUERY_RECORDING")
     {
@@ -572,6 +585,10 @@ void MainServer::ProcessRequestWork(MythSocket *sock)
     {
         HandleQueryUptime(pbs);
     }
+    else if (command == "QUERY_SQL_STATS")
+    {
+        HandleQuerySQLStats(tokens, pbs);
+    }
     else if (command == "QUERY_HOSTNAME")
     {
         HandleQueryHostname(pbs);
@@ -682,12 +699,14 @@ void MainServer::ProcessRequestWork(MythSocket *sock)
     }
     else if (command == "QUERY_GETALLPENDING")
     {
+        bool packed = is_packed_request(listline);
         if (tokens.size() == 1)
-            HandleGetPendingRecordings(pbs);
+            HandleGetPendingRecordings(pbs, "", -1, packed);
         else if (tokens.size() == 2)
-            HandleGetPendingRecordings(pbs, tokens[1]);
+            HandleGetPendingRecordings(pbs, tokens[1], -1, packed);
         else
-            HandleGetPendingRecordings(pbs, tokens[1], tokens[2].toInt());
+            HandleGetPendingRecordings(pbs, tokens[1], tokens[2].toInt(),
+                                       packed);
     }
     else if (command == "QUERY_GETALLSCHEDULED")
     {
@@ -1511,6 +1530,9 @@ void MainServer::customEvent(QEvent *e)
         if (me->Message().startsWith("LOCAL_"))
             return;
 
+        if (gRecordingChanges)
+            gRecordingChanges->HandleEvent(*me);
+
         if (me->Message() == "CREATE_THUMBNAILS")
             ImageManagerBe::getInstance()->HandleCreateThumbnails(me->ExtraDataList());
 
@@ -2166,8 +2188,11 @@ void MainServer::SendResponse(MythSocket *socket, QStringList &commands)
  * or "Descending".
  * Returns programinfo (title, subtitle, description, category, chanid,
  * channum, callsign, channel.name, fileURL, \e et \e cetera)
+ * When the request ends with ProgramListPacker::kTag the programs are
+ * returned packed, see ProgramListPacker.
  */
-void MainServer::HandleQueryRecordings(const QString& type, PlaybackSock *pbs)
+void MainServer::HandleQueryRecordings(const QString& type, PlaybackSock *pbs,
+                                       bool packed)
 {
     MythSocket *pbssock = pbs->getSocket();
     QString playbackhost = pbs->getHostname();
@@ -2198,95 +2223,206 @@ void MainServer::HandleQueryRecordings(const QString& type, PlaybackSock *pbs)
         delete *mit;
 
     QStringList outputlist(QString::number(destination.size()));
+    ProgramListPacker packer;
     QMap<QString, int> backendPortMap;
-    int port = gCoreContext->GetBackendServerPort();
-    QString host = gCoreContext->GetHostName();
 
     for (auto* proginfo : destination)
     {
-        PlaybackSock *slave = nullptr;
+        FillRecordedInfo(proginfo, playbackhost, backendPortMap);
+
+        if (packed)
+            packer.Add(*proginfo);
+        else
+            proginfo->ToStringList(outputlist);
+    }
+
+    if (packed)
+        packer.AppendTo(outputlist);
 
-        if (proginfo->GetHostname() != gCoreContext->GetHostName())
-            slave = GetSlaveByHostname(proginfo->GetHostname());
+    SendResponse(pbssock, outputlist);
+}
 
-        if ((proginfo->GetHostname() == gCoreContext->GetHostName()) ||
-            (!slave && m_masterBackendOverride))
+/**
+ * \brief Sets the pathname a client should play a recording from and
+ *        fills in its file size, from the slave backend that has it
+ *        when that is not this one.
+ */
+void MainServer::FillRecordedInfo(ProgramInfo *proginfo,
+                                  const QString &playbackhost,
+                                  QMap<QString, int> &backendPortMap)
+{
+    int port = gCoreContext->GetBackendServerPort();
+    QString host = gCoreContext->GetHostName();
+
+    PlaybackSock *slave = nullptr;
+
+    if (proginfo->GetHostname() != gCoreContext->GetHostName())
+        slave = GetSlaveByHostname(proginfo->GetHostname());
+
+    if ((proginfo->GetHostname() == gCoreContext->GetHostName()) ||
+        (!slave && m_masterBackendOverride))
+    {
+        proginfo->SetPathname(MythCoreContext::GenMythURL(host,port,
+                                                          proginfo->GetBasename()));
+        if (!proginfo->GetFilesize())
         {
-            proginfo->SetPathname(MythCoreContext::GenMythURL(host,port,
-                                                              proginfo->GetBasename()));
-            if (!proginfo->GetFilesize())
+            QString tmpURL = GetPlaybackURL(proginfo);
+            if (tmpURL.startsWith('/'))
             {
-                QString tmpURL = GetPlaybackURL(proginfo);
-                if (tmpURL.startsWith('/'))
+                qint64 size = StorageFileIndex::Size(
+                    tmpURL, proginfo->GetRecordingEndTime());
+                if (size >= 0)
                 {
-                    QFile checkFile(tmpURL);
-                    if (!tmpURL.isEmpty() && checkFile.exists())
+                    proginfo->SetFilesize(size);
+                    if (proginfo->GetRecordingEndTime() <
+                        MythDate::current())
                     {
-                        proginfo->SetFilesize(checkFile.size());
-                        if (proginfo->GetRecordingEndTime() <
-                            MythDate::current())
-                        {
-                            proginfo->SaveFilesize(proginfo->GetFilesize());
-                        }
+                        proginfo->SaveFilesize(proginfo->GetFilesize());
                     }
                 }
             }
         }
-        else if (!slave)
+    }
+    else if (!slave)
+    {
+        proginfo->SetPathname(GetPlaybackURL(proginfo));
+        if (proginfo->GetPathname().isEmpty())
         {
-            proginfo->SetPathname(GetPlaybackURL(proginfo));
-            if (proginfo->GetPathname().isEmpty())
-            {
-                LOG(VB_GENERAL, LOG_ERR, LOC +
-                    QString("HandleQueryRecordings() "
-                            "Couldn't find backend for:\n\t\t\t%1")
-                        .arg(proginfo->toString(ProgramInfo::kTitleSubtitle)));
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                QString("FillRecordedInfo() "
+                        "Couldn't find backend for:\n\t\t\t%1")
+                    .arg(proginfo->toString(ProgramInfo::kTitleSubtitle)));
 
-                proginfo->SetFilesize(0);
-                proginfo->SetPathname("file not found");
-            }
+            proginfo->SetFilesize(0);
+            proginfo->SetPathname("file not found");
         }
-        else
+    }
+    else
+    {
+        if (!proginfo->GetFilesize())
         {
-            if (!proginfo->GetFilesize())
+            if (!slave->FillProgramInfo(*proginfo, playbackhost))
             {
-                if (!slave->FillProgramInfo(*proginfo, playbackhost))
-                {
-                    LOG(VB_GENERAL, LOG_ERR, LOC +
-                        "MainServer::HandleQueryRecordings()"
-                        "\n\t\t\tCould not fill program info "
-                        "from backend");
-                }
-                else
-                {
-                    if (proginfo->GetRecordingEndTime() <
-                        MythDate::current())
-                    {
-                        proginfo->SaveFilesize(proginfo->GetFilesize());
-                    }
-                }
+                LOG(VB_GENERAL, LOG_ERR, LOC +
+                    "MainServer::FillRecordedInfo()"
+                    "\n\t\t\tCould not fill program info "
+                    "from backend");
             }
             else
             {
-                ProgramInfo *p      = proginfo;
-                QString hostname    = p->GetHostname();
+                if (proginfo->GetRecordingEndTime() <
+                    MythDate::current())
+                {
+                    proginfo->SaveFilesize(proginfo->GetFilesize());
+                }
+            }
+        }
+        else
+        {
+            ProgramInfo *p      = proginfo;
+            QString hostname    = p->GetHostname();
 
-                if (!backendPortMap.contains(hostname))
-                    backendPortMap[hostname] = gCoreContext->GetBackendServerPort(hostname);
+            if (!backendPortMap.contains(hostname))
+                backendPortMap[hostname] = gCoreContext->GetBackendServerPort(hostname);
 
-                p->SetPathname(MythCoreContext::GenMythURL(hostname,
-                                                           backendPortMap[hostname],
-                                                           p->GetBasename()));
-            }
+            p->SetPathname(MythCoreContext::GenMythURL(hostname,
+                                                       backendPortMap[hostname],
+                                                       p->GetBasename()));
         }
+    }
 
-        if (slave)
-            slave->DecrRef();
+    if (slave)
+        slave->DecrRef();
+}
 
-        proginfo->ToStringList(outputlist);
+/**
+ * \addtogroup myth_network_protocol
+ * \par        QUERY_RECORDING_CHANGES [\e generation \e sequence]
+ * Returns the recordings changed since \e sequence of the change journal
+ * \e generation, see RecordingChanges.  The reply starts with the current
+ * generation and sequence, then either "RESET", when the client has to
+ * reload the whole list with QUERY_RECORDINGS, or "OK", the number of
+ * changes and for each change "DELETE" and the recordedid or "UPDATE"
+ * and the programinfo.  Without arguments it only returns the current
+ * generation and sequence, and "RESET".
+ */
+void MainServer::HandleQueryRecordingChanges(const QStringList &tokens,
+                                             PlaybackSock *pbs)
+{
+    MythSocket *pbssock = pbs->getSocket();
+    QStringList strlist;
+
+    if (!gRecordingChanges)
+    {
+        strlist << "0" << "0" << "RESET";
+        SendResponse(pbssock, strlist);
+        return;
     }
 
-    SendResponse(pbssock, outputlist);
+    RecordingChanges::ChangeMap changes;
+    quint64 sequence = 0;
+    bool ok = (tokens.size() == 3) &&
+        gRecordingChanges->ChangesSince(tokens[1].toULongLong(),
+                                        tokens[2].toULongLong(),
+                                        changes, sequence);
+
+    strlist << QString::number(gRecordingChanges->Generation())
+            << QString::number(sequence);
+    if (!ok)
+    {
+        strlist << "RESET";
+        SendResponse(pbssock, strlist);
+        return;
+    }
+
+    strlist << "OK" << QString::number(changes.size());
+
+    // Fill in the updated recordings the same way HandleQueryRecordings()
+    // and LoadFromRecorded() do, so that they match a full reload
+    QString playbackhost = pbs->getHostname();
+    QMap<QString,uint32_t> inUseMap;
+    QMap<QString,bool> isJobRunning;
+    if (changes.key(RecordingChanges::kChanged, 0) != 0)
+    {
+        inUseMap = ProgramInfo::QueryInUseMap();
+        isJobRunning = ProgramInfo::QueryJobsRunning(JOB_COMMFLAG);
+    }
+    QMap<QString, int> backendPortMap;
+
+    QDateTime rectime = MythDate::current().addSecs(
+        -gCoreContext->GetNumSetting("RecordOverTime"));
+    for (auto it = changes.cbegin(); it != changes.cend(); ++it)
+    {
+        ProgramInfo pginfo;
+        if (*it == RecordingChanges::kChanged)
+            pginfo = ProgramInfo(it.key());
+
+        if (!pginfo.GetChanID())
+        {
+            strlist << "DELETE" << QString::number(it.key());
+            continue;
+        }
+
+        RecStatus::Type recstatus = RecStatus::Recorded;
+        if (m_sched && pginfo.GetRecordingEndTime() > rectime)
+        {
+            RecStatus::Type status = m_sched->GetRecStatus(pginfo);
+            if (status == RecStatus::Recording ||
+                status == RecStatus::Tuning ||
+                status == RecStatus::Failing)
+            {
+                recstatus = RecStatus::Recording;
+            }
+        }
+        pginfo.SetRecordingStatus(recstatus);
+        pginfo.UpdateInUseAndJobFlags(inUseMap, isJobRunning);
+        FillRecordedInfo(&pginfo, playbackhost, backendPortMap);
+
+        strlist << "UPDATE";
+        pginfo.ToStringList(strlist);
+    }
+
+    SendResponse(pbssock, strlist);
 }
 
 /**
@@ -2507,6 +2643,7 @@ void MainServer::DoDeleteThread(DeleteStruct *ds)
     nameFilters.push_back(fInfo.fileName() + ".old");
     nameFilters.push_back(fInfo.fileName() + ".map");
     nameFilters.push_back(fInfo.fileName() + ".tmp.map");
+    nameFilters.push_back(fInfo.fileName() + ".seek");
     nameFilters.push_back(fInfo.baseName() + ".srt");  // e.g. 1234_20150213165800.srt
 
     QDir dir (fInfo.path());
@@ -3547,6 +3684,49 @@ void MainServer::HandleQueryUptime(PlaybackSock *pbs)
     SendResponse(pbssock, strlist);
 }
 
+/**
+ * \addtogroup myth_network_protocol
+ * \par        QUERY_SQL_STATS [\e ENABLE | \e DISABLE | \e RESET]
+ * Returns the SQL statement timings collected by this backend, see
+ * MSqlProfiler, after enabling, disabling or resetting them if asked to.
+ * The reply is "OK", 1 if profiling is enabled or 0, the number of
+ * statements, and for each statement its normalized SQL, the number of
+ * times it ran, and the total and longest time it took in microseconds.
+ */
+void MainServer::HandleQuerySQLStats(const QStringList &tokens,
+                                     PlaybackSock *pbs)
+{
+    MythSocket *pbssock = pbs->getSocket();
+    QStringList strlist;
+
+    QString action = (tokens.size() > 1) ? tokens[1].toUpper() : QString();
+    if (action == "ENABLE")
+        MSqlProfiler::SetEnabled(true);
+    else if (action == "DISABLE")
+        MSqlProfiler::SetEnabled(false);
+    else if (action == "RESET")
+        MSqlProfiler::Reset();
+    else if (!action.isEmpty())
+    {
+        strlist << "ERROR" << "Bad QUERY_SQL_STATS action";
+        SendResponse(pbssock, strlist);
+        return;
+    }
+
+    std::vector<MSqlProfiler::Stats> stats = MSqlProfiler::GetStats();
+    strlist << "OK" << QString::number(MSqlProfiler::IsEnabled() ? 1 : 0)
+            << QString::number(stats.size());
+    for (const auto &entry : stats)
+    {
+        strlist << entry.m_statement
+                << QString::number(entry.m_count)
+                << QString::number(entry.m_total.count())
+                << QString::number(entry.m_max.count());
+    }
+
+    SendResponse(pbssock, strlist);
+}
+
 /**
  * \addtogroup myth_network_protocol
  * \par        QUERY_HOSTNAME
@@ -3818,7 +3998,8 @@ void MainServer::HandleQueryGuideDataThrough(PlaybackSock *pbs)
 }
 
 void MainServer::HandleGetPendingRecordings(PlaybackSock *pbs,
-                                            const QString& tmptable, int recordid)
+                                            const QString& tmptable, int recordid,
+                                            bool packed)
 {
     MythSocket *pbssock = pbs->getSocket();
 
@@ -3827,12 +4008,12 @@ void MainServer::HandleGetPendingRecordings(PlaybackSock *pbs,
     if (m_sched)
     {
         if (tmptable.isEmpty())
-            m_sched->GetAllPending(strList);
+            m_sched->GetAllPending(strList, packed);
         else
         {
             auto *sched = new Scheduler(false, m_encoderList, tmptable, m_sched);
             sched->FillRecordListFromDB(recordid);
-            sched->GetAllPending(strList);
+            sched->GetAllPending(strList, packed);
             delete sched;
 
             if (recordid > 0)
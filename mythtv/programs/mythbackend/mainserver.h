@@ -176,7 +176,12 @@ class MainServer : public QObject, public MythSocketCBs
     bool HandleDeleteFile(const QStringList &slist, PlaybackSock *pbs);
     bool HandleDeleteFile(const QString& filename, const QString& storagegroup,
                           PlaybackSock *pbs = nullptr);
-    void HandleQueryRecordings(const QString& type, PlaybackSock *pbs);
+    void HandleQueryRecordings(const QString& type, PlaybackSock *pbs,
+                               bool packed = false);
+    void FillRecordedInfo(ProgramInfo *proginfo, const QString &playbackhost,
+                          QMap<QString, int> &backendPortMap);
+    void HandleQueryRecordingChanges(const QStringList &tokens,
+                                     PlaybackSock *pbs);
     void HandleQueryRecording(QStringList &slist, PlaybackSock *pbs);
     void HandleStopRecording(QStringList &slist, PlaybackSock *pbs);
     void DoHandleStopRecording(RecordingInfo &recinfo, PlaybackSock *pbs);
@@ -202,7 +207,8 @@ class MainServer : public QObject, public MythSocketCBs
     void HandleQueryFindFile(QStringList &slist, PlaybackSock *pbs);
     void HandleQueryFileHash(QStringList &slist, PlaybackSock *pbs);
     void HandleQueryGuideDataThrough(PlaybackSock *pbs);
-    void HandleGetPendingRecordings(PlaybackSock *pbs, const QString& table = "", int recordid=-1);
+    void HandleGetPendingRecordings(PlaybackSock *pbs, const QString& table = "", int recordid=-1,
+                                    bool packed = false);
     void HandleGetScheduledRecordings(PlaybackSock *pbs);
     void HandleGetConflictingRecordings(QStringList &slist, PlaybackSock *pbs);
     void HandleGetExpiringRecordings(PlaybackSock *pbs);
@@ -263,6 +269,7 @@ class MainServer : public QObject, public MythSocketCBs
     void HandleBackendRefresh(MythSocket *socket);
     void HandleQueryLoad(PlaybackSock *pbs);
     void HandleQueryUptime(PlaybackSock *pbs);
+    void HandleQuerySQLStats(const QStringList &tokens, PlaybackSock *pbs);
     void HandleQueryHostname(PlaybackSock *pbs);
     void HandleQueryMemStats(PlaybackSock *pbs);
     void HandleQueryTimeZone(PlaybackSock *pbs);
@@ -28,7 +28,7 @@ HEADERS += playbacksock.h scheduler.h server.h backendhousekeeper.h
 HEADERS += upnpcdstv.h upnpcdsmusic.h upnpcdsvideo.h mediaserver.h
 HEADERS += internetContent.h main_helpers.h backendcontext.h
 HEADERS += httpconfig.h mythsettings.h commandlineparser.h
-HEADERS += recordingextender.h
+HEADERS += recordingextender.h recordingchanges.h
 
 HEADERS += serviceHosts/mythServiceHost.h    serviceHosts/guideServiceHost.h
 HEADERS += serviceHosts/contentServiceHost.h serviceHosts/dvrServiceHost.h
@@ -47,7 +47,7 @@ SOURCES += backendhousekeeper.cpp
 SOURCES += upnpcdstv.cpp upnpcdsmusic.cpp upnpcdsvideo.cpp mediaserver.cpp
 SOURCES += internetContent.cpp main_helpers.cpp backendcontext.cpp
 SOURCES += httpconfig.cpp mythsettings.cpp commandlineparser.cpp
-SOURCES += recordingextender.cpp
+SOURCES += recordingextender.cpp recordingchanges.cpp
 
 SOURCES += services/myth.cpp services/guide.cpp services/content.cpp 
 SOURCES += services/dvr.cpp services/channel.cpp services/video.cpp
@@ -74,6 +74,7 @@ HEADERS += servicesv2/v2blurayInfo.h
 
 HEADERS += servicesv2/v2dvr.h servicesv2/v2recording.h
 HEADERS += servicesv2/v2programAndChannel.h servicesv2/v2programList.h
+HEADERS += servicesv2/v2recordedChanges.h
 HEADERS += servicesv2/v2channelGroup.h servicesv2/v2channelGroupList.h
 HEADERS += servicesv2/v2recRule.h
 HEADERS += servicesv2/v2cutting.h servicesv2/v2cutList.h
@@ -0,0 +1,111 @@
+#include <QDateTime>
+
+#include "mythevent.h"
+#include "mythlogging.h"
+#include "programinfo.h"
+
+#include "recordingchanges.h"
+
+#define LOC QString("RecChanges: ")
+
+RecordingChanges::RecordingChanges(void) :
+    m_generation(QDateTime::currentMSecsSinceEpoch())
+{
+}
+
+quint64 RecordingChanges::Sequence(void) const
+{
+    QMutexLocker locker(&m_lock);
+    return m_sequence;
+}
+
+void RecordingChanges::Add(uint recordedid, Change change)
+{
+    if (!recordedid)
+        return;
+
+    QMutexLocker locker(&m_lock);
+
+    // A client only needs the latest change of each recording
+    auto latest = m_latest.find(recordedid);
+    if (latest != m_latest.end())
+        m_changes.remove(*latest);
+
+    m_changes.insert(++m_sequence, {recordedid, change});
+    m_latest[recordedid] = m_sequence;
+
+    if (m_changes.size() > kMaxRecordings)
+    {
+        auto oldest = m_changes.begin();
+        m_oldest = oldest.key();
+        m_latest.remove(oldest->m_recordedId);
+        m_changes.erase(oldest);
+    }
+}
+
+void RecordingChanges::Reset(void)
+{
+    QMutexLocker locker(&m_lock);
+    m_oldest = ++m_sequence;
+    m_changes.clear();
+    m_latest.clear();
+
+    LOG(VB_GENERAL, LOG_DEBUG, LOC +
+        QString("Clients reload at change %1").arg(m_sequence));
+}
+
+void RecordingChanges::HandleEvent(const MythEvent &event)
+{
+    const QString& message = event.Message();
+    if (message.startsWith("RECORDING_LIST_CHANGE"))
+    {
+        QStringList tokens = message.simplified().split(" ");
+        if (tokens.size() >= 2 && tokens[1] == "UPDATE")
+        {
+            ProgramInfo evinfo(event.ExtraDataList());
+            if (evinfo.GetRecordingID())
+            {
+                Add(evinfo.GetRecordingID(), kChanged);
+                return;
+            }
+        }
+        else if (tokens.size() >= 3 && tokens[1] == "ADD")
+        {
+            Add(tokens[2].toUInt(), kChanged);
+            return;
+        }
+        else if (tokens.size() >= 3 && tokens[1] == "DELETE")
+        {
+            Add(tokens[2].toUInt(), kDeleted);
+            return;
+        }
+        // Anything else may have changed any recording
+        Reset();
+    }
+    else if (message.startsWith("MASTER_UPDATE_REC_INFO") ||
+             message.startsWith("UPDATE_FILE_SIZE"))
+    {
+        QStringList tokens = message.simplified().split(" ");
+        if (tokens.size() >= 2)
+            Add(tokens[1].toUInt(), kChanged);
+    }
+}
+
+bool RecordingChanges::ChangesSince(quint64 generation, quint64 sequence,
+                                    ChangeMap &changes,
+                                    quint64 &current) const
+{
+    QMutexLocker locker(&m_lock);
+    current = m_sequence;
+
+    if (generation != m_generation || sequence < m_oldest ||
+        sequence > m_sequence)
+    {
+        return false;
+    }
+
+    for (auto it = m_changes.upperBound(sequence); it != m_changes.end(); ++it)
+        changes[it->m_recordedId] = it->m_change;
+
+    return true;
+}
@@ -0,0 +1,75 @@
+#ifndef RECORDINGCHANGES_H_
+#define RECORDINGCHANGES_H_
+
+#include <cstdint>
+
+#include <QHash>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+
+class MythEvent;
+
+/** \brief Journal of the changes to the recorded list.
+ *
+ *  The master backend numbers every change it announces with a
+ *  RECORDING_LIST_CHANGE event, so that a client which has loaded the
+ *  whole list can later ask for just the recordings changed since then.
+ *  The numbers start over when the backend starts, each run has its own
+ *  generation which clients must send along with their number.
+ *
+ *  Only the latest change of each recording is kept, and no more than
+ *  kMaxRecordings of those.  A client that asks about an older number,
+ *  another generation, or a change that can't be told recording by
+ *  recording has to reload the whole list.
+ */
+class RecordingChanges
+{
+  public:
+    enum Change : std::uint8_t
+    {
+        kChanged,  ///< Added or updated, the client should reload it
+        kDeleted,
+    };
+    using ChangeMap = QMap<uint, Change>;
+
+    static constexpr int kMaxRecordings { 10000 };
+
+    RecordingChanges(void);
+    explicit RecordingChanges(quint64 generation) :
+        m_generation(generation) {}
+
+    quint64 Generation(void) const { return m_generation; }
+    quint64 Sequence(void) const;
+
+    void Add(uint recordedid, Change change);
+    /// Records a change clients can only catch up with by reloading
+    void Reset(void);
+    /// Records the change announced by a recording list event
+    void HandleEvent(const MythEvent &event);
+
+    /** \brief Collects the latest change of each recording changed
+     *         after sequence.
+     *  \param current set to the sequence number of the latest change
+     *  \return false if the client has to reload the whole list
+     */
+    bool ChangesSince(quint64 generation, quint64 sequence,
+                      ChangeMap &changes, quint64 &current) const;
+
+  private:
+    struct Entry
+    {
+        uint   m_recordedId;
+        Change m_change;
+    };
+
+    mutable QMutex          m_lock;
+    const quint64           m_generation;
+    quint64                 m_sequence {0};
+    /// Changes after this one are all in m_changes
+    quint64                 m_oldest   {0};
+    QMap<quint64, Entry>    m_changes;
+    QHash<uint, quint64>    m_latest;
+};
+
+#endif // RECORDINGCHANGES_H_
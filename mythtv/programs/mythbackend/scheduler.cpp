@@ -1,6 +1,10 @@
 #include <iostream>
 #include <algorithm>
+#include <atomic>
+#include <climits>
+#include <limits>
 #include <list>
+#include <memory>
 #include <chrono> // for milliseconds
 #include <thread> // for sleep_for
 
@@ -23,6 +27,9 @@
 #include <QMutex>
 #include <QFile>
 #include <QMap>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QRegularExpression>
 
 #include "mythmiscutil.h"
 #include "mythsystemlegacy.h"
@@ -455,6 +462,29 @@ bool Scheduler::FillRecordList(void)
 
     LOG(VB_SCHEDULE, LOG_INFO, "Sort by priority...");
     SORT_RECLIST(m_workList, comp_priority);
+
+    // Showings that are unchanged since the last reschedule keep their
+    // placement, unless LiveTV may have moved recordings around or the
+    // open end setting changed.
+    bool livetv = false;
+    if (m_tvList)
+    {
+        for (auto * enc : qAsConst(*m_tvList))
+            livetv |= (enc->GetState() == kState_WatchingLiveTV);
+    }
+    auto openEnd = (OpenEndType)
+        gCoreContext->GetNumSetting("SchedOpenEnd", openEndNever);
+
+    LOG(VB_SCHEDULE, LOG_INFO, "GetPlacementInfo...");
+    std::vector<PlacementInfo> placements = GetPlacementInfo();
+    RecList reused;
+    if (!livetv && openEnd == m_placedOpenEnd)
+    {
+        LOG(VB_SCHEDULE, LOG_INFO, "ReusePlacements...");
+        ReusePlacements(placements, reused);
+    }
+    m_placedCount = m_workList.size();
+
     LOG(VB_SCHEDULE, LOG_INFO, "BuildListMaps...");
     BuildListMaps();
     LOG(VB_SCHEDULE, LOG_INFO, "SchedNewRecords...");
@@ -464,6 +494,17 @@ bool Scheduler::FillRecordList(void)
     LOG(VB_SCHEDULE, LOG_INFO, "ClearListMaps...");
     ClearListMaps();
 
+    m_workList.insert(m_workList.end(), reused.begin(), reused.end());
+    if (livetv)
+    {
+        m_placed.clear();
+        m_placedSizes.clear();
+    }
+    else
+    {
+        SavePlacements(placements);
+    }
+
     m_schedLock.lock();
 
     LOG(VB_SCHEDULE, LOG_INFO, "Sort by time...");
@@ -479,11 +520,13 @@ bool Scheduler::FillRecordList(void)
     return res;
 }
 
-/** \fn Scheduler::FillRecordListFromDB(int)
+/** \fn Scheduler::FillRecordListFromDB(uint, PhaseTimes*)
  *  \param recordid Record ID of recording that has changed,
  *                  or 0 if anything might have been changed.
+ *  \param times    If not null, receives the time spent matching,
+ *                  checking and placing.
  */
-void Scheduler::FillRecordListFromDB(uint recordid)
+void Scheduler::FillRecordListFromDB(uint recordid, PhaseTimes *times)
 {
     MSqlQuery query(m_dbConn);
     QString thequery;
@@ -564,6 +607,14 @@ void Scheduler::FillRecordListFromDB(uint recordid)
         .arg(duration_cast<floatsecs>(checkTime).count(), 0, 'f', 2)
         .arg(duration_cast<floatsecs>(placeTime).count(), 0, 'f', 2);
     LOG(VB_GENERAL, LOG_INFO, msg);
+
+    if (times)
+    {
+        times->m_match = matchTime;
+        times->m_check = checkTime;
+        times->m_place = placeTime;
+        times->m_placed = m_placedCount;
+    }
 }
 
 void Scheduler::FillRecordListFromMaster(void)
@@ -1009,6 +1060,243 @@ void Scheduler::PruneOverlaps(void)
     erase_nulls(m_workList);
 }
 
+static constexpr uint kNoComponent { UINT_MAX };
+
+/// What is needed to decide whether a showing can keep the placement
+/// it got from the last reschedule.
+class Scheduler::PlacementInfo
+{
+  public:
+    RecordingInfo *m_p         {nullptr};
+    QString        m_key;
+    QByteArray     m_signature;
+    uint           m_component {0};
+};
+
+static QString placement_key(const RecordingInfo *p)
+{
+    return QString("%1_%2_%3_%4")
+        .arg(p->GetRecordingRuleID()).arg(p->GetChanID())
+        .arg(p->GetRecordingStartTime(MythDate::kFilename))
+        .arg(p->GetInputID());
+}
+
+// Everything about a showing that its placement depends on.
+static QByteArray placement_signature(const RecordingInfo *p)
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << static_cast<qint32>(p->GetRecordingStatus())
+           << p->GetRecordingRuleID() << p->GetParentRecordingRuleID()
+           << static_cast<qint32>(p->GetRecordingRuleType())
+           << p->GetFindID()
+           << static_cast<qint32>(p->GetDuplicateCheckMethod())
+           << p->GetChanID() << p->GetChannelSchedulingID()
+           << p->GetChanNum() << p->GetInputID()
+           << p->m_sgroupId << p->m_mplexId
+           << p->GetRecordingStartTime() << p->GetRecordingEndTime()
+           << p->GetScheduledStartTime() << p->GetScheduledEndTime()
+           << p->GetRecordingPriority() << p->GetRecordingPriority2()
+           << p->m_schedOrder << p->IsReactivated()
+           << static_cast<qint32>(p->GetCategoryType())
+           << p->GetTitle() << p->GetSubtitle()
+           << p->GetDescription() << p->GetProgramID();
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+}
+
+/** \brief Splits the work list into showings that can be placed
+ *         independently of each other.
+ *
+ *  Placing a showing only looks at the showings with the same title or
+ *  recording rule, and at those that overlap it on the inputs of its
+ *  conflict list. Linking all of those into components, the placement
+ *  within a component does not depend on anything outside of it.
+ */
+std::vector<Scheduler::PlacementInfo> Scheduler::GetPlacementInfo(void) const
+{
+    std::vector<PlacementInfo> placements(m_workList.size());
+    std::vector<size_t> parent(m_workList.size());
+    for (size_t i = 0; i < parent.size(); ++i)
+        parent[i] = i;
+
+    auto findroot = [&parent](size_t i)
+    {
+        while (parent[i] != i)
+            i = parent[i] = parent[parent[i]];
+        return i;
+    };
+    auto unite = [&parent, &findroot](size_t a, size_t b)
+    {
+        parent[findroot(a)] = findroot(b);
+    };
+
+    QHash<QString, size_t> titles;
+    QHash<uint, size_t> rules;
+    QHash<RecList*, std::vector<size_t> > conflictlists;
+    for (size_t i = 0; i < m_workList.size(); ++i)
+    {
+        const RecordingInfo *p = m_workList[i];
+        placements[i].m_p = m_workList[i];
+        placements[i].m_key = placement_key(p);
+        placements[i].m_signature = placement_signature(p);
+
+        QString title = p->GetTitle().toLower();
+        if (titles.contains(title))
+            unite(i, titles[title]);
+        else
+            titles[title] = i;
+
+        if (rules.contains(p->GetRecordingRuleID()))
+            unite(i, rules[p->GetRecordingRuleID()]);
+        else
+            rules[p->GetRecordingRuleID()] = i;
+
+        auto sit = m_sinputInfoMap.constFind(p->GetInputID());
+        RecList *conflictlist = (sit != m_sinputInfoMap.constEnd()) ?
+            sit->m_conflictList : nullptr;
+        conflictlists[conflictlist].push_back(i);
+    }
+
+    for (size_t i = 0; i < m_workList.size(); ++i)
+    {
+        uint parentid = m_workList[i]->GetParentRecordingRuleID();
+        if (parentid && rules.contains(parentid))
+            unite(i, rules[parentid]);
+    }
+
+    // Showings that overlap, or just touch, on a conflict list
+    for (auto & list : conflictlists)
+    {
+        std::sort(list.begin(), list.end(), [this](size_t a, size_t b)
+        {
+            return m_workList[a]->GetRecordingStartTime() <
+                m_workList[b]->GetRecordingStartTime();
+        });
+
+        QDateTime endtime;
+        for (size_t j = 0; j < list.size(); ++j)
+        {
+            const RecordingInfo *p = m_workList[list[j]];
+            if (j > 0 && p->GetRecordingStartTime() <= endtime)
+                unite(list[j], list[j - 1]);
+            if (j == 0 || p->GetRecordingEndTime() > endtime)
+                endtime = p->GetRecordingEndTime();
+        }
+    }
+
+    QHash<size_t, uint> components;
+    for (size_t i = 0; i < placements.size(); ++i)
+    {
+        size_t root = findroot(i);
+        if (!components.contains(root))
+        {
+            uint id = static_cast<uint>(components.size());
+            components[root] = id;
+        }
+        placements[i].m_component = components[root];
+    }
+
+    return placements;
+}
+
+/** \brief Gives the showings of components that are unchanged since the
+ *         last reschedule the placement they got then.
+ *
+ *  Those showings are moved from the work list to reused, so that only
+ *  the remaining ones get placed. A component is reused only if it
+ *  consists of the same showings, with the same signature, as one of
+ *  the last reschedule, and none of its showings started in between.
+ *
+ *  \return Number of showings reused.
+ */
+uint Scheduler::ReusePlacements(const std::vector<PlacementInfo> &placements,
+                                RecList &reused)
+{
+    uint count = 0;
+    for (const auto & info : placements)
+        count = std::max(count, info.m_component + 1);
+
+    std::vector<uint> sizes(count, 0);
+    std::vector<uint> oldcomponents(count, kNoComponent);
+    std::vector<bool> changed(count, false);
+
+    // Showings whose start time passed the reference time of the
+    // priority and retry sorting in between.
+    QDateTime changestart = m_placedTime.addSecs(-60);
+    QDateTime changeend   = m_schedTime.addSecs(60);
+
+    for (const auto & info : placements)
+    {
+        uint c = info.m_component;
+        ++sizes[c];
+        auto it = m_placed.constFind(info.m_key);
+        if (it == m_placed.constEnd() || it->m_component == kNoComponent ||
+            it->m_signature != info.m_signature)
+        {
+            changed[c] = true;
+            continue;
+        }
+        if (oldcomponents[c] == kNoComponent)
+            oldcomponents[c] = it->m_component;
+        else if (oldcomponents[c] != it->m_component)
+            changed[c] = true;
+
+        QDateTime start = info.m_p->GetRecordingStartTime();
+        if (start >= changestart && start < changeend)
+            changed[c] = true;
+    }
+
+    for (uint c = 0; c < count; ++c)
+    {
+        if (oldcomponents[c] >= m_placedSizes.size() ||
+            m_placedSizes[oldcomponents[c]] != sizes[c])
+            changed[c] = true;
+    }
+
+    uint reusedcount = 0;
+    for (size_t i = 0; i < placements.size(); ++i)
+    {
+        if (changed[placements[i].m_component])
+            continue;
+        RecordingInfo *p = placements[i].m_p;
+        p->SetRecordingStatus(m_placed[placements[i].m_key].m_recStatus);
+        reused.push_back(p);
+        m_workList[i] = nullptr;
+        ++reusedcount;
+    }
+
+    erase_nulls(m_workList);
+
+    return reusedcount;
+}
+
+void Scheduler::SavePlacements(const std::vector<PlacementInfo> &placements)
+{
+    m_placed.clear();
+    m_placedSizes.clear();
+    for (const auto & info : placements)
+    {
+        if (info.m_component >= m_placedSizes.size())
+            m_placedSizes.resize(info.m_component + 1, 0);
+        ++m_placedSizes[info.m_component];
+
+        // Two showings with the same key can't be told apart
+        if (m_placed.contains(info.m_key))
+        {
+            m_placed[info.m_key].m_component = kNoComponent;
+            continue;
+        }
+
+        PlacedShowing &placed = m_placed[info.m_key];
+        placed.m_signature = info.m_signature;
+        placed.m_recStatus = info.m_p->GetRecordingStatus();
+        placed.m_component = info.m_component;
+    }
+
+    m_placedTime = m_schedTime;
+    m_placedOpenEnd = m_openEnd;
+}
+
 void Scheduler::BuildListMaps(void)
 {
     QMap<uint, uint> badinputs;
@@ -1042,12 +1330,18 @@ void Scheduler::BuildListMaps(void)
             QString("Ignored %1 entries for invalid input %2")
             .arg(badinputs[it.value()]).arg(it.key()));
     }
+
+    // Neither the members of the conflict lists nor their times change
+    // until ClearListMaps(), only their status does.
+    for (auto *conflict : m_conflictLists)
+        m_conflictIndex[conflict].Build(*conflict);
 }
 
 void Scheduler::ClearListMaps(void)
 {
     for (auto & conflict : m_conflictLists)
         conflict->clear();
+    m_conflictIndex.clear();
     m_titleListMap.clear();
     m_recordIdListMap.clear();
     m_cacheIsSameProgram.clear();
@@ -1069,6 +1363,55 @@ bool Scheduler::IsSameProgram(
     return m_cacheIsSameProgram[X] = a->IsDuplicateProgram(*b);
 }
 
+void Scheduler::ConflictIndex::Build(const RecList &list)
+{
+    m_positions.resize(list.size());
+    for (size_t i = 0; i < m_positions.size(); ++i)
+        m_positions[i] = i;
+    std::stable_sort(m_positions.begin(), m_positions.end(),
+                     [&list](size_t a, size_t b)
+                     {
+                         return list[a]->GetRecordingStartTime() <
+                                list[b]->GetRecordingStartTime();
+                     });
+
+    m_starts.resize(list.size());
+    m_ends.resize(list.size());
+    m_maxEnds.resize(list.size());
+    qint64 maxend = std::numeric_limits<qint64>::min();
+    for (size_t i = 0; i < m_positions.size(); ++i)
+    {
+        const RecordingInfo *q = list[m_positions[i]];
+        m_starts[i] = q->GetRecordingStartTime().toMSecsSinceEpoch();
+        m_ends[i] = q->GetRecordingEndTime().toMSecsSinceEpoch();
+        maxend = std::max(maxend, m_ends[i]);
+        m_maxEnds[i] = maxend;
+    }
+}
+
+std::vector<size_t> Scheduler::ConflictIndex::Overlapping(
+    const QDateTime &start, const QDateTime &end, size_t from) const
+{
+    qint64 startms = start.toMSecsSinceEpoch();
+    qint64 endms = end.toMSecsSinceEpoch();
+
+    // Everything before first ends before start, everything from last
+    // on starts after end.
+    auto first = std::lower_bound(m_maxEnds.cbegin(), m_maxEnds.cend(),
+                                  startms) - m_maxEnds.cbegin();
+    auto last = std::upper_bound(m_starts.cbegin(), m_starts.cend(),
+                                 endms) - m_starts.cbegin();
+
+    std::vector<size_t> positions;
+    for (auto i = first; i < last; ++i)
+    {
+        if (m_ends[i] >= startms && m_positions[i] >= from)
+            positions.push_back(m_positions[i]);
+    }
+    std::sort(positions.begin(), positions.end());
+    return positions;
+}
+
 bool Scheduler::FindNextConflict(
     const RecList     &cardlist,
     const RecordingInfo *p,
@@ -1077,9 +1420,34 @@ bool Scheduler::FindNextConflict(
     uint              *paffinity,
     bool              ignoreinput) const
 {
+    // Only showings that overlap or touch p can conflict with it or
+    // add to its affinity, so when the list is indexed skip straight
+    // from one of those to the next.
+    std::vector<size_t> overlapping;
+    auto index = m_conflictIndex.constFind(&cardlist);
+    bool indexed = (index != m_conflictIndex.constEnd());
+    if (indexed)
+    {
+        overlapping = index->Overlapping(p->GetRecordingStartTime(),
+                                         p->GetRecordingEndTime(),
+                                         static_cast<size_t>(
+                                             iter - cardlist.cbegin()));
+    }
+    auto next = overlapping.cbegin();
+
     uint affinity = 0;
     for ( ; iter != cardlist.end(); ++iter)
     {
+        if (indexed)
+        {
+            if (next == overlapping.cend())
+            {
+                iter = cardlist.end();
+                break;
+            }
+            iter = cardlist.cbegin() + static_cast<ptrdiff_t>(*next++);
+        }
+
         const RecordingInfo *q = *iter;
         QString msg;
 
@@ -1817,7 +2185,9 @@ RecStatus::Type Scheduler::GetRecStatus(const ProgramInfo &pginfo)
     return pginfo.GetRecordingStatus();
 }
 
-void Scheduler::GetAllPending(QStringList &strList) const
+/// Returns all pending programs serialized into a QStringList, packed
+/// with ProgramListPacker if packed is true
+void Scheduler::GetAllPending(QStringList &strList, bool packed) const
 {
     RecList retlist;
     bool hasconflicts = GetAllPending(retlist);
@@ -1825,13 +2195,20 @@ void Scheduler::GetAllPending(QStringList &strList) const
     strList << QString::number(static_cast<int>(hasconflicts));
     strList << QString::number(retlist.size());
 
+    ProgramListPacker packer;
     while (!retlist.empty())
     {
         RecordingInfo *p = retlist.front();
-        p->ToStringList(strList);
+        if (packed)
+            packer.Add(*p);
+        else
+            p->ToStringList(strList);
         delete p;
         retlist.pop_front();
     }
+
+    if (packed)
+        packer.AppendTo(strList);
 }
 
 /// Returns all scheduled programs serialized into a QStringList
@@ -2435,12 +2812,13 @@ bool Scheduler::HandleReschedule(void)
     }
 
     msg = QString("Scheduled %1 items in %2 "
-                  "= %3 match + %4 check + %5 place")
+                  "= %3 match + %4 check + %5 place (%6 re-placed)")
         .arg(m_recList.size())
         .arg(duration_cast<floatsecs>(matchTime + checkTime + placeTime).count(), 0, 'f', 1)
         .arg(duration_cast<floatsecs>(matchTime).count(), 0, 'f', 2)
         .arg(duration_cast<floatsecs>(checkTime).count(), 0, 'f', 2)
-        .arg(duration_cast<floatsecs>(placeTime).count(), 0, 'f', 2);
+        .arg(duration_cast<floatsecs>(placeTime).count(), 0, 'f', 2)
+        .arg(m_placedCount);
     LOG(VB_GENERAL, LOG_INFO, msg);
 
     // Write changed entries to oldrecorded.
@@ -3966,6 +4344,71 @@ static QString progfindid = QString(
         .arg(kWeeklyRecord)
         .arg(kOverrideRecord);
 
+namespace {
+
+/// Most connections UpdateMatches() runs its queries on at once
+constexpr int kMaxMatchThreads { 8 };
+
+/// One of the recordmatch queries of UpdateMatches()
+class MatchQuery
+{
+  public:
+    QString m_query;
+    QString m_rule;
+    std::chrono::microseconds m_time {0us};
+    int  m_results {0};
+    bool m_ok      {false};
+};
+
+bool run_match_query(MSqlQuery &result, MatchQuery &match,
+                     const MSqlBindings &bindings)
+{
+    auto dbstart = nowAsDuration<std::chrono::microseconds>();
+    result.prepare(match.m_query);
+
+    for (auto it = bindings.cbegin(); it != bindings.cend(); ++it)
+    {
+        if (match.m_query.contains(it.key()))
+            result.bindValue(it.key(), it.value());
+    }
+
+    match.m_ok = result.exec();
+    match.m_time = nowAsDuration<std::chrono::microseconds>() - dbstart;
+    match.m_results = match.m_ok ? result.size() : 0;
+    return match.m_ok;
+}
+
+/// Runs the match queries of UpdateMatches() that nobody else has taken
+/// yet, on a database connection of its own.
+class MatchQueryThread : public MThread
+{
+  public:
+    MatchQueryThread(int id, std::vector<MatchQuery> &queries,
+                     std::atomic<size_t> &next, const MSqlBindings &bindings)
+        : MThread(QString("SchedMatch%1").arg(id)),
+          m_queries(queries), m_next(next), m_bindings(bindings) {}
+    ~MatchQueryThread() override { wait(); }
+
+  protected:
+    void run(void) override // MThread
+    {
+        RunProlog();
+        for (size_t i = m_next++; i < m_queries.size(); i = m_next++)
+        {
+            MSqlQuery result(MSqlQuery::InitCon());
+            run_match_query(result, m_queries[i], m_bindings);
+        }
+        RunEpilog();
+    }
+
+  private:
+    std::vector<MatchQuery> &m_queries;
+    std::atomic<size_t>     &m_next;
+    const MSqlBindings      &m_bindings;
+};
+
+} // namespace
+
 void Scheduler::UpdateMatches(uint recordid, uint sourceid, uint mplexid,
                               const QDateTime &maxstarttime)
 {
@@ -4065,6 +4508,9 @@ void Scheduler::UpdateMatches(uint recordid, uint sourceid, uint mplexid,
         }
     }
 
+    static const QRegularExpression kRecIdBinding { ":NR\\d+RECID" };
+
+    std::vector<MatchQuery> matches(fromclauses.count());
     for (int clause = 0; clause < fromclauses.count(); ++clause)
     {
         QString query2 = QString(
@@ -4104,33 +4550,94 @@ void Scheduler::UpdateMatches(uint recordid, uint sourceid, uint mplexid,
 
         query2.replace("RECTABLE", m_recordTable);
 
-        LOG(VB_SCHEDULE, LOG_INFO, QString(" |-- Start DB Query %1...")
-                .arg(clause));
+        matches[clause].m_query = query2;
 
-        auto dbstart = nowAsDuration<std::chrono::microseconds>();
-        MSqlQuery result(m_dbConn);
-        result.prepare(query2);
+        // Name the rule the query is for, so that slow ones stand out
+        QRegularExpressionMatch rulematch =
+            kRecIdBinding.match(whereclauses[clause]);
+        if (rulematch.hasMatch())
+        {
+            matches[clause].m_rule = QString("rule %1")
+                .arg(bindings.value(rulematch.captured()).toString());
+        }
+        else
+        {
+            matches[clause].m_rule = QString("query %1").arg(clause);
+        }
+    }
+
+    // The running scheduler fills the real recordmatch table from the
+    // real record table, so the queries can run side by side on
+    // connections of their own.  Everyone else works on temporary
+    // tables only their own connection can see.
+    int threads = 1;
+    if (m_doRun && m_recordTable == "record")
+    {
+        threads = std::clamp(gCoreContext->GetNumSetting("SchedMatchThreads", 1),
+                             1, kMaxMatchThreads);
+        threads = std::min(threads, static_cast<int>(matches.size()));
+    }
 
-        for (it = bindings.cbegin(); it != bindings.cend(); ++it)
+    if (threads > 1)
+    {
+        LOG(VB_SCHEDULE, LOG_INFO, QString(" |-- Running %1 DB queries on "
+                                           "%2 connections...")
+            .arg(matches.size()).arg(threads));
+
+        std::atomic<size_t> next {0};
+        std::vector<std::unique_ptr<MatchQueryThread>> workers;
+        for (int i = 0; i < threads; ++i)
         {
-            if (query2.contains(it.key()))
-                result.bindValue(it.key(), it.value());
+            workers.push_back(std::make_unique<MatchQueryThread>(
+                                  i, matches, next, bindings));
+            workers.back()->start();
         }
+        workers.clear();
+    }
 
-        bool ok = result.exec();
-        auto dbend = nowAsDuration<std::chrono::microseconds>();
-        auto dbTime = dbend - dbstart;
+    for (size_t clause = 0; clause < matches.size(); ++clause)
+    {
+        MatchQuery &match = matches[clause];
 
-        if (!ok)
+        // Run whatever did not run, or failed, possibly by deadlocking
+        // with another of the queries, on the scheduler connection.
+        if (!match.m_ok)
         {
-            MythDB::DBError("UpdateMatches3", result);
-            continue;
+            LOG(VB_SCHEDULE, LOG_INFO, QString(" |-- Start DB Query %1...")
+                .arg(clause));
+
+            MSqlQuery result(m_dbConn);
+            if (!run_match_query(result, match, bindings))
+            {
+                MythDB::DBError("UpdateMatches3", result);
+                continue;
+            }
         }
 
-        LOG(VB_SCHEDULE, LOG_INFO, QString(" |-- %1 results in %2 sec.")
-                .arg(result.size())
-                .arg(duration_cast<std::chrono::seconds>(dbTime).count()));
+        LOG(VB_SCHEDULE, LOG_INFO, QString(" |-- %1: %2 results in %3 sec.")
+                .arg(match.m_rule)
+                .arg(match.m_results)
+                .arg(duration_cast<floatsecs>(match.m_time).count(), 0, 'f', 3));
+    }
 
+    if (VERBOSE_LEVEL_CHECK(VB_SCHEDULE, LOG_INFO) && matches.size() > 1)
+    {
+        std::vector<const MatchQuery *> slowest;
+        for (const auto & match : matches)
+            slowest.push_back(&match);
+        size_t count = std::min<size_t>(slowest.size(), 5);
+        std::partial_sort(slowest.begin(), slowest.begin() + count,
+                          slowest.end(),
+                          [](const MatchQuery *a, const MatchQuery *b)
+                          { return a->m_time > b->m_time; });
+        for (size_t i = 0; i < count; ++i)
+        {
+            LOG(VB_SCHEDULE, LOG_INFO, QString(" |-- Slowest %1: %2 in %3 sec.")
+                .arg(i + 1)
+                .arg(slowest[i]->m_rule)
+                .arg(duration_cast<floatsecs>(slowest[i]->m_time).count(),
+                     0, 'f', 3));
+        }
     }
 
     LOG(VB_SCHEDULE, LOG_INFO, " +-- Done.");
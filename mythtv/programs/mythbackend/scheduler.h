@@ -10,6 +10,7 @@
 #include <QObject>
 #include <QString>
 #include <QMutex>
+#include <QHash>
 #include <QMap>
 #include <QSet>
 
@@ -68,7 +69,17 @@ class Scheduler : public MThread, public MythScheduler
     void AddRecording(const RecordingInfo &pi);
     void AddRecording(const ProgramInfo& prog)
     { AddRecording(RecordingInfo(prog)); };
-    void FillRecordListFromDB(uint recordid = 0);
+    /// Time spent in each phase of a FillRecordListFromDB() run
+    class PhaseTimes
+    {
+      public:
+        std::chrono::microseconds m_match {0};
+        std::chrono::microseconds m_check {0};
+        std::chrono::microseconds m_place {0};
+        /// Showings placed rather than kept from the run before
+        uint                      m_placed {0};
+    };
+    void FillRecordListFromDB(uint recordid = 0, PhaseTimes *times = nullptr);
     void FillRecordListFromMaster(void);
 
     void UpdateRecStatus(RecordingInfo *pginfo);
@@ -79,7 +90,9 @@ class Scheduler : public MThread, public MythScheduler
     // true iff there are conflicts
     bool GetAllPending(RecList &retList, int recRuleId = 0) const;
     bool GetAllPending(ProgramList &retList, int recRuleId = 0) const;
-    void GetAllPending(QStringList &strList) const override; // MythScheduler
+    void GetAllPending(QStringList &strList) const override // MythScheduler
+        { GetAllPending(strList, false); }
+    void GetAllPending(QStringList &strList, bool packed) const;
     QMap<QString,ProgramInfo*> GetRecording(void) const override; // MythScheduler
     RecordingInfo* GetRecording(uint recordedid) const;
 
@@ -153,6 +166,12 @@ class Scheduler : public MThread, public MythScheduler
     void BuildListMaps(void);
     void ClearListMaps(void);
 
+    class PlacementInfo;
+    std::vector<PlacementInfo> GetPlacementInfo(void) const;
+    uint ReusePlacements(const std::vector<PlacementInfo> &placements,
+                         RecList &reused);
+    void SavePlacements(const std::vector<PlacementInfo> &placements);
+
     bool IsBusyRecording(const RecordingInfo *rcinfo);
 
     bool IsSameProgram(const RecordingInfo *a, const RecordingInfo *b) const;
@@ -246,6 +265,28 @@ class Scheduler : public MThread, public MythScheduler
     RecList                m_livetvList;
     QMap<uint, SchedInputInfo> m_sinputInfoMap;
     std::vector<RecList *> m_conflictLists;
+
+    // The showings of a conflict list ordered by recording start time,
+    // so that those overlapping a showing can be looked up without
+    // walking the whole list.
+    class ConflictIndex
+    {
+      public:
+        void Build(const RecList &list);
+        // Positions in the list, from position from on and in list
+        // order, of the showings overlapping or touching [start, end]
+        std::vector<size_t> Overlapping(const QDateTime &start,
+                                        const QDateTime &end,
+                                        size_t from) const;
+      private:
+        std::vector<qint64> m_starts;
+        std::vector<qint64> m_ends;
+        // Running maximum of m_ends
+        std::vector<qint64> m_maxEnds;
+        std::vector<size_t> m_positions;
+    };
+    QHash<const RecList *, ConflictIndex> m_conflictIndex;
+
     QMap<uint, RecList>    m_recordIdListMap;
     QMap<QString, RecList> m_titleListMap;
 
@@ -291,6 +332,22 @@ class Scheduler : public MThread, public MythScheduler
     using IsSameCacheType = QMap<IsSameKey,bool>;
     mutable IsSameCacheType m_cacheIsSameProgram;
     int m_tmLastLog                    {0};
+
+    // Placement of the showings by the last reschedule, so that the
+    // next one only needs to place those that changed since.
+    class PlacedShowing
+    {
+      public:
+        QByteArray      m_signature;
+        RecStatus::Type m_recStatus    {RecStatus::Unknown};
+        uint            m_component    {0};
+    };
+    QHash<QString, PlacedShowing> m_placed;
+    std::vector<uint> m_placedSizes;
+    QDateTime   m_placedTime;
+    OpenEndType m_placedOpenEnd        {openEndNever};
+    // Number of showings placed by the last FillRecordList()
+    uint m_placedCount                 {0};
 };
 
 #endif
@@ -42,6 +42,7 @@
 #include "storagegroup.h"
 #include "playgroup.h"
 #include "backendcontext.h"
+#include "recordingchanges.h"
 
 // This will be initialised in a thread safe manner on first use
 Q_GLOBAL_STATIC_WITH_ARGS(MythHTTPMetaService, s_service,
@@ -50,6 +51,7 @@ Q_GLOBAL_STATIC_WITH_ARGS(MythHTTPMetaService, s_service,
 void V2Dvr::RegisterCustomTypes()
 {
     qRegisterMetaType<V2ProgramList*>("V2ProgramList");
+    qRegisterMetaType<V2RecordedChanges*>("V2RecordedChanges");
     qRegisterMetaType<V2Program*>("V2Program");
     qRegisterMetaType<V2CutList*>("V2CutList");
     qRegisterMetaType<V2Cutting*>("V2Cutting");
@@ -338,6 +340,52 @@ V2ProgramList* V2Dvr::GetOldRecordedList( bool             bDescending,
     return pPrograms;
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// Returns the recordings changed since Sequence of Generation, or sets
+// Reset if the client has to reload the whole list with GetRecordedList.
+/////////////////////////////////////////////////////////////////////////////
+
+V2RecordedChanges* V2Dvr::GetRecordedChanges(qlonglong Generation,
+                                             qlonglong Sequence)
+{
+    auto *pChanges = new V2RecordedChanges();
+    pChanges->setAsOf    ( MythDate::current() );
+    pChanges->setVersion ( MYTH_BINARY_VERSION );
+    pChanges->setProtoVer( MYTH_PROTO_VERSION  );
+
+    if (!gRecordingChanges)
+    {
+        pChanges->setReset(true);
+        return pChanges;
+    }
+
+    RecordingChanges::ChangeMap changes;
+    quint64 sequence = 0;
+    bool ok = (Generation > 0) && (Sequence >= 0) &&
+        gRecordingChanges->ChangesSince(Generation, Sequence,
+                                        changes, sequence);
+
+    pChanges->setGeneration(gRecordingChanges->Generation());
+    pChanges->setSequence(sequence);
+    pChanges->setReset(!ok);
+    if (!ok)
+        return pChanges;
+
+    for (auto it = changes.cbegin(); it != changes.cend(); ++it)
+    {
+        ProgramInfo pginfo;
+        if (*it == RecordingChanges::kChanged)
+            pginfo = ProgramInfo(it.key());
+
+        if (pginfo.GetChanID())
+            V2FillProgramInfo( pChanges->AddNewProgram(), &pginfo, true );
+        else
+            pChanges->AddDeleted(it.key());
+    }
+
+    return pChanges;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 //
 /////////////////////////////////////////////////////////////////////////////
@@ -28,6 +28,7 @@
 
 #include "libmythbase/http/mythhttpservice.h"
 #include "v2programList.h"
+#include "v2recordedChanges.h"
 #include "v2cutList.h"
 #include "v2markupList.h"
 #include "v2encoderList.h"
@@ -105,6 +106,9 @@ class V2Dvr : public MythHTTPService
                                             int              RecordId,
                                             const QString   &Sort);
 
+    static V2RecordedChanges* GetRecordedChanges( qlonglong  Generation,
+                                                  qlonglong  Sequence );
+
     static V2Program* GetRecorded         ( int              RecordedId,
                                             int              ChanId,
                                             const QDateTime &StartTime  );
@@ -0,0 +1,79 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: v2recordedChanges.h
+//
+// Licensed under the GPL v2 or later, see COPYING for details
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef V2RECORDEDCHANGES_H_
+#define V2RECORDEDCHANGES_H_
+
+#include <QDateTime>
+#include <QString>
+#include <QStringList>
+#include <QVariantList>
+
+#include "libmythbase/http/mythhttpservice.h"
+
+#include "v2programAndChannel.h"
+
+class V2RecordedChanges : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO( "Version", "1.0" );
+
+    Q_CLASSINFO( "Programs", "type=V2Program");
+    Q_CLASSINFO( "AsOf"    , "transient=true"   );
+
+    SERVICE_PROPERTY2( qlonglong   , Generation      )
+    SERVICE_PROPERTY2( qlonglong   , Sequence        )
+    SERVICE_PROPERTY2( bool        , Reset           )
+    SERVICE_PROPERTY2( QDateTime   , AsOf            )
+    SERVICE_PROPERTY2( QString     , Version         )
+    SERVICE_PROPERTY2( QString     , ProtoVer        )
+    SERVICE_PROPERTY2( QVariantList, Programs        )
+    SERVICE_PROPERTY2( QStringList , Deleted         )
+
+    public:
+
+        Q_INVOKABLE V2RecordedChanges(QObject *parent = nullptr)
+            : QObject( parent )
+        {
+        }
+
+        void Copy( const V2RecordedChanges *src )
+        {
+            m_Generation    = src->m_Generation     ;
+            m_Sequence      = src->m_Sequence       ;
+            m_Reset         = src->m_Reset          ;
+            m_AsOf          = src->m_AsOf           ;
+            m_Version       = src->m_Version        ;
+            m_ProtoVer      = src->m_ProtoVer       ;
+            m_Deleted       = src->m_Deleted        ;
+
+            CopyListContents< V2Program >( this, m_Programs, src->m_Programs );
+        }
+
+        V2Program *AddNewProgram()
+        {
+            // We must make sure the object added to the QVariantList has
+            // a parent of 'this'
+
+            auto *pObject = new V2Program( this );
+            m_Programs.append( QVariant::fromValue<QObject *>( pObject ));
+
+            return pObject;
+        }
+
+        void AddDeleted( uint RecordedId )
+        {
+            m_Deleted.append( QString::number( RecordedId ));
+        }
+
+    private:
+        Q_DISABLE_COPY(V2RecordedChanges);
+};
+
+Q_DECLARE_METATYPE(V2RecordedChanges*)
+
+#endif
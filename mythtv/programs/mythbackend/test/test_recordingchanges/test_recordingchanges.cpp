@@ -0,0 +1,118 @@
+/*
+ *  Class TestRecordingChanges
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include "test_recordingchanges.h"
+
+#include "mythevent.h"
+#include "recordingchanges.h"
+
+void TestRecordingChanges::changesSince_test(void)
+{
+    RecordingChanges journal(42);
+    RecordingChanges::ChangeMap changes;
+    quint64 current = 0;
+
+    QVERIFY(journal.ChangesSince(42, 0, changes, current));
+    QCOMPARE(current, 0ULL);
+    QVERIFY(changes.isEmpty());
+
+    journal.Add(1, RecordingChanges::kChanged);
+    journal.Add(2, RecordingChanges::kChanged);
+    quint64 seen = journal.Sequence();
+    journal.Add(3, RecordingChanges::kChanged);
+    journal.Add(1, RecordingChanges::kDeleted);
+    journal.Add(3, RecordingChanges::kChanged);
+    QCOMPARE(journal.Sequence(), 5ULL);
+
+    QVERIFY(journal.ChangesSince(42, 0, changes, current));
+    QCOMPARE(current, 5ULL);
+    QCOMPARE(changes.size(), 3);
+    QCOMPARE(changes.value(1), RecordingChanges::kDeleted);
+    QCOMPARE(changes.value(2), RecordingChanges::kChanged);
+    QCOMPARE(changes.value(3), RecordingChanges::kChanged);
+
+    changes.clear();
+    QVERIFY(journal.ChangesSince(42, seen, changes, current));
+    QCOMPARE(changes.size(), 2);
+    QVERIFY(changes.contains(1));
+    QVERIFY(changes.contains(3));
+
+    changes.clear();
+    QVERIFY(journal.ChangesSince(42, current, changes, current));
+    QVERIFY(changes.isEmpty());
+}
+
+void TestRecordingChanges::reload_test(void)
+{
+    RecordingChanges journal(42);
+    RecordingChanges::ChangeMap changes;
+    quint64 current = 0;
+
+    journal.Add(1, RecordingChanges::kChanged);
+    QVERIFY(!journal.ChangesSince(41, 0, changes, current));
+    QVERIFY(!journal.ChangesSince(42, 2, changes, current));
+
+    journal.Reset();
+    QVERIFY(!journal.ChangesSince(42, 1, changes, current));
+    QCOMPARE(current, 2ULL);
+    QVERIFY(journal.ChangesSince(42, current, changes, current));
+    QVERIFY(changes.isEmpty());
+
+    // Drop the oldest changes once too many recordings changed
+    quint64 before = journal.Sequence();
+    for (uint i = 1; i <= RecordingChanges::kMaxRecordings + 1; i++)
+        journal.Add(i, RecordingChanges::kChanged);
+    QVERIFY(!journal.ChangesSince(42, before, changes, current));
+    QVERIFY(journal.ChangesSince(42, before + 1, changes, current));
+    QCOMPARE(changes.size(), RecordingChanges::kMaxRecordings);
+    QVERIFY(!changes.contains(1));
+
+    // Changing the same recordings over and over drops nothing
+    before = journal.Sequence();
+    for (int i = 0; i < RecordingChanges::kMaxRecordings * 2; i++)
+        journal.Add(5, RecordingChanges::kChanged);
+    changes.clear();
+    QVERIFY(journal.ChangesSince(42, before, changes, current));
+    QCOMPARE(changes.size(), 1);
+}
+
+void TestRecordingChanges::events_test(void)
+{
+    RecordingChanges journal(42);
+    RecordingChanges::ChangeMap changes;
+    quint64 current = 0;
+
+    journal.HandleEvent(MythEvent("RECORDING_LIST_CHANGE ADD 7"));
+    journal.HandleEvent(MythEvent("RECORDING_LIST_CHANGE DELETE 8"));
+    journal.HandleEvent(MythEvent("MASTER_UPDATE_REC_INFO 9"));
+    journal.HandleEvent(MythEvent("UPDATE_FILE_SIZE 10 123456"));
+    journal.HandleEvent(MythEvent("SCHEDULE_CHANGE"));
+
+    QVERIFY(journal.ChangesSince(42, 0, changes, current));
+    QCOMPARE(current, 4ULL);
+    QCOMPARE(changes.size(), 4);
+    QCOMPARE(changes.value(7), RecordingChanges::kChanged);
+    QCOMPARE(changes.value(8), RecordingChanges::kDeleted);
+    QCOMPARE(changes.value(9), RecordingChanges::kChanged);
+    QCOMPARE(changes.value(10), RecordingChanges::kChanged);
+
+    journal.HandleEvent(MythEvent("RECORDING_LIST_CHANGE"));
+    QVERIFY(!journal.ChangesSince(42, current, changes, current));
+}
+
+QTEST_APPLESS_MAIN(TestRecordingChanges)
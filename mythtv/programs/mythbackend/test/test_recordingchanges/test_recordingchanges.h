@@ -0,0 +1,36 @@
+/*
+ *  Class TestRecordingChanges
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <QtTest/QtTest>
+
+class TestRecordingChanges : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    /** changes since a sequence number come out once per recording,
+     *  with the latest change of each
+     */
+    static void changesSince_test(void);
+    /** clients must reload after a reset, on another generation, and
+     *  once the changes they missed have been dropped
+     */
+    static void reload_test(void);
+    /** the recording list events map to the right changes */
+    static void events_test(void);
+};
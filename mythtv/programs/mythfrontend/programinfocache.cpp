@@ -45,6 +45,40 @@ class ProgramInfoLoader : public QRunnable
     bool              m_updateUI;
 };
 
+static void calculate_progress(std::vector<ProgramInfo *> &list)
+{
+    // Played progress
+    using ProgId = QPair<uint, QDateTime>;
+    QHash<ProgId, uint> lastPlayFrames;
+
+    // Get all lastplaypos marks in a single lookup
+    MSqlQuery query(MSqlQuery::InitCon());
+    query.prepare("SELECT chanid, starttime, mark "
+                  "FROM recordedmarkup "
+                  "WHERE type = :TYPE ");
+    query.bindValue(":TYPE", MARK_UTIL_LASTPLAYPOS);
+
+    if (query.exec())
+    {
+        while (query.next())
+        {
+            ProgId id = qMakePair(query.value(0).toUInt(),
+                                  MythDate::as_utc(query.value(1).toDateTime()));
+            lastPlayFrames[id] = query.value(2).toUInt();
+        }
+
+        // Determine progress of each prog
+        for (ProgramInfo* pg : list)
+        {
+            ProgId id = qMakePair(pg->GetChanID(),
+                                  pg->GetRecordingStartTime());
+            pg->CalculateProgress(lastPlayFrames.value(id));
+        }
+    }
+    else
+        MythDB::DBError("Watched progress", query);
+}
+
 ProgramInfoCache::~ProgramInfoCache()
 {
     QMutexLocker locker(&m_lock);
@@ -54,6 +88,7 @@ ProgramInfoCache::~ProgramInfoCache()
 
     Clear();
     free_vec(m_nextCache);
+    ClearChanges();
 }
 
 void ProgramInfoCache::ScheduleLoad(const bool updateUI)
@@ -72,52 +107,66 @@ void ProgramInfoCache::Load(const bool updateUI)
 {
     QMutexLocker locker(&m_lock);
     m_loadIsQueued = false;
+    quint64 generation = m_generation;
+    quint64 sequence   = m_sequence;
 
     locker.unlock();
 
-    // Get an unsorted list (sort = 0) from RemoteGetRecordedList
-    // we sort the list later anyway.
-    std::vector<ProgramInfo*> *tmp = RemoteGetRecordedList(0);
+    // Once a whole list is loaded, ask the backend only for the
+    // recordings changed since.  Otherwise, or if the backend can't tell,
+    // this fetches the position to ask from next time.
+    std::vector<ProgramInfo*> changed;
+    std::vector<uint> deleted;
+    bool incremental = (generation != 0U);
+    incremental &= RemoteGetRecordingChanges(generation, sequence,
+                                             changed, deleted);
+
+    std::vector<ProgramInfo*> *tmp = nullptr;
+    if (incremental)
+    {
+        LOG(VB_GUI, LOG_INFO,
+            QString("Loaded %1 changed and %2 deleted recordings")
+            .arg(changed.size()).arg(deleted.size()));
 
-    // Calculate play positions for UI
-    if (tmp)
+        for (ProgramInfo* pg : changed)
+            pg->CalculateProgress(pg->QueryLastPlayPos());
+    }
+    else
     {
-        // Played progress
-        using ProgId = QPair<uint, QDateTime>;
-        QHash<ProgId, uint> lastPlayFrames;
-
-        // Get all lastplaypos marks in a single lookup
-        MSqlQuery query(MSqlQuery::InitCon());
-        query.prepare("SELECT chanid, starttime, mark "
-                      "FROM recordedmarkup "
-                      "WHERE type = :TYPE ");
-        query.bindValue(":TYPE", MARK_UTIL_LASTPLAYPOS);
-
-        if (query.exec())
-        {
-            while (query.next())
-            {
-                ProgId id = qMakePair(query.value(0).toUInt(),
-                                      MythDate::as_utc(query.value(1).toDateTime()));
-                lastPlayFrames[id] = query.value(2).toUInt();
-            }
+        // Get an unsorted list (sort = 0) from RemoteGetRecordedList
+        // we sort the list later anyway.
+        tmp = RemoteGetRecordedList(0);
 
-            // Determine progress of each prog
-            for (ProgramInfo* pg : *tmp)
-            {
-                ProgId id = qMakePair(pg->GetChanID(),
-                                      pg->GetRecordingStartTime());
-                pg->CalculateProgress(lastPlayFrames.value(id));
-            }
-        }
+        // Calculate play positions for UI
+        if (tmp)
+            calculate_progress(*tmp);
         else
-            MythDB::DBError("Watched progress", query);
-     }
+            generation = 0;
+    }
 
-   locker.relock();
+    locker.relock();
 
-    free_vec(m_nextCache);
-    m_nextCache = tmp;
+    if (incremental)
+    {
+        for (ProgramInfo* pg : changed)
+        {
+            delete m_nextChanges.value(pg->GetRecordingID());
+            m_nextChanges[pg->GetRecordingID()] = pg;
+        }
+        for (uint recordingID : deleted)
+        {
+            delete m_nextChanges.value(recordingID);
+            m_nextChanges[recordingID] = nullptr;
+        }
+    }
+    else
+    {
+        free_vec(m_nextCache);
+        ClearChanges();
+        m_nextCache = tmp;
+    }
+    m_generation = generation;
+    m_sequence   = sequence;
 
     if (updateUI)
         QCoreApplication::postEvent(
@@ -142,8 +191,9 @@ void ProgramInfoCache::WaitForLoadToComplete(void) const
 
 /** \brief Refreshed the cache.
  *
- *  If a new list has been loaded this fills the cache with that list
- *  if not, this simply removes list items marked for deletion from the
+ *  If a new list has been loaded this fills the cache with that list,
+ *  then it applies the changes loaded since.  If no new list has been
+ *  loaded, this also removes list items marked for deletion from the
  *  the list.
  *
  *  \note This must only be called from the UI thread.
@@ -165,21 +215,37 @@ void ProgramInfoCache::Refresh(void)
         }
         delete m_nextCache;
         m_nextCache = nullptr;
-        return;
     }
-
-    for (auto it = m_cache.begin(); it != m_cache.end(); )
+    else
     {
-        if ((*it)->GetAvailableStatus() == asDeleted)
+        for (auto it = m_cache.begin(); it != m_cache.end(); )
         {
-            delete (*it);
-            it = m_cache.erase(it);
+            if ((*it)->GetAvailableStatus() == asDeleted)
+            {
+                delete (*it);
+                it = m_cache.erase(it);
+            }
+            else
+            {
+                it++;
+            }
         }
-        else
+    }
+
+    for (auto it = m_nextChanges.cbegin(); it != m_nextChanges.cend(); ++it)
+    {
+        Cache::iterator cit = m_cache.find(it.key());
+        if (cit != m_cache.end())
         {
-            it++;
+            delete *cit;
+            m_cache.erase(cit);
         }
+        if (*it && (*it)->GetChanID())
+            m_cache[it.key()] = *it;
+        else
+            delete *it;
     }
+    m_nextChanges.clear();
 }
 
 /** \brief Updates a ProgramInfo in the cache.
@@ -329,3 +395,12 @@ void ProgramInfoCache::Clear(void)
         delete pi;
     m_cache.clear();
 }
+
+/// Clears the changes loaded since the last Refresh(), m_lock must be
+/// held when this is called.
+void ProgramInfoCache::ClearChanges(void)
+{
+    for (const auto & pi : qAsConst(m_nextChanges))
+        delete pi;
+    m_nextChanges.clear();
+}
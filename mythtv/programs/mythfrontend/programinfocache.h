@@ -52,6 +52,7 @@ class ProgramInfoCache
   private:
     void Load(bool updateUI = true);
     void Clear(void);
+    void ClearChanges(void);
 
   private:
     // NOTE: Hash would be faster for lookups and updates, but we need a sorted
@@ -64,6 +65,11 @@ class ProgramInfoCache
     mutable QMutex          m_lock;
     Cache                   m_cache;
     std::vector<ProgramInfo*> *m_nextCache      {nullptr};
+    /// Changes loaded since the last Refresh(), nullptr for deletions
+    QHash<uint,ProgramInfo*> m_nextChanges;
+    /// Position in the backend's change journal, 0 for none
+    quint64                 m_generation        {0};
+    quint64                 m_sequence          {0};
     QObject                *m_listener          {nullptr};
     bool                    m_loadIsQueued      {false};
     uint                    m_loadsInProgress   {0};
@@ -349,6 +349,81 @@ static HostCheckBoxSetting *DisableFirewireReset()
     return hc;
 }
 
+static HostCheckBoxSetting *StreamHandlerFanout()
+{
+    auto *hc = new HostCheckBoxSetting("StreamHandlerFanout");
+    hc->setLabel(QObject::tr("Process recordings from a tuner in parallel"));
+    hc->setHelpText(
+        QObject::tr(
+            "If enabled, each recording from a shared tuner or "
+            "multiplex is processed on its own thread, so that a "
+            "slow recording does not delay the others. A recording "
+            "that falls too far behind loses data instead. This uses "
+            "more memory and is only useful on multi-core systems "
+            "recording several programs from one tuner."));
+    hc->setValue(false);
+    return hc;
+}
+
+static HostCheckBoxSetting *RecordingDirectIO()
+{
+    auto *hc = new HostCheckBoxSetting("RecordingDirectIO");
+    hc->setLabel(QObject::tr("Write recordings without caching"));
+    hc->setHelpText(
+        QObject::tr(
+            "If enabled, recordings are written with O_DIRECT so "
+            "that they do not push other data out of the page "
+            "cache. This can help when many programs are recorded "
+            "at once. It is ignored by file systems that do not "
+            "support it."));
+    hc->setValue(false);
+    return hc;
+}
+
+static GlobalCheckBoxSetting *SeekIndexFiles()
+{
+    auto *gc = new GlobalCheckBoxSetting("SeekIndexFiles");
+    gc->setLabel(QObject::tr("Store seek tables next to recordings"));
+    gc->setHelpText(
+        QObject::tr(
+            "If enabled, the keyframe positions of new recordings are "
+            "written to a compact \".seek\" file next to the "
+            "recording instead of a database row per keyframe. This "
+            "keeps the database small and lets playback start sooner. "
+            "Existing recordings keep their seek tables in the "
+            "database."));
+    gc->setValue(false);
+    return gc;
+}
+
+static HostSpinBoxSetting *HLSPrefetchSegments()
+{
+    auto *hs = new HostSpinBoxSetting("HLSPrefetchSegments", 0, 8, 1);
+    hs->setLabel(QObject::tr("HLS segments to download ahead"));
+    hs->setHelpText(
+        QObject::tr(
+            "The number of segments the HLS recorder downloads at "
+            "the same time as the one it is recording. This helps "
+            "with high bitrate streams and when catching up after "
+            "a stall. Set to 0 to download one segment at a time."));
+    hs->setValue(2);
+    return hs;
+}
+
+static GlobalSpinBoxSetting *SchedMatchThreads()
+{
+    auto *gs = new GlobalSpinBoxSetting("SchedMatchThreads", 1, 8, 1);
+    gs->setLabel(QObject::tr("Scheduler matching connections"));
+    gs->setHelpText(
+        QObject::tr(
+            "The number of database connections the scheduler uses to "
+            "match the recording rules against the program guide. More "
+            "connections make rescheduling faster when there are many "
+            "rules, but put more load on the database server."));
+    gs->setValue(1);
+    return gs;
+}
+
 static HostTextEditSetting *MiscStatusScript()
 {
     auto *he = new HostTextEditSetting("MiscStatusScript");
@@ -945,6 +1020,11 @@ BackendSettings::BackendSettings()
     group2->addChild(MiscStatusScript());
     group2->addChild(DisableAutomaticBackup());
     group2->addChild(DisableFirewireReset());
+    group2->addChild(StreamHandlerFanout());
+    group2->addChild(RecordingDirectIO());
+    group2->addChild(SeekIndexFiles());
+    group2->addChild(HLSPrefetchSegments());
+    group2->addChild(SchedMatchThreads());
     addChild(group2);
 
     auto* group2a1 = new GroupSetting();
@@ -89,6 +89,67 @@ static int ScanVideos(const MythUtilCommandLineParser &/*cmdline*/)
     return GENERIC_EXIT_CONNECT_ERROR;
 }
 
+static int RawQuerySQLStats(const QString &action)
+{
+    if (!gCoreContext->ConnectToMasterServer(false, false))
+    {
+        LOG(VB_GENERAL, LOG_ERR, "Cannot connect to master for SQL stats");
+        return GENERIC_EXIT_CONNECT_ERROR;
+    }
+
+    QStringList strlist("QUERY_SQL_STATS");
+    if (!action.isEmpty())
+        strlist << action;
+
+    if (!gCoreContext->SendReceiveStringList(strlist) ||
+        strlist.size() < 3 || strlist[0] != "OK")
+    {
+        LOG(VB_GENERAL, LOG_ERR, "Backend did not return SQL stats");
+        return GENERIC_EXIT_NOT_OK;
+    }
+
+    int count = strlist[2].toInt();
+    cout << "SQL profiling is "
+         << (strlist[1].toInt() ? "enabled" : "disabled") << endl;
+    if (count > 0)
+        cout << "     count   total ms     avg ms     max ms  statement" << endl;
+
+    for (int i = 0; i < count && 3 + (i * 4) + 3 < strlist.size(); i++)
+    {
+        int base = 3 + (i * 4);
+        qulonglong calls = strlist[base + 1].toULongLong();
+        double total = strlist[base + 2].toDouble() / 1000.0;
+        double max   = strlist[base + 3].toDouble() / 1000.0;
+        cout << QString("%1 %2 %3 %4  %5")
+                .arg(calls, 10)
+                .arg(total, 10, 'f', 1)
+                .arg(calls ? total / calls : 0.0, 10, 'f', 3)
+                .arg(max, 10, 'f', 3)
+                .arg(strlist[base]).toLocal8Bit().constData() << endl;
+    }
+
+    return GENERIC_EXIT_OK;
+}
+
+static int QuerySQLStats(const MythUtilCommandLineParser &/*cmdline*/)
+{
+    return RawQuerySQLStats(QString());
+}
+
+static int SetSQLProfile(const MythUtilCommandLineParser &cmdline)
+{
+    QString action = cmdline.toString("sqlprofile").toLower();
+    if (action == "on")
+        return RawQuerySQLStats("ENABLE");
+    if (action == "off")
+        return RawQuerySQLStats("DISABLE");
+    if (action == "reset")
+        return RawQuerySQLStats("RESET");
+
+    LOG(VB_GENERAL, LOG_ERR, "--sqlprofile takes on, off or reset");
+    return GENERIC_EXIT_INVALID_CMDLINE;
+}
+
 static int ParseVideoFilename(const MythUtilCommandLineParser &cmdline)
 {
     QString filename = cmdline.toString("parsevideo");
@@ -112,6 +173,8 @@ void registerBackendUtils(UtilMap &utilMap)
     utilMap["scanvideos"]           = &ScanVideos;
     utilMap["systemevent"]          = &SendSystemEvent;
     utilMap["parsevideo"]           = &ParseVideoFilename;
+    utilMap["sqlstats"]             = &QuerySQLStats;
+    utilMap["sqlprofile"]           = &SetSQLProfile;
 }
 
 /* vim: set expandtab tabstop=4 shiftwidth=4: */
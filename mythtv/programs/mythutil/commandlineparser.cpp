@@ -125,6 +125,22 @@ void MythUtilCommandLineParser::LoadArguments(void)
                 "Diagnostic tool for testing filename formats against what "
                 "the Video Library name parser will detect them as.")
                 ->SetGroup("Backend")
+        << add("--sqlstats", "sqlstats", false,
+                "Show how long the master backend's SQL statements took.",
+                "This command will connect to the master backend and print "
+                "the number of times each SQL statement ran, and the total, "
+                "average and longest time it took, the statements taking the "
+                "most time first. The backend only collects these while "
+                "profiling is enabled, see --sqlprofile.")
+                ->SetGroup("Backend")
+        << add("--sqlprofile", "sqlprofile", "",
+                "Turn SQL statement profiling on the master backend on, off, "
+                "or reset what it collected so far.",
+                "Takes on, off or reset. Profiling can also be enabled from "
+                "the start by running the backend with MYTHTV_SQL_PROFILE set "
+                "in its environment. The statistics are printed as with "
+                "--sqlstats.")
+                ->SetGroup("Backend")
 
         // jobutils.cpp
         << add("--queuejob", "queuejob", "",
@@ -181,6 +197,11 @@ void MythUtilCommandLineParser::LoadArguments(void)
         << add("--cleareit", "cleareit", false,
                 "Clear guide received from EIT.", "")
                 ->SetGroup("EIT Utils")
+        << add("--eitbenchmark", "eitbenchmark", false,
+                "Write a generated guide to an unused channel id once event "
+                "by event and once in batches, and report the events per "
+                "second of each.", "")
+                ->SetGroup("EIT Utils")
         );
 
     // mpegutils.cpp
@@ -278,6 +299,8 @@ void MythUtilCommandLineParser::LoadArguments(void)
     // eitutils.cpp
     add("--sourceid", "sourceid", -1, "(optional) specify sourceid of video source to operate on instead of all", "")
         ->SetChildOf("cleareit");
+    add("--eitevents", "eitevents", 2000, "(optional) number of events per benchmark pass", "")
+        ->SetChildOf("eitbenchmark");
 
     // Generic Options used by more than one utility
     addRecording();
@@ -1,7 +1,17 @@
+// C++ headers
+#include <algorithm>
+#include <iostream> // for cout
+#include <vector>
+using std::cout;
+
 // libmyth* headers
+#include "eitfixup.h"
 #include "exitcodes.h"
+#include "mythdate.h"
 #include "mythdb.h"
 #include "mythlogging.h"
+#include "mythtimer.h"
+#include "programdata.h"
 
 // local headers
 #include "eitutils.h"
@@ -134,9 +144,122 @@ static int ClearEIT(const MythUtilCommandLineParser &cmdline)
     return result;
 }
 
+// Programs of the benchmark guide, which starts in an hour so that no
+// event is in the past. The "shifted" pass moves every program by ten
+// minutes so that each one overlaps two existing programs.
+static std::vector<DBEventEIT*> benchmark_events(
+    uint chanid, int count, const QDateTime &start, const QString &pass)
+{
+    std::vector<DBEventEIT*> events;
+    int shift = (pass == "shifted") ? 10 * 60 : 0;
+    for (int i = 0; i < count; i++)
+    {
+        QDateTime starttime = start.addSecs((i * 30 * 60) + shift);
+        QString desc = (pass == "changed" || pass == "shifted")
+            ? QString("Changed description of program %1").arg(i)
+            : QString("Description of program %1").arg(i);
+        events.push_back(new DBEventEIT(
+            chanid, QString("Benchmark program %1").arg(i), desc,
+            starttime, starttime.addSecs(30 * 60), EITFixUp::kFixNone,
+            SUB_NORMAL, AUD_STEREO, VID_HDTV));
+    }
+    return events;
+}
+
+static bool clear_benchmark_channel(MSqlQuery &query, uint chanid)
+{
+    for (const auto *table : { "program", "programrating",
+                               "programgenres", "credits" })
+    {
+        query.prepare(QString("DELETE FROM %1 WHERE chanid = :CHANID")
+                      .arg(table));
+        query.bindValue(":CHANID", chanid);
+        if (!query.exec())
+        {
+            MythDB::DBError("Clear EIT benchmark channel", query);
+            return false;
+        }
+    }
+    return true;
+}
+
+static int BenchmarkEIT(const MythUtilCommandLineParser &cmdline)
+{
+    static constexpr size_t kBatchSize { 200 };
+    int count = std::max(1, cmdline.toInt("eitevents"));
+
+    MSqlQuery query(MSqlQuery::InitCon());
+    if (!query.isConnected())
+        return GENERIC_EXIT_DB_ERROR;
+
+    // Use a channel id that is neither a channel nor has any programs
+    query.prepare("SELECT GREATEST(IFNULL(MAX(c.chanid), 0), "
+                  "       IFNULL((SELECT MAX(chanid) FROM program), 0)) + 1 "
+                  "FROM channel c");
+    if (!query.exec() || !query.next())
+    {
+        MythDB::DBError("EIT benchmark channel", query);
+        return GENERIC_EXIT_DB_ERROR;
+    }
+    uint chanid = query.value(0).toUInt();
+
+    QDateTime start = MythDate::current().addSecs(60 * 60);
+    start.setTime(QTime(start.time().hour(), 0));
+
+    cout << QString("Writing %1 EIT events per pass for chanid %2\n")
+        .arg(count).arg(chanid).toLocal8Bit().constData();
+
+    int result = GENERIC_EXIT_OK;
+    for (const auto *mode : { "single", "batch" })
+    {
+        if (!clear_benchmark_channel(query, chanid))
+            return GENERIC_EXIT_DB_ERROR;
+
+        for (const auto *pass : { "new", "unchanged", "changed", "shifted" })
+        {
+            std::vector<DBEventEIT*> events =
+                benchmark_events(chanid, count, start, pass);
+
+            MythTimer timer(MythTimer::kStartRunning);
+            uint written = 0;
+            if (QString(mode) == "single")
+            {
+                for (const auto *event : events)
+                    written += event->UpdateDB(query, 1000);
+            }
+            else
+            {
+                for (size_t i = 0; i < events.size(); i += kBatchSize)
+                {
+                    std::vector<DBEventEIT*> batch(
+                        events.begin() + i,
+                        events.begin() + std::min(events.size(), i + kBatchSize));
+                    written += DBEventEIT::UpdateDB(query, batch, 1000);
+                }
+            }
+            int msecs = std::max(1, static_cast<int>(timer.elapsed().count()));
+
+            for (const auto *event : events)
+                delete event;
+
+            cout << QString("%1 %2: %3 events in %4 ms, %5 written, "
+                            "%6 events/sec\n")
+                .arg(QString(mode), 6).arg(QString(pass), -9).arg(count).arg(msecs)
+                .arg(written).arg(count * 1000LL / msecs)
+                .toLocal8Bit().constData();
+        }
+    }
+
+    if (!clear_benchmark_channel(query, chanid))
+        result = GENERIC_EXIT_DB_ERROR;
+
+    return result;
+}
+
 void registerEITUtils(UtilMap &utilMap)
 {
     utilMap["cleareit"]             = &ClearEIT;
+    utilMap["eitbenchmark"]         = &BenchmarkEIT;
 }
 
 /* vim: set expandtab tabstop=4 shiftwidth=4: */
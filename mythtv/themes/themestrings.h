@@ -1319,6 +1319,7 @@ void strings_null() {
     ThemeUI::tr("PROGRAM GUIDE");
     ThemeUI::tr("PROGRAM LIST");
     ThemeUI::tr("PROGRAM SEARCH");
+    ThemeUI::tr("Packet allocations/s :");
     ThemeUI::tr("Parental");
     ThemeUI::tr("Parental Control:");
     ThemeUI::tr("Parental Level");